@@ -0,0 +1,92 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstddef>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "sparrow/array.hpp"
+
+#include "bench_utils.hpp"
+#include "sparrow_extensions/bool8_array.hpp"
+
+namespace sparrow_extensions::bench
+{
+    namespace
+    {
+        std::vector<bool> make_bool_values(std::size_t count)
+        {
+            std::vector<bool> values(count);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                values[i] = (i % 3) != 0;
+            }
+            return values;
+        }
+
+        void bool8_array_construction(benchmark::State& state)
+        {
+            const auto values = make_bool_values(static_cast<std::size_t>(state.range(0)));
+            for (auto _ : state)
+            {
+                bool8_array arr(values);
+                benchmark::DoNotOptimize(arr);
+            }
+            state.SetItemsProcessed(state.iterations() * state.range(0));
+        }
+
+        void bool8_array_wrap_from_registry(benchmark::State& state)
+        {
+            sparrow::array source(bool8_array(make_bool_values(static_cast<std::size_t>(state.range(0)))));
+            wrap_from_arrow_structures(state, source);
+        }
+
+        void bool8_array_element_access(benchmark::State& state)
+        {
+            const bool8_array arr(make_bool_values(static_cast<std::size_t>(state.range(0))));
+            for (auto _ : state)
+            {
+                std::size_t count = 0;
+                for (std::size_t i = 0; i < arr.size(); ++i)
+                {
+                    const auto elem = arr[i];
+                    count += (elem.has_value() && static_cast<bool>(elem.value())) ? 1u : 0u;
+                }
+                benchmark::DoNotOptimize(count);
+            }
+            state.SetItemsProcessed(state.iterations() * state.range(0));
+        }
+
+        void bool8_array_iteration(benchmark::State& state)
+        {
+            const bool8_array arr(make_bool_values(static_cast<std::size_t>(state.range(0))));
+            for (auto _ : state)
+            {
+                std::size_t count = 0;
+                for (const auto& elem : arr)
+                {
+                    count += (elem.has_value() && static_cast<bool>(elem.value())) ? 1u : 0u;
+                }
+                benchmark::DoNotOptimize(count);
+            }
+            state.SetItemsProcessed(state.iterations() * state.range(0));
+        }
+    }
+
+    BENCHMARK(bool8_array_construction)->Apply(sizes);
+    BENCHMARK(bool8_array_wrap_from_registry)->Apply(sizes);
+    BENCHMARK(bool8_array_element_access)->Apply(sizes);
+    BENCHMARK(bool8_array_iteration)->Apply(sizes);
+}
@@ -0,0 +1,147 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "sparrow/array.hpp"
+#include "sparrow/primitive_array.hpp"
+
+#include "bench_utils.hpp"
+#include "sparrow_extensions/fixed_shape_tensor.hpp"
+
+namespace sparrow_extensions::bench
+{
+    namespace
+    {
+        using metadata = fixed_shape_tensor_extension::metadata;
+
+        // Every tensor is a small 3x4 matrix, the benchmark size is the number of tensors.
+        const metadata& tensor_metadata()
+        {
+            static const metadata meta{{3, 4}, std::vector<std::string>{"H", "W"}, std::nullopt};
+            return meta;
+        }
+
+        std::vector<float> make_flat_values(std::size_t tensor_count)
+        {
+            std::vector<float> values(tensor_count * static_cast<std::size_t>(tensor_metadata().compute_size()));
+            std::iota(values.begin(), values.end(), 0.0f);
+            return values;
+        }
+
+        fixed_shape_tensor_array make_tensor_array(std::size_t tensor_count)
+        {
+            const auto list_size = static_cast<std::uint64_t>(tensor_metadata().compute_size());
+            return fixed_shape_tensor_array(
+                list_size,
+                sparrow::array(sparrow::primitive_array<float>(make_flat_values(tensor_count))),
+                tensor_metadata()
+            );
+        }
+
+        void fixed_shape_tensor_construction(benchmark::State& state)
+        {
+            const auto values = make_flat_values(static_cast<std::size_t>(state.range(0)));
+            const auto list_size = static_cast<std::uint64_t>(tensor_metadata().compute_size());
+            for (auto _ : state)
+            {
+                fixed_shape_tensor_array arr(
+                    list_size,
+                    sparrow::array(sparrow::primitive_array<float>(values)),
+                    tensor_metadata()
+                );
+                benchmark::DoNotOptimize(arr);
+            }
+            state.SetItemsProcessed(state.iterations() * state.range(0));
+        }
+
+        void fixed_shape_tensor_wrap_from_registry(benchmark::State& state)
+        {
+            sparrow::array source(make_tensor_array(static_cast<std::size_t>(state.range(0))));
+            wrap_from_arrow_structures(state, source);
+        }
+
+        void fixed_shape_tensor_metadata_to_json(benchmark::State& state)
+        {
+            const metadata meta{
+                {100, 200, 500},
+                std::vector<std::string>{"C", "H", "W"},
+                std::vector<std::int64_t>{2, 0, 1}
+            };
+            for (auto _ : state)
+            {
+                benchmark::DoNotOptimize(meta.to_json());
+            }
+        }
+
+        void fixed_shape_tensor_metadata_from_json(benchmark::State& state)
+        {
+            const std::string json = R"({"shape":[100,200,500],"dim_names":["C","H","W"],"permutation":[2,0,1]})";
+            for (auto _ : state)
+            {
+                benchmark::DoNotOptimize(metadata::from_json(json));
+            }
+        }
+
+        void fixed_shape_tensor_element_access(benchmark::State& state)
+        {
+            const auto arr = make_tensor_array(static_cast<std::size_t>(state.range(0)));
+            for (auto _ : state)
+            {
+                std::size_t total_size = 0;
+                for (std::size_t i = 0; i < arr.size(); ++i)
+                {
+                    const auto elem = arr[i];
+                    if (elem.has_value())
+                    {
+                        total_size += elem.value().size();
+                    }
+                }
+                benchmark::DoNotOptimize(total_size);
+            }
+            state.SetItemsProcessed(state.iterations() * state.range(0));
+        }
+
+        void fixed_shape_tensor_iteration(benchmark::State& state)
+        {
+            const auto arr = make_tensor_array(static_cast<std::size_t>(state.range(0)));
+            for (auto _ : state)
+            {
+                std::size_t total_size = 0;
+                for (const auto& elem : arr)
+                {
+                    if (elem.has_value())
+                    {
+                        total_size += elem.value().size();
+                    }
+                }
+                benchmark::DoNotOptimize(total_size);
+            }
+            state.SetItemsProcessed(state.iterations() * state.range(0));
+        }
+    }
+
+    BENCHMARK(fixed_shape_tensor_construction)->Apply(sizes);
+    BENCHMARK(fixed_shape_tensor_wrap_from_registry)->Apply(sizes);
+    BENCHMARK(fixed_shape_tensor_metadata_to_json);
+    BENCHMARK(fixed_shape_tensor_metadata_from_json);
+    BENCHMARK(fixed_shape_tensor_element_access)->Apply(sizes);
+    BENCHMARK(fixed_shape_tensor_iteration)->Apply(sizes);
+}
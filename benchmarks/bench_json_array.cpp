@@ -0,0 +1,118 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "sparrow/array.hpp"
+
+#include "bench_utils.hpp"
+#include "sparrow_extensions/json_array.hpp"
+
+namespace sparrow_extensions::bench
+{
+    namespace
+    {
+        std::vector<std::string> make_json_values(std::size_t count)
+        {
+            std::vector<std::string> values;
+            values.reserve(count);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                values.push_back(
+                    R"({"id":)" + std::to_string(i) + R"(,"name":"user_)" + std::to_string(i)
+                    + R"(","active":)" + ((i % 2) == 0 ? "true" : "false") + "}"
+                );
+            }
+            return values;
+        }
+
+        template <class A>
+        void json_construction(benchmark::State& state)
+        {
+            const auto values = make_json_values(static_cast<std::size_t>(state.range(0)));
+            for (auto _ : state)
+            {
+                A arr(values);
+                benchmark::DoNotOptimize(arr);
+            }
+            state.SetItemsProcessed(state.iterations() * state.range(0));
+        }
+
+        template <class A>
+        void json_wrap_from_registry(benchmark::State& state)
+        {
+            sparrow::array source(A(make_json_values(static_cast<std::size_t>(state.range(0)))));
+            wrap_from_arrow_structures(state, source);
+        }
+
+        template <class A>
+        void json_element_access(benchmark::State& state)
+        {
+            const A arr(make_json_values(static_cast<std::size_t>(state.range(0))));
+            for (auto _ : state)
+            {
+                std::size_t total_length = 0;
+                for (std::size_t i = 0; i < arr.size(); ++i)
+                {
+                    const auto elem = arr[i];
+                    if (elem.has_value())
+                    {
+                        total_length += elem.value().size();
+                    }
+                }
+                benchmark::DoNotOptimize(total_length);
+            }
+            state.SetItemsProcessed(state.iterations() * state.range(0));
+        }
+
+        template <class A>
+        void json_iteration(benchmark::State& state)
+        {
+            const A arr(make_json_values(static_cast<std::size_t>(state.range(0))));
+            for (auto _ : state)
+            {
+                std::size_t total_length = 0;
+                for (const auto& elem : arr)
+                {
+                    if (elem.has_value())
+                    {
+                        total_length += elem.value().size();
+                    }
+                }
+                benchmark::DoNotOptimize(total_length);
+            }
+            state.SetItemsProcessed(state.iterations() * state.range(0));
+        }
+    }
+
+    BENCHMARK_TEMPLATE(json_construction, json_array)->Apply(sizes);
+    BENCHMARK_TEMPLATE(json_construction, big_json_array)->Apply(sizes);
+    BENCHMARK_TEMPLATE(json_construction, json_view_array)->Apply(sizes);
+
+    BENCHMARK_TEMPLATE(json_wrap_from_registry, json_array)->Apply(sizes);
+    BENCHMARK_TEMPLATE(json_wrap_from_registry, big_json_array)->Apply(sizes);
+    BENCHMARK_TEMPLATE(json_wrap_from_registry, json_view_array)->Apply(sizes);
+
+    BENCHMARK_TEMPLATE(json_element_access, json_array)->Apply(sizes);
+    BENCHMARK_TEMPLATE(json_element_access, big_json_array)->Apply(sizes);
+    BENCHMARK_TEMPLATE(json_element_access, json_view_array)->Apply(sizes);
+
+    BENCHMARK_TEMPLATE(json_iteration, json_array)->Apply(sizes);
+    BENCHMARK_TEMPLATE(json_iteration, big_json_array)->Apply(sizes);
+    BENCHMARK_TEMPLATE(json_iteration, json_view_array)->Apply(sizes);
+}
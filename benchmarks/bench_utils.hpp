@@ -0,0 +1,55 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+#include "sparrow/array.hpp"
+
+namespace sparrow_extensions::bench
+{
+    // Number of elements used for the "small" and "large" variants of every benchmark.
+    inline constexpr std::int64_t small_size = 64;
+    inline constexpr std::int64_t large_size = 1 << 16;
+
+    /**
+     * @brief Registers the small and large size arguments on a benchmark.
+     */
+    inline void sizes(benchmark::internal::Benchmark* b)
+    {
+        b->Arg(small_size)->Arg(large_size);
+    }
+
+    /**
+     * @brief Benchmarks the registry lookup performed when wrapping Arrow C structures.
+     *
+     * The source array is kept alive for the whole benchmark and wrapped through a
+     * non-owning sparrow::array, so that only the extension lookup and the construction
+     * of the extension array are measured.
+     */
+    inline void wrap_from_arrow_structures(benchmark::State& state, sparrow::array& source)
+    {
+        auto [arrow_array, arrow_schema] = sparrow::get_arrow_structures(source);
+        for (auto _ : state)
+        {
+            sparrow::array wrapped(arrow_array, arrow_schema);
+            benchmark::DoNotOptimize(wrapped.size());
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+}
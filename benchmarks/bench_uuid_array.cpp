@@ -0,0 +1,104 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "sparrow/array.hpp"
+
+#include "bench_utils.hpp"
+#include "sparrow_extensions/uuid_array.hpp"
+
+namespace sparrow_extensions::bench
+{
+    namespace
+    {
+        using uuid_bytes = std::array<sparrow::byte_t, uuid_extension::UUID_SIZE>;
+
+        std::vector<uuid_bytes> make_uuid_values(std::size_t count)
+        {
+            std::vector<uuid_bytes> values(count);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                for (std::size_t j = 0; j < uuid_extension::UUID_SIZE; ++j)
+                {
+                    values[i][j] = static_cast<sparrow::byte_t>((i * 31 + j) & 0xFF);
+                }
+            }
+            return values;
+        }
+
+        void uuid_array_construction(benchmark::State& state)
+        {
+            const auto values = make_uuid_values(static_cast<std::size_t>(state.range(0)));
+            for (auto _ : state)
+            {
+                uuid_array arr(values);
+                benchmark::DoNotOptimize(arr);
+            }
+            state.SetItemsProcessed(state.iterations() * state.range(0));
+        }
+
+        void uuid_array_wrap_from_registry(benchmark::State& state)
+        {
+            sparrow::array source(uuid_array(make_uuid_values(static_cast<std::size_t>(state.range(0)))));
+            wrap_from_arrow_structures(state, source);
+        }
+
+        void uuid_array_element_access(benchmark::State& state)
+        {
+            const uuid_array arr(make_uuid_values(static_cast<std::size_t>(state.range(0))));
+            for (auto _ : state)
+            {
+                std::size_t checksum = 0;
+                for (std::size_t i = 0; i < arr.size(); ++i)
+                {
+                    const auto elem = arr[i];
+                    if (elem.has_value())
+                    {
+                        checksum += static_cast<std::size_t>(elem.value()[0]);
+                    }
+                }
+                benchmark::DoNotOptimize(checksum);
+            }
+            state.SetItemsProcessed(state.iterations() * state.range(0));
+        }
+
+        void uuid_array_iteration(benchmark::State& state)
+        {
+            const uuid_array arr(make_uuid_values(static_cast<std::size_t>(state.range(0))));
+            for (auto _ : state)
+            {
+                std::size_t checksum = 0;
+                for (const auto& elem : arr)
+                {
+                    if (elem.has_value())
+                    {
+                        checksum += static_cast<std::size_t>(elem.value()[0]);
+                    }
+                }
+                benchmark::DoNotOptimize(checksum);
+            }
+            state.SetItemsProcessed(state.iterations() * state.range(0));
+        }
+    }
+
+    BENCHMARK(uuid_array_construction)->Apply(sizes);
+    BENCHMARK(uuid_array_wrap_from_registry)->Apply(sizes);
+    BENCHMARK(uuid_array_element_access)->Apply(sizes);
+    BENCHMARK(uuid_array_iteration)->Apply(sizes);
+}
@@ -0,0 +1,173 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "sparrow/array.hpp"
+#include "sparrow/list_array.hpp"
+#include "sparrow/primitive_array.hpp"
+
+#include "bench_utils.hpp"
+#include "sparrow_extensions/variable_shape_tensor.hpp"
+
+namespace sparrow_extensions::bench
+{
+    namespace
+    {
+        using metadata = variable_shape_tensor_extension::metadata;
+
+        constexpr std::uint64_t ndim = 2;
+
+        // Raw buffers of a batch of 2D tensors with shapes [1 + i % 4, 3].
+        struct tensor_buffers
+        {
+            std::vector<float> values;
+            std::vector<std::size_t> offsets;
+            std::vector<std::int32_t> shapes;
+        };
+
+        tensor_buffers make_tensor_buffers(std::size_t tensor_count)
+        {
+            tensor_buffers buffers;
+            buffers.offsets.reserve(tensor_count + 1);
+            buffers.shapes.reserve(tensor_count * ndim);
+            buffers.offsets.push_back(0);
+            for (std::size_t i = 0; i < tensor_count; ++i)
+            {
+                const auto rows = static_cast<std::int32_t>(1 + i % 4);
+                constexpr std::int32_t cols = 3;
+                buffers.shapes.push_back(rows);
+                buffers.shapes.push_back(cols);
+                const auto element_count = static_cast<std::size_t>(rows * cols);
+                for (std::size_t j = 0; j < element_count; ++j)
+                {
+                    buffers.values.push_back(static_cast<float>(j));
+                }
+                buffers.offsets.push_back(buffers.values.size());
+            }
+            return buffers;
+        }
+
+        const metadata& tensor_metadata()
+        {
+            static const metadata meta{
+                std::vector<std::string>{"H", "W"},
+                std::nullopt,
+                std::vector<std::optional<std::int32_t>>{std::nullopt, 3}
+            };
+            return meta;
+        }
+
+        variable_shape_tensor_array make_tensor_array(const tensor_buffers& buffers)
+        {
+            sparrow::list_array tensor_data(
+                sparrow::array(sparrow::primitive_array<float>(buffers.values)),
+                buffers.offsets
+            );
+            sparrow::fixed_sized_list_array tensor_shapes(
+                ndim,
+                sparrow::array(sparrow::primitive_array<std::int32_t>(buffers.shapes))
+            );
+            return variable_shape_tensor_array(
+                ndim,
+                sparrow::array(std::move(tensor_data)),
+                sparrow::array(std::move(tensor_shapes)),
+                tensor_metadata()
+            );
+        }
+
+        void variable_shape_tensor_construction(benchmark::State& state)
+        {
+            const auto buffers = make_tensor_buffers(static_cast<std::size_t>(state.range(0)));
+            for (auto _ : state)
+            {
+                auto arr = make_tensor_array(buffers);
+                benchmark::DoNotOptimize(arr);
+            }
+            state.SetItemsProcessed(state.iterations() * state.range(0));
+        }
+
+        void variable_shape_tensor_wrap_from_registry(benchmark::State& state)
+        {
+            sparrow::array source(make_tensor_array(make_tensor_buffers(static_cast<std::size_t>(state.range(0)))));
+            wrap_from_arrow_structures(state, source);
+        }
+
+        void variable_shape_tensor_metadata_to_json(benchmark::State& state)
+        {
+            const metadata meta{
+                std::vector<std::string>{"H", "W", "C"},
+                std::vector<std::int64_t>{2, 0, 1},
+                std::vector<std::optional<std::int32_t>>{400, std::nullopt, 3}
+            };
+            for (auto _ : state)
+            {
+                benchmark::DoNotOptimize(meta.to_json());
+            }
+        }
+
+        void variable_shape_tensor_metadata_from_json(benchmark::State& state)
+        {
+            const std::string json = R"({"dim_names":["H","W","C"],"permutation":[2,0,1],"uniform_shape":[400,null,3]})";
+            for (auto _ : state)
+            {
+                benchmark::DoNotOptimize(metadata::from_json(json));
+            }
+        }
+
+        void variable_shape_tensor_element_access(benchmark::State& state)
+        {
+            const auto arr = make_tensor_array(make_tensor_buffers(static_cast<std::size_t>(state.range(0))));
+            for (auto _ : state)
+            {
+                std::size_t valid_count = 0;
+                for (std::size_t i = 0; i < arr.size(); ++i)
+                {
+                    const auto elem = arr[i];
+                    valid_count += elem.has_value() ? elem.value().size() : 0u;
+                }
+                benchmark::DoNotOptimize(valid_count);
+            }
+            state.SetItemsProcessed(state.iterations() * state.range(0));
+        }
+
+        void variable_shape_tensor_iteration(benchmark::State& state)
+        {
+            const auto arr = make_tensor_array(make_tensor_buffers(static_cast<std::size_t>(state.range(0))));
+            for (auto _ : state)
+            {
+                std::size_t valid_count = 0;
+                for (const auto& elem : arr)
+                {
+                    valid_count += elem.has_value() ? elem.value().size() : 0u;
+                }
+                benchmark::DoNotOptimize(valid_count);
+            }
+            state.SetItemsProcessed(state.iterations() * state.range(0));
+        }
+    }
+
+    BENCHMARK(variable_shape_tensor_construction)->Apply(sizes);
+    BENCHMARK(variable_shape_tensor_wrap_from_registry)->Apply(sizes);
+    BENCHMARK(variable_shape_tensor_metadata_to_json);
+    BENCHMARK(variable_shape_tensor_metadata_from_json);
+    BENCHMARK(variable_shape_tensor_element_access)->Apply(sizes);
+    BENCHMARK(variable_shape_tensor_iteration)->Apply(sizes);
+}
@@ -88,6 +88,9 @@ find_package_or_fetch(
 
 set(SPARROW_EXTENSIONS_INTERFACE_DEPENDENCIES ${SPARROW_EXTENSIONS_INTERFACE_DEPENDENCIES} simdjson::simdjson)
 
+find_package(Threads REQUIRED)
+set(SPARROW_EXTENSIONS_INTERFACE_DEPENDENCIES ${SPARROW_EXTENSIONS_INTERFACE_DEPENDENCIES} Threads::Threads)
+
 if(SPARROW_EXTENSIONS_BUILD_TESTS)
     find_package_or_fetch(
         PACKAGE_NAME doctest
@@ -100,3 +103,15 @@ if(SPARROW_EXTENSIONS_BUILD_TESTS)
         message(STATUS "📦 better_junit_reporter target provided by sparrow")
     endif()
 endif()
+
+if(BUILD_BENCHMARKS)
+    find_package_or_fetch(
+        PACKAGE_NAME benchmark
+        GIT_REPOSITORY https://github.com/google/benchmark.git
+        TAG v1.9.4
+        CMAKE_ARGS
+            BENCHMARK_ENABLE_TESTING=OFF
+            BENCHMARK_ENABLE_GTEST_TESTS=OFF
+            BENCHMARK_ENABLE_INSTALL=OFF
+    )
+endif()
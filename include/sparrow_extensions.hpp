@@ -18,9 +18,19 @@
 #include <sparrow_extensions/config/config.hpp>
 #include <sparrow_extensions/config/sparrow_extensions_version.hpp>
 
+// Utilities
+#include <sparrow_extensions/allocation_tracker.hpp>
+#include <sparrow_extensions/memory_footprint.hpp>
+#include <sparrow_extensions/registration.hpp>
+#include <sparrow_extensions/tensor_view.hpp>
+
 // Extensions
 #include <sparrow_extensions/bool8_array.hpp>
 #include <sparrow_extensions/fixed_shape_tensor.hpp>
 #include <sparrow_extensions/json_array.hpp>
+#include <sparrow_extensions/json_kernels.hpp>
+#include <sparrow_extensions/ndjson_reader.hpp>
 #include <sparrow_extensions/uuid_array.hpp>
 #include <sparrow_extensions/variable_shape_tensor.hpp>
+#include <sparrow_extensions/variable_shape_tensor_builder.hpp>
+#include <sparrow_extensions/variable_shape_tensor_kernels.hpp>
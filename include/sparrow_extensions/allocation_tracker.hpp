@@ -0,0 +1,182 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string_view>
+#include <vector>
+
+#include "sparrow_extensions/config/config.hpp"
+
+namespace sparrow_extensions
+{
+    /**
+     * @brief Snapshot of the counters of an allocation site.
+     */
+    struct allocation_counters
+    {
+        std::string_view site;
+        std::uint64_t allocation_count = 0;
+        std::uint64_t allocated_bytes = 0;
+    };
+
+    /**
+     * @brief Named code location whose heap allocations are counted.
+     *
+     * Allocation sites are meant to be declared as function-local statics through the
+     * SPARROW_EXTENSIONS_ALLOCATION_SITE macro. They register themselves in a global
+     * intrusive list on construction, which does not allocate, and are never unregistered:
+     * a site must have static storage duration, since the list is walked by snapshot(),
+     * reset() and dump() for the lifetime of the program.
+     */
+    class SPARROW_EXTENSIONS_API allocation_site
+    {
+    public:
+
+        explicit allocation_site(std::string_view name) noexcept;
+
+        allocation_site(const allocation_site&) = delete;
+        allocation_site& operator=(const allocation_site&) = delete;
+
+        [[nodiscard]] std::string_view name() const noexcept;
+
+        /**
+         * @brief Records one allocation of the given size.
+         */
+        void record(std::size_t bytes) noexcept;
+
+        /**
+         * @brief Returns the current counters of the site.
+         */
+        [[nodiscard]] allocation_counters counters() const noexcept;
+
+        /**
+         * @brief Resets the counters of the site to zero.
+         */
+        void reset() noexcept;
+
+    private:
+
+        std::string_view m_name;
+        std::atomic<std::uint64_t> m_allocation_count{0};
+        std::atomic<std::uint64_t> m_allocated_bytes{0};
+        allocation_site* m_next = nullptr;
+
+        friend struct allocation_site_list;
+    };
+
+    /**
+     * @brief RAII object making an allocation site active on the current thread.
+     *
+     * Scopes nest: an allocation is attributed to every site active on the thread
+     * when it happens, so that the counters of an outer operation (e.g. a registry
+     * factory) include those of the inner ones (e.g. metadata parsing).
+     */
+    class SPARROW_EXTENSIONS_API allocation_scope
+    {
+    public:
+
+        explicit allocation_scope(allocation_site& site) noexcept;
+        ~allocation_scope();
+
+        allocation_scope(const allocation_scope&) = delete;
+        allocation_scope& operator=(const allocation_scope&) = delete;
+
+    private:
+
+        allocation_site& m_site;
+        allocation_scope* m_parent;
+
+        friend struct allocation_site_list;
+    };
+
+    /**
+     * @brief Runtime API to inspect the allocation counters.
+     *
+     * Allocations are only counted automatically when the library is built with the
+     * SPARROW_EXTENSIONS_ENABLE_ALLOCATION_TRACKING CMake option, which defines
+     * SPARROW_EXTENSIONS_ALLOCATION_TRACKING and makes the library replace the global
+     * operator new and operator delete. Otherwise, SPARROW_EXTENSIONS_ALLOCATION_SITE
+     * expands to nothing, so the instrumented code paths register no site; the sites
+     * declared explicitly are still registered, and only count what is passed to
+     * record_allocation().
+     *
+     * The instrumented code paths are the ones implemented in this library: metadata
+     * parsing and serialization, extension initialization, registry factories, the
+     * storage of the tensor arrays and variable_shape_tensor_builder. bool8_array,
+     * uuid_array and the JSON arrays are aliases of sparrow arrays whose constructors
+     * live in sparrow: apart from the UUID extension initialization, building them is
+     * not attributed to any site.
+     */
+    namespace allocation_tracker
+    {
+        /**
+         * @brief Returns true if the library was built with allocation tracking.
+         */
+        [[nodiscard]] SPARROW_EXTENSIONS_API bool enabled() noexcept;
+
+        /**
+         * @brief Records an allocation on every site active on the current thread.
+         *
+         * Called by the replaced operator new, it can also be called by custom
+         * allocators to attribute memory they obtain from other sources.
+         */
+        SPARROW_EXTENSIONS_API void record_allocation(std::size_t bytes) noexcept;
+
+        /**
+         * @brief Returns the counters of all the sites registered so far.
+         *
+         * Sites sharing a name, such as the instantiations of a site declared in a
+         * template, are reported once with their counters summed.
+         *
+         * @return Counters, sorted by decreasing number of allocated bytes
+         */
+        [[nodiscard]] SPARROW_EXTENSIONS_API std::vector<allocation_counters> snapshot();
+
+        /**
+         * @brief Resets the counters of all the registered sites.
+         */
+        SPARROW_EXTENSIONS_API void reset() noexcept;
+
+        /**
+         * @brief Writes one line per registered site with its counters.
+         */
+        SPARROW_EXTENSIONS_API void dump(std::ostream& os);
+    }
+}
+
+#define SPARROW_EXTENSIONS_DETAIL_CONCAT_IMPL(a, b) a##b
+#define SPARROW_EXTENSIONS_DETAIL_CONCAT(a, b) SPARROW_EXTENSIONS_DETAIL_CONCAT_IMPL(a, b)
+
+#if defined(SPARROW_EXTENSIONS_ALLOCATION_TRACKING)
+// Declares an allocation site and makes it active until the end of the enclosing scope.
+#    define SPARROW_EXTENSIONS_ALLOCATION_SITE(site_name)                                                 \
+        static ::sparrow_extensions::allocation_site SPARROW_EXTENSIONS_DETAIL_CONCAT(                    \
+            sparrow_extensions_allocation_site_,                                                          \
+            __LINE__                                                                                      \
+        ){site_name};                                                                                     \
+        const ::sparrow_extensions::allocation_scope SPARROW_EXTENSIONS_DETAIL_CONCAT(                    \
+            sparrow_extensions_allocation_scope_,                                                         \
+            __LINE__                                                                                      \
+        )                                                                                                 \
+        {                                                                                                 \
+            SPARROW_EXTENSIONS_DETAIL_CONCAT(sparrow_extensions_allocation_site_, __LINE__)               \
+        }
+#else
+#    define SPARROW_EXTENSIONS_ALLOCATION_SITE(site_name) static_cast<void>(0)
+#endif
@@ -2,15 +2,18 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include "sparrow/buffer/dynamic_bitset/dynamic_bitset.hpp"
 #include "sparrow/list_array.hpp"
 #include "sparrow/types/data_type.hpp"
 
+#include "sparrow_extensions/allocation_tracker.hpp"
 #include "sparrow_extensions/config/config.hpp"
 
 namespace sparrow_extensions
@@ -377,14 +380,57 @@ namespace sparrow_extensions
          */
         [[nodiscard]] const_reverse_iterator crend() const;
 
+        /**
+         * @brief Returns the tensors in [start, end) as an array owning a copy of the storage.
+         *
+         * The extension metadata is neither parsed again nor copied: the slice shares it
+         * with this array.
+         *
+         * @pre start <= end <= size()
+         */
+        [[nodiscard]] fixed_shape_tensor_array slice(size_type start, size_type end) const;
+
+        /**
+         * @brief Returns the tensors in [start, end) as an array sharing the buffers of this one.
+         *
+         * Only the offset and length of the storage differ from this array; neither the
+         * buffers nor the extension metadata are copied, and the extension is not
+         * initialized again, which makes slicing an array into many small pieces cheap.
+         * The slice is invalidated when this array is destroyed or modified.
+         *
+         * @pre start <= end <= size()
+         */
+        [[nodiscard]] fixed_shape_tensor_array slice_view(size_type start, size_type end) const;
+
     private:
 
+        fixed_shape_tensor_array(
+            sparrow::fixed_sized_list_array&& storage,
+            std::shared_ptr<const metadata_type> tensor_metadata
+        );
+
         void finalize_construction();
 
         sparrow::fixed_sized_list_array m_storage;
-        metadata_type m_metadata;
+        std::shared_ptr<const metadata_type> m_metadata;
     };
 
+    namespace detail
+    {
+        // Builds the fixed size list storage of a fixed_shape_tensor_array
+        template <sparrow::validity_bitmap_input VB>
+        sparrow::fixed_sized_list_array
+        make_tensor_list(std::uint64_t list_size, sparrow::array&& flat_values, VB&& validity_input)
+        {
+            SPARROW_EXTENSIONS_ALLOCATION_SITE("fixed_shape_tensor_array storage");
+            return sparrow::fixed_sized_list_array(
+                list_size,
+                std::move(flat_values),
+                std::forward<VB>(validity_input)
+            );
+        }
+    }
+
     // Template constructor implementations
 
     template <sparrow::validity_bitmap_input VB>
@@ -394,11 +440,13 @@ namespace sparrow_extensions
         const metadata_type& tensor_metadata,
         VB&& validity_input
     )
-        : m_storage(list_size, std::move(flat_values), std::forward<VB>(validity_input))
-        , m_metadata(tensor_metadata)
+        : m_storage(
+              detail::make_tensor_list(list_size, std::move(flat_values), std::forward<VB>(validity_input))
+          )
+        , m_metadata(std::make_shared<const metadata_type>(tensor_metadata))
     {
-        SPARROW_ASSERT_TRUE(m_metadata.is_valid());
-        SPARROW_ASSERT_TRUE(static_cast<std::int64_t>(list_size) == m_metadata.compute_size());
+        SPARROW_ASSERT_TRUE(m_metadata->is_valid());
+        SPARROW_ASSERT_TRUE(static_cast<std::int64_t>(list_size) == m_metadata->compute_size());
 
         finalize_construction();
     }
@@ -412,11 +460,13 @@ namespace sparrow_extensions
         std::optional<std::string_view> name,
         std::optional<METADATA_RANGE> arrow_metadata
     )
-        : m_storage(list_size, std::move(flat_values), std::forward<VB>(validity_input))
-        , m_metadata(tensor_metadata)
+        : m_storage(
+              detail::make_tensor_list(list_size, std::move(flat_values), std::forward<VB>(validity_input))
+          )
+        , m_metadata(std::make_shared<const metadata_type>(tensor_metadata))
     {
-        SPARROW_ASSERT_TRUE(m_metadata.is_valid());
-        SPARROW_ASSERT_TRUE(static_cast<std::int64_t>(list_size) == m_metadata.compute_size());
+        SPARROW_ASSERT_TRUE(m_metadata->is_valid());
+        SPARROW_ASSERT_TRUE(static_cast<std::int64_t>(list_size) == m_metadata->compute_size());
 
         // Get the proxy and set name/metadata if provided
         auto& proxy = sparrow::detail::array_access::get_arrow_proxy(m_storage);
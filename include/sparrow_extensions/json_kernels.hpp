@@ -0,0 +1,603 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "sparrow/array.hpp"
+#include "sparrow/record_batch.hpp"
+#include "sparrow/struct_array.hpp"
+
+#include "sparrow_extensions/bool8_array.hpp"
+#include "sparrow_extensions/config/config.hpp"
+#include "sparrow_extensions/json_array.hpp"
+
+namespace sparrow_extensions
+{
+    /**
+     * @brief Invalid JSON value of a JSON array, as reported by validate_json().
+     */
+    struct json_validation_error
+    {
+        /// Row of the first invalid value.
+        std::size_t row = 0;
+        /// Description of the parse error.
+        std::string reason;
+    };
+
+    /**
+     * @brief Checks that every non-null value of a JSON array is a valid JSON document.
+     *
+     * The values are parsed with simdjson directly from the data buffer of the array,
+     * without building the string references; a value is only copied when the buffer
+     * does not extend far enough past it for the SIMD parser to read ahead. The rows are
+     * split in ranges checked in parallel, each with its own parser, and the first
+     * invalid row is returned.
+     *
+     * @param json_values The array to validate
+     * @return The first invalid row and the reason, or an empty optional if all the
+     *         values are valid
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API std::optional<json_validation_error>
+    validate_json(const json_array& json_values);
+
+    /**
+     * @brief Checks that every non-null value of a JSON array is a valid JSON document.
+     *
+     * @see validate_json(const json_array&)
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API std::optional<json_validation_error>
+    validate_json(const big_json_array& json_values);
+
+    /**
+     * @brief Checks that every non-null value of a JSON array is a valid JSON document.
+     *
+     * The values are read from the view buffer, and the inline values are copied.
+     *
+     * @see validate_json(const json_array&)
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API std::optional<json_validation_error>
+    validate_json(const json_view_array& json_values);
+
+    /**
+     * @brief Checks which values of a JSON array are valid JSON documents.
+     *
+     * The values are parsed as in validate_json(), but all of them are checked.
+     *
+     * @param json_values The array to check
+     * @return One flag per row, true for the valid documents, null for the null values
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API bool8_array is_valid_json(const json_array& json_values);
+
+    /**
+     * @brief Checks which values of a JSON array are valid JSON documents.
+     *
+     * @see is_valid_json(const json_array&)
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API bool8_array is_valid_json(const big_json_array& json_values);
+
+    /**
+     * @brief Checks which values of a JSON array are valid JSON documents.
+     *
+     * @see is_valid_json(const json_array&)
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API bool8_array is_valid_json(const json_view_array& json_values);
+
+    /**
+     * @brief Type of a column extracted by extract_json_fields().
+     */
+    enum class json_field_type
+    {
+        /// Integers, as a sparrow::primitive_array<std::int64_t>.
+        int64,
+        /// Numbers, as a sparrow::primitive_array<double>.
+        float64,
+        /// Booleans, as a bool8_array.
+        boolean,
+        /// Strings, as a sparrow::string_array, or a sparrow::big_string_array when their
+        /// cumulative length exceeds 2^31-1 bytes.
+        string
+    };
+
+    /**
+     * @brief Field extracted by extract_json_fields().
+     */
+    struct json_field
+    {
+        /// JSON pointer (RFC 6901) of the field, e.g. "/user/name" or "/tags/0".
+        std::string pointer;
+        /// Type of the extracted column.
+        json_field_type type = json_field_type::string;
+    };
+
+    /**
+     * @brief Extracts typed columns from the values of a JSON array.
+     *
+     * Every value is parsed with the simdjson on-demand parser, which only reads the
+     * document as far as needed to reach the requested fields instead of building a
+     * DOM. The rows are split in blocks processed in parallel, each thread with its own
+     * parser. A row of a column is null when the value is null or not a JSON document,
+     * when the field is missing, or when it is not of the type of the column.
+     *
+     * @param json_values The JSON values
+     * @param fields The fields to extract
+     * @return One column per field, in the order of fields
+     *
+     * @throws std::runtime_error if a pointer is not a valid JSON pointer
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API std::vector<sparrow::array>
+    extract_json_fields(const json_array& json_values, std::span<const json_field> fields);
+
+    /**
+     * @brief Extracts typed columns from the values of a JSON array.
+     *
+     * @see extract_json_fields(const json_array&, std::span<const json_field>)
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API std::vector<sparrow::array>
+    extract_json_fields(const big_json_array& json_values, std::span<const json_field> fields);
+
+    /**
+     * @brief Extracts typed columns from the values of a JSON array.
+     *
+     * @see extract_json_fields(const json_array&, std::span<const json_field>)
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API std::vector<sparrow::array>
+    extract_json_fields(const json_view_array& json_values, std::span<const json_field> fields);
+
+    namespace detail
+    {
+        /**
+         * @brief Type of an entry of the tape of a json_index.
+         */
+        enum class json_tape_type : std::uint8_t
+        {
+            null,
+            boolean,
+            int64,
+            uint64,
+            float64,
+            string,
+            array,
+            object
+        };
+
+        /**
+         * @brief Value, or key of an object field, in the tape of a json_index.
+         */
+        struct json_tape_entry
+        {
+            /// Bits of a number, a boolean, the position of a string in the characters of
+            /// the block, or the position past the last entry of an array or an object.
+            std::uint64_t payload = 0;
+            /// Length of a string, or number of items of an array or fields of an object.
+            std::uint32_t count = 0;
+            json_tape_type type = json_tape_type::null;
+        };
+
+        /**
+         * @brief Parsed values of a block of rows of a json_index.
+         */
+        struct json_tape_block
+        {
+            /// Values in document order, each field of an object preceded by its key.
+            std::vector<json_tape_entry> tape;
+            /// Unescaped characters of the strings and keys.
+            std::string characters;
+            /// Position of the root entry of each row, no_document if it is not a document.
+            std::vector<std::size_t> roots;
+
+            static constexpr std::size_t no_document = static_cast<std::size_t>(-1);
+        };
+    }
+
+    class json_index;
+
+    /**
+     * @brief Extracts typed columns from the parsed values of a JSON array.
+     *
+     * The fields are looked up in the tape of the index instead of parsing the values
+     * again: the entries of the fields and items that are not on the path of a pointer
+     * are skipped without being visited. The columns are the same as the ones returned
+     * by extract_json_fields() on the indexed array.
+     *
+     * @param index The parsed values
+     * @param fields The fields to extract
+     * @return One column per field, in the order of fields
+     *
+     * @throws std::runtime_error if a pointer is not a valid JSON pointer
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API std::vector<sparrow::array>
+    extract_json_fields(const json_index& index, std::span<const json_field> fields);
+
+    /**
+     * @brief Parsed values of a JSON array, queried repeatedly without parsing them again.
+     *
+     * Every value is parsed once with the simdjson DOM parser and flattened in a compact
+     * tape, one 16-byte entry per value and per key in document order, where arrays and
+     * objects point past their last entry. The strings are unescaped in a character
+     * buffer. The rows are indexed by blocks in parallel, and the index does not refer to
+     * the array it was built from, which can be released.
+     */
+    class SPARROW_EXTENSIONS_API json_index
+    {
+    public:
+
+        /**
+         * @brief Parses the values of a JSON array.
+         *
+         * @param json_values The JSON values to index
+         */
+        explicit json_index(const json_array& json_values);
+
+        /**
+         * @brief Parses the values of a JSON array.
+         *
+         * @see json_index(const json_array&)
+         */
+        explicit json_index(const big_json_array& json_values);
+
+        /**
+         * @brief Parses the values of a JSON array.
+         *
+         * @see json_index(const json_array&)
+         */
+        explicit json_index(const json_view_array& json_values);
+
+        /**
+         * @brief Returns the number of rows.
+         */
+        [[nodiscard]] std::size_t size() const noexcept;
+
+        /**
+         * @brief Checks if a row holds a JSON document, false if it is null or invalid.
+         *
+         * @pre i < size()
+         */
+        [[nodiscard]] bool has_document(std::size_t i) const;
+
+        /**
+         * @brief Returns the number of bytes allocated by the index.
+         */
+        [[nodiscard]] std::size_t memory_size() const noexcept;
+
+    private:
+
+        std::size_t m_size = 0;
+        std::vector<detail::json_tape_block> m_blocks;
+
+        friend std::vector<sparrow::array>
+        extract_json_fields(const json_index& index, std::span<const json_field> fields);
+    };
+
+    /**
+     * @brief Scalar compared with the fields of JSON values by a json_predicate.
+     *
+     * An integer and a number are equal when they have the same numeric value.
+     */
+    using json_scalar = std::variant<std::nullptr_t, bool, std::int64_t, double, std::string>;
+
+    /**
+     * @brief Test of a json_predicate on the field at its pointer.
+     */
+    enum class json_predicate_type
+    {
+        /// The field is present, whatever its value.
+        exists,
+        /// The field is a scalar equal to the single value of the predicate.
+        equals,
+        /// The field is a number between the bounds of the predicate.
+        range,
+        /// The field is a scalar equal to one of the values of the predicate.
+        in_set,
+        /// The field is a string starting with the single string value of the predicate.
+        prefix
+    };
+
+    /**
+     * @brief Condition on a field of the JSON values, evaluated by filter_json().
+     */
+    struct json_predicate
+    {
+        /// JSON pointer (RFC 6901) of the field, e.g. "/user/name" or "/tags/0".
+        std::string pointer;
+        /// Test of the field.
+        json_predicate_type type = json_predicate_type::exists;
+        /// Value of equals and prefix, or allowed values of in_set.
+        std::vector<json_scalar> values;
+        /// Inclusive lower bound of range, unbounded if empty.
+        std::optional<double> lower;
+        /// Inclusive upper bound of range, unbounded if empty.
+        std::optional<double> upper;
+    };
+
+    /**
+     * @brief Selects the values of a JSON array that match all the predicates.
+     *
+     * Before being parsed, a row is searched for the text the predicates require, such as
+     * the quoted last key of a pointer or the quoted value of a string equality: a row that
+     * contains none of it, nor any escape sequence that could spell it differently, is
+     * rejected without being parsed. The other rows are parsed with the simdjson on-demand
+     * parser, which only reads each document up to the fields of the predicates. The rows
+     * are processed in parallel, each thread with its own parser.
+     *
+     * @param json_values The JSON values
+     * @param predicates The conditions, all of which a row must match
+     * @return One flag per row, true for the matching documents, null for the null values
+     *
+     * @throws std::runtime_error if a pointer is not a valid JSON pointer, or if equals or
+     *         prefix do not have a single value, or prefix a string value
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API bool8_array
+    filter_json(const json_array& json_values, std::span<const json_predicate> predicates);
+
+    /**
+     * @brief Selects the values of a JSON array that match all the predicates.
+     *
+     * @see filter_json(const json_array&, std::span<const json_predicate>)
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API bool8_array
+    filter_json(const big_json_array& json_values, std::span<const json_predicate> predicates);
+
+    /**
+     * @brief Selects the values of a JSON array that match all the predicates.
+     *
+     * @see filter_json(const json_array&, std::span<const json_predicate>)
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API bool8_array
+    filter_json(const json_view_array& json_values, std::span<const json_predicate> predicates);
+
+    /**
+     * @brief Type of a field of a json_schema, and of the column it is shredded into.
+     */
+    enum class json_schema_type
+    {
+        /// Only null values, as a sparrow::null_array.
+        null,
+        /// Booleans, as a bool8_array.
+        boolean,
+        /// Integers, as a sparrow::primitive_array<std::int64_t>.
+        int64,
+        /// Numbers, as a sparrow::primitive_array<double>.
+        float64,
+        /// Strings, as a sparrow::string_array, or a sparrow::big_string_array when their
+        /// cumulative length exceeds 2^31-1 bytes.
+        string,
+        /// Values of different types, as a json_array of their JSON text, or a
+        /// big_json_array when their cumulative length exceeds 2^31-1 bytes.
+        json,
+        /// Arrays, as a sparrow::list_array, or a sparrow::big_list_array when they
+        /// have more than 2^31-1 items in total.
+        list,
+        /// Objects, as a sparrow::struct_array.
+        object
+    };
+
+    /**
+     * @brief Field of a json_schema.
+     */
+    struct json_schema_field
+    {
+        /// Name of the field, "item" for the items of a list.
+        std::string name;
+        /// Type of the values of the field.
+        json_schema_type type = json_schema_type::null;
+        /// Whether the field is null or missing in some of the values.
+        bool nullable = false;
+        /// Fields of an object, or the single field of the items of a list.
+        std::vector<json_schema_field> children;
+
+        bool operator==(const json_schema_field&) const = default;
+    };
+
+    /**
+     * @brief Schema of the JSON objects of a JSON array, as inferred by infer_json_schema().
+     */
+    struct json_schema
+    {
+        /// Fields of the objects, in their order of first appearance.
+        std::vector<json_schema_field> fields;
+
+        bool operator==(const json_schema&) const = default;
+    };
+
+    /**
+     * @brief Options of infer_json_schema().
+     */
+    struct json_schema_inference_options
+    {
+        /// Number of rows sampled from the start of the array, 0 to scan all of them.
+        std::size_t sample_size = 0;
+    };
+
+    /**
+     * @brief Infers the schema of the JSON objects of a JSON array.
+     *
+     * Every value is parsed with the simdjson DOM parser and its schema is merged with
+     * the schema of the previous values: a field that is missing from some objects, or
+     * null in some of them, is nullable; integers and floating point numbers are merged
+     * into float64, and the other conflicting types into json. Unsigned integers that
+     * do not fit in int64 are inferred as float64. The null values, the invalid documents
+     * and the documents that are not objects are ignored. The rows are split in blocks
+     * inferred in parallel, whose schemas are merged in row order.
+     *
+     * @param json_values The JSON values
+     * @param options The inference options
+     * @return The fields of the objects, in their order of first appearance
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API json_schema
+    infer_json_schema(const json_array& json_values, const json_schema_inference_options& options = {});
+
+    /**
+     * @brief Infers the schema of the JSON objects of a JSON array.
+     *
+     * @see infer_json_schema(const json_array&, const json_schema_inference_options&)
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API json_schema
+    infer_json_schema(const big_json_array& json_values, const json_schema_inference_options& options = {});
+
+    /**
+     * @brief Infers the schema of the JSON objects of a JSON array.
+     *
+     * @see infer_json_schema(const json_array&, const json_schema_inference_options&)
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API json_schema
+    infer_json_schema(const json_view_array& json_values, const json_schema_inference_options& options = {});
+
+    /**
+     * @brief Shreds the JSON objects of a JSON array into typed columns.
+     *
+     * Every value is parsed once with the simdjson DOM parser and its fields are appended
+     * to the columns of the schema, recursively for the nested objects and lists. The
+     * rows are split in blocks shredded in parallel into buffers of their own, which are
+     * concatenated in row order. A row of the result is null when the value is null, not
+     * a JSON document or not an object; a row of a column is null when the field is null,
+     * missing or not of the type of the column. The fields that are not in the schema
+     * are ignored.
+     *
+     * @param json_values The JSON values
+     * @param schema The schema of the columns, e.g. as returned by infer_json_schema()
+     * @return A struct array with one child per field of the schema
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API sparrow::struct_array
+    shred_json(const json_array& json_values, const json_schema& schema);
+
+    /**
+     * @brief Shreds the JSON objects of a JSON array into typed columns.
+     *
+     * @see shred_json(const json_array&, const json_schema&)
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API sparrow::struct_array
+    shred_json(const big_json_array& json_values, const json_schema& schema);
+
+    /**
+     * @brief Shreds the JSON objects of a JSON array into typed columns.
+     *
+     * @see shred_json(const json_array&, const json_schema&)
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API sparrow::struct_array
+    shred_json(const json_view_array& json_values, const json_schema& schema);
+
+    /**
+     * @brief Serialises each row of a struct array into a JSON object.
+     *
+     * The children of the struct array become the fields of the objects, named after
+     * them. Null values are written as null, numbers in their shortest round-trip
+     * representation (null for the non-finite ones), lists and fixed-size lists as JSON
+     * arrays and structs as nested objects. The values of a json_array child are written
+     * as they are, those of a bool8_array as booleans and those of a uuid_array as
+     * strings. The size of every row is computed in a first pass, then the rows are
+     * written in place in the data buffer of the result; both passes run in parallel.
+     *
+     * @param records The struct array to serialise
+     * @return One JSON object per row, null for the null rows
+     *
+     * @throws std::runtime_error if a child has a type that cannot be serialised, or if
+     *         the serialised rows exceed 2^31-1 bytes
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API json_array serialize_json(const sparrow::struct_array& records);
+
+    /**
+     * @brief Serialises each row of a record batch into a JSON object.
+     *
+     * The columns of the batch become the fields of the objects, named after them.
+     *
+     * @see serialize_json(const sparrow::struct_array&)
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API json_array serialize_json(const sparrow::record_batch& batch);
+
+    /**
+     * @brief Serialises each row of a struct array into a JSON object, with 64-bit offsets.
+     *
+     * @see serialize_json(const sparrow::struct_array&)
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API big_json_array
+    serialize_big_json(const sparrow::struct_array& records);
+
+    /**
+     * @brief Serialises each row of a record batch into a JSON object, with 64-bit offsets.
+     *
+     * @see serialize_json(const sparrow::record_batch&)
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API big_json_array
+    serialize_big_json(const sparrow::record_batch& batch);
+
+    /**
+     * @brief Removes the whitespace outside of the strings of the values of a JSON array.
+     *
+     * The values are minified with simdjson, which does not validate them. The rows are
+     * rewritten by blocks in parallel, each in a buffer of its own, and the blocks are then
+     * copied in parallel into the new array, at offsets given by their sizes.
+     *
+     * @param json_values The JSON values
+     * @return The minified values, null for the null values
+     *
+     * @throws std::runtime_error if a value has an unterminated string
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API json_array minify_json(const json_array& json_values);
+
+    /**
+     * @brief Removes the whitespace outside of the strings of the values of a JSON array.
+     *
+     * @see minify_json(const json_array&)
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API big_json_array minify_json(const big_json_array& json_values);
+
+    /**
+     * @brief Removes the whitespace outside of the strings of the values of a JSON array.
+     *
+     * @see minify_json(const json_array&)
+     *
+     * @throws std::runtime_error if the minified values exceed 2^31-1 bytes
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API json_array minify_json(const json_view_array& json_values);
+
+    /**
+     * @brief Rewrites the values of a JSON array in a canonical form.
+     *
+     * Every value is parsed with the simdjson DOM parser and written without whitespace,
+     * with the fields of the objects sorted by the bytes of their keys, the strings
+     * unescaped then escaped again with the minimal escape sequences, and the numbers in
+     * their shortest round-trip form, so that equal documents have the same text and can
+     * be hashed or deduplicated. Integers keep all their digits, and the other numbers are
+     * written as doubles. The rows are rewritten as in minify_json().
+     *
+     * @param json_values The JSON values
+     * @return The canonical values, null for the null values
+     *
+     * @throws std::runtime_error if a value is not a valid JSON document, or if the result
+     *         of a json_array exceeds 2^31-1 bytes
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API json_array canonicalize_json(const json_array& json_values);
+
+    /**
+     * @brief Rewrites the values of a JSON array in a canonical form.
+     *
+     * @see canonicalize_json(const json_array&)
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API big_json_array canonicalize_json(const big_json_array& json_values);
+
+    /**
+     * @brief Rewrites the values of a JSON array in a canonical form.
+     *
+     * @see canonicalize_json(const json_array&)
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API json_array canonicalize_json(const json_view_array& json_values);
+}
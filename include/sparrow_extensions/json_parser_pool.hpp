@@ -0,0 +1,164 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <simdjson.h>
+
+#include "sparrow_extensions/config/config.hpp"
+
+namespace sparrow_extensions::detail
+{
+    /**
+     * @brief Pool of reusable simdjson parsers of type P.
+     *
+     * A simdjson parser cannot be used by several threads at once, and it allocates
+     * buffers sized to the largest document it has parsed, which it keeps for the next
+     * ones. The pool lends a parser to each caller until the returned lease is destroyed,
+     * so that the parsers and their buffers are reused across calls and threads instead of
+     * being allocated every time. At most max_idle_count() idle parsers are kept, the
+     * parsers given back past this count are freed.
+     *
+     * @tparam P simdjson::dom::parser or simdjson::ondemand::parser
+     */
+    template <class P>
+    class json_parser_pool
+    {
+    public:
+
+        /**
+         * @brief Parser lent by a pool, given back on destruction.
+         */
+        class lease
+        {
+        public:
+
+            lease(json_parser_pool& pool, std::unique_ptr<P> parser)
+                : m_pool(&pool)
+                , m_parser(std::move(parser))
+            {
+            }
+
+            ~lease()
+            {
+                if (m_parser != nullptr)
+                {
+                    m_pool->release(std::move(m_parser));
+                }
+            }
+
+            lease(lease&&) noexcept = default;
+            lease(const lease&) = delete;
+            lease& operator=(const lease&) = delete;
+            lease& operator=(lease&&) = delete;
+
+            [[nodiscard]] P& operator*() const
+            {
+                return *m_parser;
+            }
+
+            [[nodiscard]] P* operator->() const
+            {
+                return m_parser.get();
+            }
+
+        private:
+
+            json_parser_pool* m_pool;
+            std::unique_ptr<P> m_parser;
+        };
+
+        /**
+         * @brief Creates an empty pool.
+         *
+         * @param max_idle_count Maximum number of idle parsers kept by the pool
+         */
+        explicit json_parser_pool(std::size_t max_idle_count)
+            : m_max_idle_count(max_idle_count)
+        {
+        }
+
+        json_parser_pool(const json_parser_pool&) = delete;
+        json_parser_pool& operator=(const json_parser_pool&) = delete;
+
+        /**
+         * @brief Lends an idle parser, or a new one if none is idle.
+         */
+        [[nodiscard]] lease acquire()
+        {
+            {
+                const std::lock_guard<std::mutex> lock(m_mutex);
+                if (!m_idle.empty())
+                {
+                    auto parser = std::move(m_idle.back());
+                    m_idle.pop_back();
+                    return lease(*this, std::move(parser));
+                }
+            }
+            return lease(*this, std::make_unique<P>());
+        }
+
+        /**
+         * @brief Returns the number of idle parsers.
+         */
+        [[nodiscard]] std::size_t idle_count() const
+        {
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            return m_idle.size();
+        }
+
+        /**
+         * @brief Returns the maximum number of idle parsers kept by the pool.
+         */
+        [[nodiscard]] std::size_t max_idle_count() const noexcept
+        {
+            return m_max_idle_count;
+        }
+
+    private:
+
+        void release(std::unique_ptr<P> parser)
+        {
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_idle.size() < m_max_idle_count)
+            {
+                m_idle.push_back(std::move(parser));
+            }
+        }
+
+        std::size_t m_max_idle_count;
+        mutable std::mutex m_mutex;
+        std::vector<std::unique_ptr<P>> m_idle;
+    };
+
+    /**
+     * @brief Returns the pool of DOM parsers of the library, which keeps one idle parser
+     * per hardware thread.
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API json_parser_pool<simdjson::dom::parser>&
+    dom_parser_pool();
+
+    /**
+     * @brief Returns the pool of on-demand parsers of the library, which keeps one idle
+     * parser per hardware thread.
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API json_parser_pool<simdjson::ondemand::parser>&
+    ondemand_parser_pool();
+}
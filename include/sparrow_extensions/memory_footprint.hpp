@@ -0,0 +1,120 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "sparrow/arrow_interface/arrow_array_schema_proxy.hpp"
+#include "sparrow/layout/array_access.hpp"
+
+#include "sparrow_extensions/config/config.hpp"
+
+namespace sparrow_extensions
+{
+    /**
+     * @brief Memory usage of a single Arrow buffer.
+     */
+    struct buffer_footprint
+    {
+        /// Role of the buffer in the layout ("validity", "offsets", "values", "views", ...).
+        std::string_view name;
+        /// Address of the buffer, can be used to detect buffers shared between arrays.
+        const void* data = nullptr;
+        /// Number of bytes of the buffer as described by the Arrow layout.
+        std::size_t size = 0;
+        /// Number of bytes reserved for the buffer; equal to size when unknown.
+        std::size_t capacity = 0;
+        /// True if the buffer was allocated by sparrow and is owned by the array, false
+        /// if it belongs to another producer or array, or is referenced from several places.
+        bool owned = false;
+    };
+
+    /**
+     * @brief Memory usage of an Arrow array and of its children.
+     *
+     * The footprint reports the buffers of the whole underlying storage: a sliced
+     * array reports the buffers it references, not only the bytes of its range. The
+     * dictionary of a dictionary-encoded array is reported apart from the children,
+     * and is counted in every total like a child.
+     */
+    struct SPARROW_EXTENSIONS_API memory_footprint
+    {
+        /// Name of the array as stored in its schema, empty if none.
+        std::string name;
+        std::vector<buffer_footprint> buffers;
+        std::vector<memory_footprint> children;
+        /// Footprint of the dictionary of a dictionary-encoded array, empty otherwise.
+        std::vector<memory_footprint> dictionary;
+
+        /**
+         * @brief Returns the number of bytes of all the buffers, children included.
+         */
+        [[nodiscard]] std::size_t total_bytes() const;
+
+        /**
+         * @brief Returns the number of bytes of the owned buffers, children included.
+         */
+        [[nodiscard]] std::size_t owned_bytes() const;
+
+        /**
+         * @brief Returns the number of bytes of the buffers referenced but not owned,
+         * children included.
+         */
+        [[nodiscard]] std::size_t shared_bytes() const;
+
+        /**
+         * @brief Returns the number of bytes reserved but not used by the buffers,
+         * children included.
+         */
+        [[nodiscard]] std::size_t slack_bytes() const;
+    };
+
+    /**
+     * @brief Computes the memory footprint of the array held by an arrow proxy.
+     *
+     * Buffer names follow the Arrow columnar format and depend on the data type of
+     * each array. Capacities are only known for buffers allocated by sparrow.
+     *
+     * Buffers are attributed by identity: a buffer is owned if the proxy owns its array
+     * (directly or through its parent), the array was released by sparrow, the buffer is
+     * the one stored by that array, and no other buffer of the tree has the same address.
+     * Views and imported arrays therefore only report shared buffers.
+     *
+     * @param proxy The arrow proxy to inspect
+     * @return The memory footprint of the array and its children
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API memory_footprint
+    get_memory_footprint(const sparrow::arrow_proxy& proxy);
+
+    /**
+     * @brief Computes the memory footprint of an extension array.
+     *
+     * Works with every array of this library (fixed_shape_tensor_array,
+     * variable_shape_tensor_array, uuid_array, bool8_array, json_array,
+     * big_json_array and json_view_array) and with sparrow arrays.
+     *
+     * @tparam A The array type
+     * @param arr The array to inspect
+     * @return The memory footprint of the array and its children
+     */
+    template <class A>
+    [[nodiscard]] memory_footprint get_memory_footprint(const A& arr)
+    {
+        return get_memory_footprint(sparrow::detail::array_access::get_arrow_proxy(arr));
+    }
+}
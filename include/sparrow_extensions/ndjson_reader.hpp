@@ -0,0 +1,63 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <filesystem>
+#include <variant>
+
+#include "sparrow_extensions/config/config.hpp"
+#include "sparrow_extensions/json_array.hpp"
+
+namespace sparrow_extensions
+{
+    /**
+     * @brief Options of read_ndjson().
+     */
+    struct ndjson_read_options
+    {
+        /// Whether to check that every line is a valid JSON document.
+        bool validate = false;
+        /// Whether to copy the lines without their line terminator instead of referring
+        /// to the file mapping.
+        bool trim_line_endings = false;
+    };
+
+    /**
+     * @brief JSON array read by read_ndjson(), with 64-bit offsets when the data exceeds
+     * 2^31-1 bytes.
+     */
+    using ndjson_array = std::variant<json_array, big_json_array>;
+
+    /**
+     * @brief Reads a newline-delimited JSON file into a JSON array, one value per line.
+     *
+     * The file is memory-mapped and the line boundaries are found by scanning chunks of
+     * the mapping in parallel. By default the data buffer of the result is the mapping
+     * itself, which stays mapped until the array is released: the offsets point to the
+     * first character of each line, so that every value keeps its line terminator and the
+     * blank lines that follow it, which are JSON whitespace. With trim_line_endings, the
+     * lines are copied without them. Blank lines do not produce values. The result is a
+     * big_json_array when the data buffer exceeds 2^31-1 bytes, a json_array otherwise.
+     *
+     * @param path Path of the file
+     * @param options Read options
+     * @return The JSON values of the lines
+     *
+     * @throws std::runtime_error if the file cannot be mapped, or with validate if a line
+     *         is not a valid JSON document
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API ndjson_array
+    read_ndjson(const std::filesystem::path& path, const ndjson_read_options& options = {});
+}
@@ -0,0 +1,42 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+#include "sparrow_extensions/config/config.hpp"
+
+namespace sparrow_extensions::detail
+{
+    /**
+     * @brief Splits [0, count) into contiguous chunks and processes them concurrently.
+     *
+     * The range is split into at most one chunk per hardware thread, each chunk holding
+     * at least grain_size items. The calling thread processes the first chunk; when the
+     * range is smaller than two grains, or when threads are not available, the whole
+     * range is processed on the calling thread. If a chunk throws, the first exception
+     * is rethrown once all the chunks are done.
+     *
+     * @param count Number of items to process
+     * @param grain_size Minimum number of items per chunk
+     * @param body Callable invoked as body(begin, end) on each chunk
+     */
+    SPARROW_EXTENSIONS_API void parallel_for(
+        std::size_t count,
+        std::size_t grain_size,
+        const std::function<void(std::size_t, std::size_t)>& body
+    );
+}
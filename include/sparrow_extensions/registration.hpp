@@ -0,0 +1,79 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+
+#include "sparrow_extensions/config/config.hpp"
+
+namespace sparrow_extensions
+{
+    /**
+     * @brief Bitmask selecting extension types to register in the sparrow array registry.
+     */
+    enum class extension_kind : std::uint32_t
+    {
+        none = 0,
+        bool8 = 1u << 0,
+        uuid = 1u << 1,
+        json = 1u << 2,  ///< json_array, big_json_array and json_view_array
+        fixed_shape_tensor = 1u << 3,
+        variable_shape_tensor = 1u << 4,
+        all = bool8 | uuid | json | fixed_shape_tensor | variable_shape_tensor
+    };
+
+    [[nodiscard]] constexpr extension_kind operator|(extension_kind lhs, extension_kind rhs) noexcept
+    {
+        return static_cast<extension_kind>(static_cast<std::uint32_t>(lhs) | static_cast<std::uint32_t>(rhs));
+    }
+
+    [[nodiscard]] constexpr extension_kind operator&(extension_kind lhs, extension_kind rhs) noexcept
+    {
+        return static_cast<extension_kind>(static_cast<std::uint32_t>(lhs) & static_cast<std::uint32_t>(rhs));
+    }
+
+    /**
+     * @brief Registers the factories of the selected extension types in the sparrow
+     * array registry.
+     *
+     * By default, every extension type registers itself when the library is loaded.
+     * When the library is built with SPARROW_EXTENSIONS_AUTO_REGISTRATION=OFF, nothing
+     * is registered at load time and this function (or one of the per-type functions
+     * below) must be called before wrapping extension arrays through sparrow::array.
+     *
+     * Registration is idempotent and thread-safe: each type is registered at most once.
+     *
+     * The mask is only read at run time, so this function references every extension
+     * type and a static binary calling it links all of them in, whatever the mask.
+     * Static builds that need only some types should call the per-type functions below.
+     *
+     * @param kinds Bitmask of the extension types to register
+     */
+    SPARROW_EXTENSIONS_API void register_extensions(extension_kind kinds = extension_kind::all);
+
+    /**
+     * @name Per-type registration
+     *
+     * Register a single extension type. In static builds without auto-registration,
+     * calling only these functions keeps the unused extension types out of the binary.
+     */
+    ///@{
+    SPARROW_EXTENSIONS_API void register_bool8_extension();
+    SPARROW_EXTENSIONS_API void register_uuid_extension();
+    SPARROW_EXTENSIONS_API void register_json_extension();
+    SPARROW_EXTENSIONS_API void register_fixed_shape_tensor_extension();
+    SPARROW_EXTENSIONS_API void register_variable_shape_tensor_extension();
+    ///@}
+}
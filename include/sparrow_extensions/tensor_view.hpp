@@ -0,0 +1,236 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "sparrow/utils/contracts.hpp"
+
+namespace sparrow_extensions
+{
+    /**
+     * @brief Read-only, non-owning view of a row-major tensor with a dynamic rank.
+     *
+     * This is a minimal C++20 counterpart of std::mdspan<const T, std::dextents<...>>
+     * with a layout_right mapping: the extents are read from a contiguous int32 shape
+     * (as stored in the Arrow tensor extensions) and the elements are addressed with
+     * a multidimensional index. The view does not own the elements nor the shape, it
+     * is invalidated when the array it was obtained from is destroyed or modified.
+     *
+     * @tparam T The element type
+     */
+    template <class T>
+    class tensor_view
+    {
+    public:
+
+        using element_type = const T;
+        using value_type = T;
+        using size_type = std::size_t;
+        using index_type = std::int64_t;
+        using rank_type = std::size_t;
+
+        constexpr tensor_view() noexcept = default;
+
+        /**
+         * @brief Constructs a view over elements laid out in row-major order.
+         *
+         * @param data Pointer to the first element of the tensor
+         * @param shape Extents of the tensor, one per dimension
+         *
+         * @pre data must point to at least the product of shape elements
+         */
+        constexpr tensor_view(const T* data, std::span<const std::int32_t> shape) noexcept
+            : m_data(data)
+            , m_shape(shape)
+        {
+        }
+
+        /**
+         * @brief Constructs a view over elements laid out in row-major order, with the
+         * strides known in advance for some dimensions.
+         *
+         * @param data Pointer to the first element of the tensor
+         * @param shape Extents of the tensor, one per dimension
+         * @param constant_strides Stride of each dimension, or 0 where it must be computed
+         *                         from the extents
+         *
+         * @pre data must point to at least the product of shape elements
+         * @pre constant_strides.size() == shape.size()
+         * @pre each non-zero stride is the product of the following extents
+         */
+        constexpr tensor_view(
+            const T* data,
+            std::span<const std::int32_t> shape,
+            std::span<const index_type> constant_strides
+        )
+            : m_data(data)
+            , m_shape(shape)
+            , m_constant_strides(constant_strides)
+        {
+            SPARROW_ASSERT_TRUE(constant_strides.size() == shape.size());
+        }
+
+        /**
+         * @brief Returns the number of dimensions.
+         */
+        [[nodiscard]] constexpr rank_type rank() const noexcept
+        {
+            return m_shape.size();
+        }
+
+        /**
+         * @brief Returns the extent of dimension r.
+         *
+         * @pre r < rank()
+         */
+        [[nodiscard]] constexpr index_type extent(rank_type r) const
+        {
+            SPARROW_ASSERT_TRUE(r < rank());
+            return m_shape[r];
+        }
+
+        /**
+         * @brief Returns the stride, in elements, of dimension r.
+         *
+         * @pre r < rank()
+         */
+        [[nodiscard]] constexpr index_type stride(rank_type r) const
+        {
+            SPARROW_ASSERT_TRUE(r < rank());
+            if (!m_constant_strides.empty() && m_constant_strides[r] != 0)
+            {
+                return m_constant_strides[r];
+            }
+            index_type result = 1;
+            for (rank_type d = r + 1; d < rank(); ++d)
+            {
+                result *= m_shape[d];
+            }
+            return result;
+        }
+
+        /**
+         * @brief Returns the extents of the tensor.
+         */
+        [[nodiscard]] constexpr std::span<const std::int32_t> shape() const noexcept
+        {
+            return m_shape;
+        }
+
+        /**
+         * @brief Returns the number of elements of the tensor.
+         */
+        [[nodiscard]] constexpr size_type size() const noexcept
+        {
+            size_type result = 1;
+            for (const auto dim : m_shape)
+            {
+                result *= static_cast<size_type>(dim);
+            }
+            return result;
+        }
+
+        /**
+         * @brief Checks if the tensor has no element.
+         */
+        [[nodiscard]] constexpr bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+
+        /**
+         * @brief Returns a pointer to the first element.
+         */
+        [[nodiscard]] constexpr const T* data_handle() const noexcept
+        {
+            return m_data;
+        }
+
+        /**
+         * @brief Returns the elements as a flat row-major span.
+         */
+        [[nodiscard]] constexpr std::span<const T> flat() const noexcept
+        {
+            return {m_data, size()};
+        }
+
+        /**
+         * @brief Accesses the element at the given multidimensional index.
+         *
+         * @param indices One index per dimension
+         * @return Reference to the element
+         *
+         * @pre sizeof...(indices) == rank()
+         * @pre each index is in [0, extent(r))
+         */
+        template <std::integral... I>
+        [[nodiscard]] constexpr const T& operator()(I... indices) const
+        {
+            SPARROW_ASSERT_TRUE(sizeof...(I) == rank());
+            const std::array<index_type, sizeof...(I)> index_array = {static_cast<index_type>(indices)...};
+            return m_data[offset_of(index_array)];
+        }
+
+        /**
+         * @brief Accesses the element at the given multidimensional index.
+         *
+         * @param indices One index per dimension
+         * @return Reference to the element
+         *
+         * @pre indices.size() == rank()
+         * @pre each index is in [0, extent(r))
+         */
+        [[nodiscard]] constexpr const T& operator[](std::span<const index_type> indices) const
+        {
+            SPARROW_ASSERT_TRUE(indices.size() == rank());
+            return m_data[offset_of(indices)];
+        }
+
+    private:
+
+        [[nodiscard]] constexpr index_type checked_index(rank_type r, index_type index) const
+        {
+            SPARROW_ASSERT_TRUE(index >= 0 && index < m_shape[r]);
+            return index;
+        }
+
+        // Sum of index * stride over the axes, walked backwards so that the stride of each
+        // axis is its constant stride when known and the running product of the extents otherwise
+        [[nodiscard]] constexpr index_type offset_of(std::span<const index_type> indices) const
+        {
+            index_type offset = 0;
+            index_type axis_stride = 1;
+            for (rank_type r = rank(); r-- > 0;)
+            {
+                if (!m_constant_strides.empty() && m_constant_strides[r] != 0)
+                {
+                    axis_stride = m_constant_strides[r];
+                }
+                offset += checked_index(r, indices[r]) * axis_stride;
+                axis_stride *= m_shape[r];
+            }
+            return offset;
+        }
+
+        const T* m_data = nullptr;
+        std::span<const std::int32_t> m_shape;
+        std::span<const index_type> m_constant_strides;
+    };
+}
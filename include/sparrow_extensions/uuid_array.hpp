@@ -20,6 +20,8 @@
 #include "sparrow/fixed_width_binary_array.hpp"
 #include "sparrow/utils/contracts.hpp"
 
+#include "sparrow_extensions/allocation_tracker.hpp"
+
 namespace sparrow_extensions
 {
     /**
@@ -49,6 +51,7 @@ namespace sparrow_extensions
 
         static void init(sparrow::arrow_proxy& proxy)
         {
+            SPARROW_EXTENSIONS_ALLOCATION_SITE("uuid_extension::init");
             const size_t element_size = sparrow::num_bytes_for_fixed_sized_binary(proxy.format());
             SPARROW_ASSERT_TRUE(element_size == UUID_SIZE);
             // Add UUID extension metadata
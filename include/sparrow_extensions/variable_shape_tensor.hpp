@@ -16,16 +16,23 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include "sparrow/buffer/dynamic_bitset/dynamic_bitset.hpp"
 #include "sparrow/struct_array.hpp"
+#include "sparrow/types/data_traits.hpp"
 #include "sparrow/types/data_type.hpp"
+#include "sparrow/utils/contracts.hpp"
 
+#include "sparrow_extensions/allocation_tracker.hpp"
 #include "sparrow_extensions/config/config.hpp"
+#include "sparrow_extensions/tensor_view.hpp"
 
 namespace sparrow_extensions
 {
@@ -40,7 +47,7 @@ namespace sparrow_extensions
      * The variable shape tensor extension type is defined as:
      * - Extension name: "arrow.variable_shape_tensor"
      * - Storage type: StructArray where struct is composed of:
-     *   - data: List holding tensor elements (each list element is a single tensor)
+     *   - data: List, LargeList or ListView holding tensor elements (each list element is a single tensor)
      *   - shape: FixedSizeList<int32>[ndim] of the tensor shape
      *
      * Extension type parameters:
@@ -145,6 +152,93 @@ namespace sparrow_extensions
         [[nodiscard]] static metadata extract_metadata(const sparrow::arrow_proxy& proxy);
     };
 
+    /**
+     * @brief Precomputed layout of the tensors of a variable_shape_tensor_array.
+     *
+     * The index is built in a single pass over the data offsets and the shape child,
+     * and turns every typed access into a couple of loads from contiguous vectors.
+     */
+    struct variable_shape_tensor_index
+    {
+        /// Number of dimensions of each tensor.
+        std::size_t ndim = 0;
+        /// True if all the tensors have the shape given by a fully specified uniform_shape.
+        bool uniform = false;
+        /// Position of the first element of each tensor in the values of the data child.
+        std::vector<std::int64_t> element_offsets;
+        /// Number of elements of each tensor.
+        std::vector<std::int64_t> element_counts;
+        /// Shapes of all the tensors, ndim consecutive values per tensor, or the single
+        /// shape shared by all the tensors if uniform is true.
+        std::vector<std::int32_t> shapes;
+        /// Axes whose extent is not fixed by uniform_shape, in increasing order.
+        std::vector<std::size_t> varying_axes;
+        /// Stride of each axis shared by all the tensors, 0 if it depends on the tensor.
+        /// The stride of an axis is constant when all the following axes are uniform.
+        std::vector<std::int64_t> constant_strides;
+        /// Validity of each tensor, empty if the array has no validity bitmap.
+        std::vector<bool> validity;
+
+        /**
+         * @brief Returns the shape of tensor i.
+         */
+        [[nodiscard]] std::span<const std::int32_t> shape(std::size_t i) const
+        {
+            return {shapes.data() + (uniform ? 0 : i * ndim), ndim};
+        }
+
+        /**
+         * @brief Checks if tensor i is not null.
+         */
+        [[nodiscard]] bool is_valid(std::size_t i) const
+        {
+            return validity.empty() || validity[i];
+        }
+    };
+
+    /**
+     * @brief Constraint violated by a variable_shape_tensor_array, as reported by validate().
+     */
+    struct tensor_validation_error
+    {
+        /// Row of the first invalid tensor, empty if the error is not specific to a tensor.
+        std::optional<std::size_t> row;
+        /// Description of the violated constraint.
+        std::string reason;
+    };
+
+    namespace detail
+    {
+        /**
+         * @brief Location of a tensor in the buffers of a variable_shape_tensor_array.
+         */
+        struct tensor_location
+        {
+            /// Values buffer of the data child, not adjusted for its offset.
+            const void* values = nullptr;
+            /// Position of the first element of the tensor in the values buffer.
+            std::int64_t element_offset = 0;
+            /// Number of elements of the tensor.
+            std::int64_t element_count = 0;
+            /// Shape of the tensor.
+            std::span<const std::int32_t> shape;
+            /// Data type of the tensor elements.
+            sparrow::data_type value_type = sparrow::data_type::NA;
+            /// Whether the tensor is not null.
+            bool is_valid = true;
+        };
+
+        [[nodiscard]] constexpr std::int64_t shape_element_count(std::span<const std::int32_t> shape)
+        {
+            std::int64_t result = 1;
+            for (const auto dim : shape)
+            {
+                result *= dim;
+            }
+            return result;
+        }
+    }
+
     /**
      * @brief Variable shape tensor array wrapping a struct_array.
      *
@@ -188,7 +282,7 @@ namespace sparrow_extensions
          * @brief Constructs a variable shape tensor array from data and shapes.
          *
          * @param ndim Number of dimensions for all tensors
-         * @param tensor_data List array containing flattened tensor data (one list per tensor)
+         * @param tensor_data List, LargeList or ListView array of the flattened tensors (one list per tensor)
          * @param tensor_shapes FixedSizeList array containing shapes (one shape per tensor)
          * @param tensor_metadata Metadata describing the tensor layout
          *
@@ -208,7 +302,7 @@ namespace sparrow_extensions
          * @brief Constructs a variable shape tensor array with name and/or metadata.
          *
          * @param ndim Number of dimensions for all tensors
-         * @param tensor_data List array containing flattened tensor data (one list per tensor)
+         * @param tensor_data List, LargeList or ListView array of the flattened tensors (one list per tensor)
          * @param tensor_shapes FixedSizeList array containing shapes (one shape per tensor)
          * @param tensor_metadata Metadata describing the tensor layout
          * @param name Name for the array
@@ -233,7 +327,7 @@ namespace sparrow_extensions
          *
          * @tparam VB Type of validity bitmap input
          * @param ndim Number of dimensions for all tensors
-         * @param tensor_data List array containing flattened tensor data (one list per tensor)
+         * @param tensor_data List, LargeList or ListView array of the flattened tensors (one list per tensor)
          * @param tensor_shapes FixedSizeList array containing shapes (one shape per tensor)
          * @param tensor_metadata Metadata describing the tensor layout
          * @param validity_input Validity bitmap (one bit per tensor)
@@ -259,7 +353,7 @@ namespace sparrow_extensions
          * @tparam VB Type of validity bitmap input
          * @tparam METADATA_RANGE Type of metadata container
          * @param ndim Number of dimensions for all tensors
-         * @param tensor_data List array containing flattened tensor data (one list per tensor)
+         * @param tensor_data List, LargeList or ListView array of the flattened tensors (one list per tensor)
          * @param tensor_shapes FixedSizeList array containing shapes (one shape per tensor)
          * @param tensor_metadata Metadata describing the tensor layout
          * @param validity_input Validity bitmap (one bit per tensor)
@@ -307,9 +401,104 @@ namespace sparrow_extensions
 
         /**
          * @brief Returns the underlying struct_array.
+         *
+         * Drops the cached index, since the storage may be modified through the returned reference.
          */
         [[nodiscard]] sparrow::struct_array& storage();
 
+        /**
+         * @brief Builds the index of the tensor layout if it is not already cached.
+         *
+         * When uniform_shape is fully specified, the shape child is not read and a single
+         * shape is stored; otherwise the uniform extents are taken from the metadata.
+         * The children are trusted to agree with uniform_shape: arrays that do not come
+         * from this library must pass validate() before the index is built.
+         *
+         * @return The cached index
+         */
+        const variable_shape_tensor_index& build_index();
+
+        /**
+         * @brief Returns the index of the tensor layout without caching it.
+         *
+         * Returns the cached index when available, builds a new one otherwise. This lets
+         * functions taking a const array traverse it with a single pass over the children.
+         *
+         * @return The index, shared with the array if it was cached
+         */
+        [[nodiscard]] std::shared_ptr<const variable_shape_tensor_index> layout() const;
+
+        /**
+         * @brief Checks if the index of the tensor layout is cached.
+         */
+        [[nodiscard]] bool has_index() const;
+
+        /**
+         * @brief Returns the cached index of the tensor layout.
+         *
+         * @pre has_index()
+         */
+        [[nodiscard]] const variable_shape_tensor_index& index() const;
+
+        /**
+         * @brief Checks that the shapes of the tensors agree with the uniform_shape metadata.
+         *
+         * Every non-null tensor must have the extent given by uniform_shape on each
+         * uniform dimension. This check is performed when constructing an array from
+         * data and shapes; arrays wrapped from an arrow proxy are not checked.
+         *
+         * @return true if uniform_shape is absent or all tensors conform to it
+         */
+        [[nodiscard]] bool conforms_to_uniform_shape() const;
+
+        /**
+         * @brief Returns the shape of tensor i.
+         *
+         * Uses the cached index when available, reads the shape child otherwise.
+         *
+         * @param i Index of the tensor
+         * @return The shape of the tensor, valid as long as the array is not modified
+         *
+         * @pre i < size()
+         */
+        [[nodiscard]] std::span<const std::int32_t> tensor_shape(size_type i) const;
+
+        /**
+         * @brief Returns a typed multidimensional view of tensor i.
+         *
+         * Uses the cached index when available, reads the data and shape children
+         * buffers directly otherwise. The validity of the tensor is not checked: the
+         * view of a null tensor must not be dereferenced.
+         *
+         * @tparam T The type of the tensor elements
+         * @param i Index of the tensor
+         * @return A row-major view of the tensor elements
+         *
+         * @pre i < size()
+         * @pre T must match the value type of the data child
+         * @pre If tensor i is not null, the product of its shape is its number of elements
+         */
+        template <class T>
+        [[nodiscard]] sparrow_extensions::tensor_view<T> tensor_view(size_type i) const;
+
+        /**
+         * @brief Returns the data type of the tensor elements.
+         */
+        [[nodiscard]] sparrow::data_type value_type() const;
+
+        /**
+         * @brief Returns the values buffer of the data child.
+         *
+         * The span starts at the beginning of the buffer, not at the offset of the data
+         * child, so that it is addressed by the element offsets of the index.
+         *
+         * @tparam T The type of the tensor elements
+         *
+         * @pre T must match value_type()
+         */
+        template <class T>
+        [[nodiscard]] std::span<const T> values() const;
+
         /**
          * @brief Access tensor at index i.
          *
@@ -330,6 +519,8 @@ namespace sparrow_extensions
 
         /**
          * @brief Returns the underlying arrow_proxy.
+         *
+         * Drops the cached index, since the storage may be modified through the returned reference.
          */
         [[nodiscard]] sparrow::arrow_proxy& get_arrow_proxy();
 
@@ -408,6 +599,20 @@ namespace sparrow_extensions
          */
         [[nodiscard]] bool is_valid() const;
 
+        /**
+         * @brief Performs a full structural validation of the tensor array.
+         *
+         * In addition to the checks of is_valid(), verifies the layout of the children
+         * (formats, lengths, ndim), that the list offsets are non-decreasing and within
+         * the values, and that every non-null tensor has positive extents whose product
+         * is its number of elements, and which agree with uniform_shape. The rows are
+         * checked in parallel with tight loops over the offsets and shape buffers, so the
+         * whole array can be checked when it comes from an untrusted producer.
+         *
+         * @return The first violated constraint, or nullopt if the array is valid
+         */
+        [[nodiscard]] std::optional<tensor_validation_error> validate() const;
+
         /**
          * @brief Returns the name of the data field.
          *
@@ -482,16 +687,47 @@ namespace sparrow_extensions
          */
         [[nodiscard]] const_reverse_iterator crend() const;
 
+        /**
+         * @brief Returns the tensors in [start, end) as an array owning a copy of the storage.
+         *
+         * The extension metadata is neither parsed again nor copied: the slice shares it
+         * with this array. The index is not carried over.
+         *
+         * @pre start <= end <= size()
+         */
+        [[nodiscard]] variable_shape_tensor_array slice(size_type start, size_type end) const;
+
+        /**
+         * @brief Returns the tensors in [start, end) as an array sharing the buffers of this one.
+         *
+         * Only the offset and length of the storage differ from this array; neither the
+         * buffers nor the extension metadata are copied, and the extension is not
+         * initialized again, which makes slicing an array into many small pieces cheap.
+         * The slice is invalidated when this array is destroyed or modified.
+         *
+         * @pre start <= end <= size()
+         */
+        [[nodiscard]] variable_shape_tensor_array slice_view(size_type start, size_type end) const;
+
     private:
 
+        variable_shape_tensor_array(
+            sparrow::struct_array&& storage,
+            std::shared_ptr<const metadata_type> tensor_metadata
+        );
+
         void validate_and_init(
             std::uint64_t ndim,
             std::optional<std::string_view> name = std::nullopt,
             std::optional<std::vector<sparrow::metadata_pair>>* arrow_metadata = nullptr
         );
 
+        [[nodiscard]] detail::tensor_location locate_tensor(size_type i) const;
+        [[nodiscard]] std::pair<const void*, std::size_t> values_buffer() const;
+
         sparrow::struct_array m_storage;
-        metadata_type m_metadata;
+        std::shared_ptr<const metadata_type> m_metadata;
+        std::shared_ptr<const variable_shape_tensor_index> m_index;
     };
 
     // Helper function to construct the struct array with named fields
@@ -504,6 +740,7 @@ namespace sparrow_extensions
             VB&& validity_input = false
         )
         {
+            SPARROW_EXTENSIONS_ALLOCATION_SITE("variable_shape_tensor_array storage");
             // Set names on the arrays
             sparrow::detail::array_access::get_arrow_proxy(tensor_data).set_name("data");
             sparrow::detail::array_access::get_arrow_proxy(tensor_shapes).set_name("shape");
@@ -527,7 +764,7 @@ namespace sparrow_extensions
         VB&& validity_input
     )
         : m_storage(detail::make_tensor_struct(std::move(tensor_data), std::move(tensor_shapes), std::forward<VB>(validity_input)))
-        , m_metadata(tensor_metadata)
+        , m_metadata(std::make_shared<const metadata_type>(tensor_metadata))
     {
         validate_and_init(ndim);
     }
@@ -543,7 +780,7 @@ namespace sparrow_extensions
         std::optional<METADATA_RANGE> arrow_metadata
     )
         : m_storage(detail::make_tensor_struct(std::move(tensor_data), std::move(tensor_shapes), std::forward<VB>(validity_input)))
-        , m_metadata(tensor_metadata)
+        , m_metadata(std::make_shared<const metadata_type>(tensor_metadata))
     {
         std::optional<std::vector<sparrow::metadata_pair>> metadata_opt;
         if (arrow_metadata.has_value())
@@ -553,6 +790,32 @@ namespace sparrow_extensions
         validate_and_init(ndim, name, arrow_metadata.has_value() ? &metadata_opt : nullptr);
     }
 
+    template <class T>
+    sparrow_extensions::tensor_view<T> variable_shape_tensor_array::tensor_view(size_type i) const
+    {
+        static_assert(!std::same_as<T, bool>, "bit-packed boolean tensors cannot be viewed");
+        const auto location = locate_tensor(i);
+        SPARROW_ASSERT_TRUE(location.value_type == sparrow::arrow_traits<T>::type_id);
+        SPARROW_ASSERT_TRUE(
+            !location.is_valid || detail::shape_element_count(location.shape) == location.element_count
+        );
+        const T* data = static_cast<const T*>(location.values) + location.element_offset;
+        if (m_index != nullptr)
+        {
+            return {data, location.shape, m_index->constant_strides};
+        }
+        return {data, location.shape};
+    }
+
+    template <class T>
+    std::span<const T> variable_shape_tensor_array::values() const
+    {
+        static_assert(!std::same_as<T, bool>, "bit-packed boolean tensors cannot be viewed");
+        SPARROW_ASSERT_TRUE(value_type() == sparrow::arrow_traits<T>::type_id);
+        const auto [data, size] = values_buffer();
+        return {static_cast<const T*>(data), size};
+    }
+
 }  // namespace sparrow_extensions
 
 namespace sparrow::detail
@@ -0,0 +1,484 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "sparrow/array.hpp"
+#include "sparrow/buffer/u8_buffer.hpp"
+#include "sparrow/list_array.hpp"
+#include "sparrow/primitive_array.hpp"
+#include "sparrow/utils/contracts.hpp"
+
+#include "sparrow_extensions/allocation_tracker.hpp"
+#include "sparrow_extensions/parallel.hpp"
+#include "sparrow_extensions/variable_shape_tensor.hpp"
+
+namespace sparrow_extensions
+{
+    namespace detail
+    {
+        template <class E>
+        struct is_optional : std::false_type
+        {
+        };
+
+        template <class E>
+        struct is_optional<std::optional<E>> : std::true_type
+        {
+        };
+
+        // Minimum number of tensors copied by each thread when filling the buffers in bulk
+        inline constexpr std::size_t tensor_fill_grain_size = 4096;
+
+        template <class E>
+        [[nodiscard]] constexpr bool tensor_entry_has_value(const E& entry)
+        {
+            if constexpr (is_optional<E>::value)
+            {
+                return entry.has_value();
+            }
+            else
+            {
+                return true;
+            }
+        }
+
+        template <class E>
+        [[nodiscard]] constexpr const auto& tensor_entry_value(const E& entry)
+        {
+            if constexpr (is_optional<E>::value)
+            {
+                return *entry;
+            }
+            else
+            {
+                return entry;
+            }
+        }
+    }
+
+    /**
+     * @brief A (shape, values) pair describing one tensor, e.g.
+     * std::pair<std::vector<std::int32_t>, std::vector<float>>.
+     */
+    template <class E, class T>
+    concept tensor_entry = requires(const E& entry) {
+        std::span<const std::int32_t>(std::get<0>(entry));
+        std::span<const T>(std::get<1>(entry));
+    };
+
+    /**
+     * @brief A tensor_entry, or a std::optional of a tensor_entry where nullopt denotes a null tensor.
+     */
+    template <class E, class T>
+    concept nullable_tensor_entry = tensor_entry<E, T>
+                                    || (detail::is_optional<E>::value
+                                        && tensor_entry<typename E::value_type, T>);
+
+    /**
+     * @brief Incremental builder of variable_shape_tensor_array.
+     *
+     * The builder writes the tensor elements, the list offsets, the shapes and the
+     * validity directly into the buffers that the resulting array adopts, so that
+     * finish() does not copy them. Tensors can be appended one at a time, in which
+     * case reserve() avoids reallocations, or in bulk with append_range(): when the
+     * input is a sized random access range, the tensors are checked and the offsets
+     * computed first, each buffer is grown once, and the elements are copied in parallel.
+     *
+     * @tparam T The type of the tensor elements
+     * @tparam BIG Whether the data child is a LargeList, with 64-bit offsets, instead of
+     *             a List with 32-bit offsets limiting the array to 2^31 - 1 elements
+     *
+     * Example:
+     * @code
+     * variable_shape_tensor_builder<float> builder(2);
+     * builder.reserve(cloud_count, point_count * 3);
+     * for (const auto& cloud : clouds)
+     * {
+     *     const std::array<std::int32_t, 2> shape = {cloud.point_count, 3};
+     *     builder.append(shape, cloud.coordinates);
+     * }
+     * auto tensor_array = builder.finish("points");
+     * @endcode
+     */
+    template <class T, bool BIG = false>
+    class variable_shape_tensor_builder
+    {
+    public:
+
+        static_assert(!std::same_as<T, bool>, "bit-packed boolean tensors are not supported");
+
+        using value_type = T;
+        using size_type = std::size_t;
+        using offset_type = std::conditional_t<BIG, std::int64_t, std::int32_t>;
+        using list_type = std::conditional_t<BIG, sparrow::big_list_array, sparrow::list_array>;
+        using metadata_type = variable_shape_tensor_extension::metadata;
+
+        /**
+         * @brief Constructs an empty builder.
+         *
+         * @param ndim Number of dimensions of all the tensors
+         * @param tensor_metadata Metadata of the array to build
+         *
+         * @pre tensor_metadata must be valid and consistent with ndim
+         */
+        explicit variable_shape_tensor_builder(std::uint64_t ndim, metadata_type tensor_metadata = {});
+
+        /**
+         * @brief Reserves capacity in all the buffers.
+         *
+         * @param tensor_count Total number of tensors expected
+         * @param element_count Total number of elements expected across all tensors
+         */
+        void reserve(size_type tensor_count, size_type element_count);
+
+        /**
+         * @brief Appends a tensor.
+         *
+         * @param shape Extents of the tensor
+         * @param values Elements of the tensor in row-major order
+         *
+         * @pre shape.size() == ndim
+         * @pre values.size() equals the product of shape
+         */
+        void append(std::span<const std::int32_t> shape, std::span<const T> values);
+
+        /**
+         * @brief Appends a null tensor, with no element.
+         *
+         * The shape of a null tensor takes the uniform_shape extents, and 1 on the
+         * axes that uniform_shape leaves free, so that every row of the shape child
+         * holds positive extents that agree with uniform_shape.
+         */
+        void append_null();
+
+        /**
+         * @brief Appends a range of tensors.
+         *
+         * Sized random access ranges are appended in bulk: the buffers are grown
+         * once and filled in parallel. Other ranges are appended one tensor at a time.
+         *
+         * @param tensors Range of nullable_tensor_entry
+         */
+        template <std::ranges::input_range R>
+            requires nullable_tensor_entry<std::remove_cvref_t<std::ranges::range_reference_t<R>>, T>
+        void append_range(R&& tensors);
+
+        /**
+         * @brief Returns the number of tensors appended so far.
+         */
+        [[nodiscard]] size_type size() const;
+
+        /**
+         * @brief Returns the number of elements appended so far.
+         */
+        [[nodiscard]] size_type element_count() const;
+
+        /**
+         * @brief Builds the array from the appended tensors and resets the builder.
+         *
+         * @param name Optional name for the array
+         * @param arrow_metadata Optional Arrow metadata key-value pairs
+         * @return The tensor array, owning the buffers filled by the builder
+         */
+        [[nodiscard]] variable_shape_tensor_array finish(
+            std::optional<std::string_view> name = std::nullopt,
+            std::optional<std::vector<sparrow::metadata_pair>> arrow_metadata = std::nullopt
+        );
+
+    private:
+
+        void reset();
+        void check_tensor(
+            std::span<const std::int32_t> shape,
+            size_type value_count,
+            size_type element_offset
+        ) const;
+
+        std::uint64_t m_ndim;
+        metadata_type m_metadata;
+        std::vector<std::int32_t> m_null_shape;
+        sparrow::u8_buffer<T> m_values;
+        sparrow::u8_buffer<offset_type> m_offsets;
+        sparrow::u8_buffer<std::int32_t> m_shapes;
+        sparrow::validity_bitmap m_validity;
+    };
+
+    /**
+     * @brief Builder of variable_shape_tensor_array with a LargeList data child.
+     */
+    template <class T>
+    using big_variable_shape_tensor_builder = variable_shape_tensor_builder<T, true>;
+
+    /**
+     * @brief Builds a variable_shape_tensor_array from a range of tensors.
+     *
+     * @tparam T The type of the tensor elements
+     * @tparam BIG Whether the data child is a LargeList
+     * @param ndim Number of dimensions of all the tensors
+     * @param tensors Range of nullable_tensor_entry
+     * @param tensor_metadata Metadata of the array to build
+     * @param name Optional name for the array
+     *
+     * @see variable_shape_tensor_builder::append_range
+     */
+    template <class T, bool BIG = false, std::ranges::input_range R>
+        requires nullable_tensor_entry<std::remove_cvref_t<std::ranges::range_reference_t<R>>, T>
+    [[nodiscard]] variable_shape_tensor_array make_variable_shape_tensor_array(
+        std::uint64_t ndim,
+        R&& tensors,
+        const variable_shape_tensor_extension::metadata& tensor_metadata = {},
+        std::optional<std::string_view> name = std::nullopt
+    )
+    {
+        variable_shape_tensor_builder<T, BIG> builder(ndim, tensor_metadata);
+        builder.append_range(std::forward<R>(tensors));
+        return builder.finish(name);
+    }
+
+    template <class T, bool BIG>
+    variable_shape_tensor_builder<T, BIG>::variable_shape_tensor_builder(
+        std::uint64_t ndim,
+        metadata_type tensor_metadata
+    )
+        : m_ndim(ndim)
+        , m_metadata(std::move(tensor_metadata))
+        , m_null_shape(static_cast<std::size_t>(ndim), 1)
+        , m_values(size_type{0}, T{})
+        , m_offsets(size_type{1}, offset_type{0})
+        , m_shapes(size_type{0}, std::int32_t{0})
+    {
+        if (m_metadata.uniform_shape.has_value())
+        {
+            SPARROW_ASSERT_TRUE(m_metadata.uniform_shape->size() == m_ndim);
+            for (std::size_t axis = 0; axis < m_null_shape.size(); ++axis)
+            {
+                m_null_shape[axis] = (*m_metadata.uniform_shape)[axis].value_or(1);
+            }
+        }
+    }
+
+    template <class T, bool BIG>
+    void variable_shape_tensor_builder<T, BIG>::reserve(size_type tensor_count, size_type element_count)
+    {
+        SPARROW_EXTENSIONS_ALLOCATION_SITE("variable_shape_tensor_builder::reserve");
+        m_values.reserve(element_count);
+        m_offsets.reserve(tensor_count + 1);
+        m_shapes.reserve(tensor_count * m_ndim);
+    }
+
+    template <class T, bool BIG>
+    void variable_shape_tensor_builder<T, BIG>::append(
+        std::span<const std::int32_t> shape,
+        std::span<const T> values
+    )
+    {
+        SPARROW_EXTENSIONS_ALLOCATION_SITE("variable_shape_tensor_builder::append");
+        check_tensor(shape, values.size(), element_count());
+        m_values.insert(m_values.cend(), values.begin(), values.end());
+        m_shapes.insert(m_shapes.cend(), shape.begin(), shape.end());
+        m_offsets.push_back(static_cast<offset_type>(m_values.size()));
+        m_validity.push_back(true);
+    }
+
+    template <class T, bool BIG>
+    void variable_shape_tensor_builder<T, BIG>::append_null()
+    {
+        SPARROW_EXTENSIONS_ALLOCATION_SITE("variable_shape_tensor_builder::append_null");
+        m_shapes.insert(m_shapes.cend(), m_null_shape.begin(), m_null_shape.end());
+        m_offsets.push_back(m_offsets.back());
+        m_validity.push_back(false);
+    }
+
+    template <class T, bool BIG>
+    template <std::ranges::input_range R>
+        requires nullable_tensor_entry<std::remove_cvref_t<std::ranges::range_reference_t<R>>, T>
+    void variable_shape_tensor_builder<T, BIG>::append_range(R&& tensors)
+    {
+        SPARROW_EXTENSIONS_ALLOCATION_SITE("variable_shape_tensor_builder::append_range");
+        if constexpr (std::ranges::random_access_range<R> && std::ranges::sized_range<R>)
+        {
+            const auto first = std::ranges::begin(tensors);
+            const auto tensor_count = static_cast<size_type>(std::ranges::size(tensors));
+            const size_type first_tensor = size();
+            const auto entry_at = [&first](size_type i) -> decltype(auto)
+            {
+                return first[static_cast<std::ranges::range_difference_t<R>>(i)];
+            };
+
+            // Checking pass: the builder is left untouched if any tensor is rejected
+            size_type end_offset = element_count();
+            for (size_type i = 0; i < tensor_count; ++i)
+            {
+                const auto& entry = entry_at(i);
+                if (detail::tensor_entry_has_value(entry))
+                {
+                    const auto& tensor = detail::tensor_entry_value(entry);
+                    const std::span<const T> values(std::get<1>(tensor));
+                    check_tensor(std::get<0>(tensor), values.size(), end_offset);
+                    end_offset += values.size();
+                }
+            }
+
+            // Sizing pass: offsets and validity are known before any element is copied
+            m_offsets.reserve(m_offsets.size() + tensor_count);
+            m_validity.resize(first_tensor + tensor_count, true);
+            size_type offset = element_count();
+            for (size_type i = 0; i < tensor_count; ++i)
+            {
+                const auto& entry = entry_at(i);
+                if (detail::tensor_entry_has_value(entry))
+                {
+                    offset += std::span<const T>(std::get<1>(detail::tensor_entry_value(entry))).size();
+                }
+                else
+                {
+                    m_validity.set(first_tensor + i, false);
+                }
+                m_offsets.push_back(static_cast<offset_type>(offset));
+            }
+
+            // u8_buffer cannot grow without initialising its elements, so the values are
+            // zero-filled here before being overwritten by the parallel copy
+            m_values.resize(end_offset);
+            m_shapes.resize(m_shapes.size() + tensor_count * m_ndim);
+
+            T* values_data = m_values.data();
+            std::int32_t* shapes_data = m_shapes.data() + first_tensor * m_ndim;
+            const offset_type* offsets_data = m_offsets.data() + first_tensor;
+            detail::parallel_for(
+                tensor_count,
+                detail::tensor_fill_grain_size,
+                [&](size_type begin, size_type end)
+                {
+                    for (size_type i = begin; i < end; ++i)
+                    {
+                        const auto& entry = entry_at(i);
+                        if (!detail::tensor_entry_has_value(entry))
+                        {
+                            std::ranges::copy(m_null_shape, shapes_data + i * m_ndim);
+                            continue;
+                        }
+                        const auto& tensor = detail::tensor_entry_value(entry);
+                        const std::span<const std::int32_t> shape(std::get<0>(tensor));
+                        const std::span<const T> values(std::get<1>(tensor));
+                        std::ranges::copy(values, values_data + offsets_data[i]);
+                        std::ranges::copy(shape, shapes_data + i * m_ndim);
+                    }
+                }
+            );
+        }
+        else
+        {
+            for (auto&& entry : tensors)
+            {
+                if (detail::tensor_entry_has_value(entry))
+                {
+                    const auto& tensor = detail::tensor_entry_value(entry);
+                    append(std::get<0>(tensor), std::get<1>(tensor));
+                }
+                else
+                {
+                    append_null();
+                }
+            }
+        }
+    }
+
+    template <class T, bool BIG>
+    auto variable_shape_tensor_builder<T, BIG>::size() const -> size_type
+    {
+        return m_offsets.size() - 1;
+    }
+
+    template <class T, bool BIG>
+    auto variable_shape_tensor_builder<T, BIG>::element_count() const -> size_type
+    {
+        return static_cast<size_type>(m_offsets.back());
+    }
+
+    template <class T, bool BIG>
+    variable_shape_tensor_array variable_shape_tensor_builder<T, BIG>::finish(
+        std::optional<std::string_view> name,
+        std::optional<std::vector<sparrow::metadata_pair>> arrow_metadata
+    )
+    {
+        SPARROW_EXTENSIONS_ALLOCATION_SITE("variable_shape_tensor_builder::finish");
+        const size_type values_size = m_values.size();
+        const size_type shapes_size = m_shapes.size();
+        list_type tensor_data(
+            sparrow::array(sparrow::primitive_array<T>(std::move(m_values), values_size)),
+            std::move(m_offsets)
+        );
+        sparrow::fixed_sized_list_array tensor_shapes(
+            m_ndim,
+            sparrow::array(sparrow::primitive_array<std::int32_t>(std::move(m_shapes), shapes_size))
+        );
+        sparrow::validity_bitmap validity = std::move(m_validity);
+        reset();
+
+        return variable_shape_tensor_array(
+            m_ndim,
+            sparrow::array(std::move(tensor_data)),
+            sparrow::array(std::move(tensor_shapes)),
+            m_metadata,
+            std::move(validity),
+            name,
+            std::move(arrow_metadata)
+        );
+    }
+
+    template <class T, bool BIG>
+    void variable_shape_tensor_builder<T, BIG>::reset()
+    {
+        m_values = sparrow::u8_buffer<T>(size_type{0}, T{});
+        m_offsets = sparrow::u8_buffer<offset_type>(size_type{1}, offset_type{0});
+        m_shapes = sparrow::u8_buffer<std::int32_t>(size_type{0}, std::int32_t{0});
+        m_validity = sparrow::validity_bitmap();
+    }
+
+    template <class T, bool BIG>
+    void variable_shape_tensor_builder<T, BIG>::check_tensor(
+        std::span<const std::int32_t> shape,
+        size_type value_count,
+        size_type element_offset
+    ) const
+    {
+        SPARROW_ASSERT_TRUE(shape.size() == m_ndim);
+        for (std::size_t axis = 0; axis < shape.size(); ++axis)
+        {
+            SPARROW_ASSERT_TRUE(shape[axis] > 0);
+            const bool is_uniform_axis = m_metadata.uniform_shape.has_value()
+                                         && (*m_metadata.uniform_shape)[axis].has_value();
+            SPARROW_ASSERT_TRUE(!is_uniform_axis || shape[axis] == *(*m_metadata.uniform_shape)[axis]);
+        }
+        SPARROW_ASSERT_TRUE(std::cmp_equal(detail::shape_element_count(shape), value_count));
+        SPARROW_ASSERT_TRUE(
+            std::cmp_less_equal(element_offset + value_count, std::numeric_limits<offset_type>::max())
+        );
+    }
+}
@@ -0,0 +1,333 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "sparrow/primitive_array.hpp"
+
+#include "sparrow_extensions/bool8_array.hpp"
+#include "sparrow_extensions/config/config.hpp"
+#include "sparrow_extensions/fixed_shape_tensor.hpp"
+#include "sparrow_extensions/variable_shape_tensor.hpp"
+
+namespace sparrow_extensions
+{
+    /**
+     * @brief Options of bucket_by_shape.
+     */
+    struct shape_bucketing_options
+    {
+        /// Granularity of the buckets along each axis: the extents are rounded up to a
+        /// multiple of it and the tensors are padded to the shape of their bucket. Empty
+        /// groups the tensors by exact shape.
+        std::vector<std::int32_t> granularity;
+        /// Value of the padding elements, converted to the type of the tensor elements.
+        double pad_value = 0;
+    };
+
+    /**
+     * @brief Tensors of a variable_shape_tensor_array that share the same shape.
+     */
+    struct shape_bucket
+    {
+        /// Shape of the tensors of the bucket.
+        std::vector<std::int64_t> shape;
+        /// Rows of the source array, in the order of the tensors of the bucket.
+        std::vector<std::size_t> row_indices;
+        /// The tensors of the bucket, densely packed.
+        fixed_shape_tensor_array tensors;
+    };
+
+    /**
+     * @brief Result of bucket_by_shape.
+     */
+    struct shape_buckets
+    {
+        /// Buckets, in the order of their first row in the source array.
+        std::vector<shape_bucket> buckets;
+        /// Rows that cannot be stored in a fixed shape tensor: null tensors, tensors with a
+        /// zero extent, and the scalars of an array with no dimension, since the shape of
+        /// a fixed shape tensor cannot be empty.
+        std::vector<std::size_t> unbucketed_rows;
+    };
+
+    /**
+     * @brief Partitions a variable_shape_tensor_array into fixed shape tensor batches.
+     *
+     * The tensors are grouped by shape in a single hashing pass, then each bucket is
+     * filled in parallel with one bulk copy per tensor, or one copy per innermost row
+     * when the tensor is padded to the shape of its bucket. The dim_names and the
+     * permutation of the source metadata are kept in the metadata of every bucket.
+     *
+     * @param tensors The array to partition
+     * @param options Bucketing options
+     * @return The buckets and the rows that belong to none of them
+     *
+     * @pre options.granularity is empty or holds one positive value per dimension
+     * @throws std::runtime_error if the tensor elements are not of a numeric type
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API shape_buckets
+    bucket_by_shape(const variable_shape_tensor_array& tensors, const shape_bucketing_options& options = {});
+
+    /**
+     * @brief Options of pad_to_dense.
+     */
+    struct padding_options
+    {
+        /// Shape of the dense tensors. Empty pads every axis to the largest extent of the
+        /// array (at least 1).
+        std::vector<std::int64_t> shape;
+        /// Whether tensors larger than shape are truncated; if false, they are rejected.
+        bool truncate = false;
+        /// Value of the padding elements, converted to the type of the tensor elements.
+        double pad_value = 0;
+    };
+
+    /**
+     * @brief Result of pad_to_dense.
+     */
+    struct padded_tensors
+    {
+        /// The padded tensors, null where the source tensor is null.
+        fixed_shape_tensor_array tensors;
+        /// One flag per element of tensors, true for the elements copied from the source
+        /// array and false for the padding.
+        bool8_array mask;
+    };
+
+    /**
+     * @brief Densifies a variable_shape_tensor_array into a single padded batch.
+     *
+     * Every tensor is copied at the origin of a dense tensor of the padded shape, one
+     * contiguous copy per innermost row, while the mask is filled in the same pass. The
+     * tensors are processed in parallel. The dim_names and the permutation of the source
+     * metadata are kept in the metadata of the result.
+     *
+     * @param tensors The array to densify
+     * @param options Padding options
+     * @return The dense tensors and the mask of their valid elements
+     *
+     * @pre options.shape is empty or holds one positive value per dimension
+     * @throws std::runtime_error if a tensor is larger than options.shape and truncate is false
+     * @throws std::runtime_error if the tensor elements are not of a numeric type
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API padded_tensors
+    pad_to_dense(const variable_shape_tensor_array& tensors, const padding_options& options = {});
+
+    /**
+     * @brief Reduction applied by reduce_tensors.
+     */
+    enum class tensor_reduction
+    {
+        sum,
+        mean,
+        min,
+        max,
+        /// Euclidean (L2) norm.
+        norm,
+        /// Number of elements.
+        count
+    };
+
+    /**
+     * @brief Reduces each tensor of a variable_shape_tensor_array to a scalar.
+     *
+     * The offsets of the data child are used as segment boundaries: each tensor is
+     * reduced with a single contiguous loop over its elements, and the tensors are
+     * split in row ranges processed in parallel. The reduction is computed in double.
+     *
+     * @param tensors The array to reduce
+     * @param reduction The reduction to apply
+     * @return One value per tensor, null for null tensors, and for the mean, min and
+     *         max of tensors without elements
+     *
+     * @throws std::runtime_error if the tensor elements are not of a numeric type
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API sparrow::primitive_array<double>
+    reduce_tensors(const variable_shape_tensor_array& tensors, tensor_reduction reduction);
+
+    /**
+     * @brief Reduces each tensor of a variable_shape_tensor_array along one axis.
+     *
+     * The result has one dimension less than the source. Its dim_names and
+     * uniform_shape are those of the source without the reduced axis; the
+     * permutation is not kept. The min and max along an axis of extent 0 are NaN.
+     *
+     * @param tensors The array to reduce
+     * @param reduction The reduction to apply
+     * @param axis The axis to reduce
+     * @return The reduced tensors, of double elements
+     *
+     * @pre axis < ndim
+     * @throws std::runtime_error if the tensor elements are not of a numeric type
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API variable_shape_tensor_array
+    reduce_tensors(const variable_shape_tensor_array& tensors, tensor_reduction reduction, std::size_t axis);
+
+    /**
+     * @brief Reduces each tensor of a variable_shape_tensor_array along a named axis.
+     *
+     * @param tensors The array to reduce
+     * @param reduction The reduction to apply
+     * @param axis_name The name of the axis to reduce, as given by dim_names
+     * @return The reduced tensors, of double elements
+     *
+     * @throws std::runtime_error if no dimension is named axis_name
+     * @throws std::runtime_error if the tensor elements are not of a numeric type
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API variable_shape_tensor_array reduce_tensors(
+        const variable_shape_tensor_array& tensors,
+        tensor_reduction reduction,
+        std::string_view axis_name
+    );
+
+    /**
+     * @brief Converts a fixed_shape_tensor_array to a variable_shape_tensor_array.
+     *
+     * The flat values of the source are moved, not copied, into the data child: only
+     * the list offsets, an arithmetic sequence, and the shape child, the fixed shape
+     * repeated for every tensor, are written. The data child is a LargeList if the
+     * elements do not fit 32-bit offsets, a List otherwise. The dim_names and the
+     * permutation are kept and uniform_shape is set to the fixed shape. The array name
+     * and validity are kept.
+     *
+     * @param tensors The array to convert; if it does not own its Arrow structures
+     *        (e.g. a slice_view), its values are copied instead of moved
+     * @return The converted array
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API variable_shape_tensor_array
+    to_variable_shape_tensor(fixed_shape_tensor_array&& tensors);
+
+    /**
+     * @brief Converts a fixed_shape_tensor_array to a variable_shape_tensor_array.
+     *
+     * Same as the overload taking an rvalue, but the flat values are copied.
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API variable_shape_tensor_array
+    to_variable_shape_tensor(const fixed_shape_tensor_array& tensors);
+
+    /**
+     * @brief Converts a variable_shape_tensor_array whose tensors all have the same shape
+     * to a fixed_shape_tensor_array.
+     *
+     * When the elements of consecutive tensors are contiguous (the list offsets are an
+     * arithmetic sequence, null tensors included), the values of the data child are
+     * moved, not copied, into the result. Otherwise the tensors are copied in parallel,
+     * and null tensors are filled with zeros. The dim_names and the permutation are kept,
+     * as well as the array name and validity.
+     *
+     * @param tensors The array to convert
+     * @return The converted array
+     *
+     * @throws std::runtime_error if two non-null tensors have different shapes, if a
+     *         shape has a zero extent, or if the array has no non-null tensor and no fully
+     *         specified uniform_shape
+     * @throws std::runtime_error if the values must be copied and are not of a numeric type
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API fixed_shape_tensor_array
+    to_fixed_shape_tensor(variable_shape_tensor_array&& tensors);
+
+    /**
+     * @brief Converts a variable_shape_tensor_array whose tensors all have the same shape
+     * to a fixed_shape_tensor_array.
+     *
+     * Same as the overload taking an rvalue, but the values are copied, with a single
+     * bulk copy when the tensors are contiguous.
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API fixed_shape_tensor_array
+    to_fixed_shape_tensor(const variable_shape_tensor_array& tensors);
+
+    /**
+     * @brief Reorders the tensors of a variable_shape_tensor_array without moving their elements.
+     *
+     * The result has a ListView data child: the values of the data child are moved, not
+     * copied, into the result, and only the list offsets and sizes, the shapes and the
+     * validity of the selected tensors are gathered. Shuffling or sorting an array is thus
+     * linear in the number of tensors, whatever their size. The indices can select a subset
+     * of the tensors and repeat them. The data child is a LargeListView when the elements
+     * do not fit in 32-bit offsets. The metadata and the array name are kept.
+     *
+     * @param tensors The array to reorder
+     * @param indices The rows of tensors, in the order of the result
+     * @return The reordered array
+     *
+     * @pre each index is less than tensors.size()
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API variable_shape_tensor_array
+    reorder_tensors(variable_shape_tensor_array&& tensors, std::span<const std::size_t> indices);
+
+    /**
+     * @brief Reorders the tensors of a variable_shape_tensor_array without moving their elements.
+     *
+     * Same as the overload taking an rvalue, but the values of the data child are copied
+     * once, in their original order.
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API variable_shape_tensor_array
+    reorder_tensors(const variable_shape_tensor_array& tensors, std::span<const std::size_t> indices);
+
+    /**
+     * @brief Gathers the tensors at the given rows of a variable_shape_tensor_array.
+     *
+     * The list offsets of the result are a prefix sum of the element counts of the
+     * selected tensors, and the shapes and validity are gathered in the same pass. The
+     * elements are then copied in parallel, with one bulk copy per tensor. Null tensors
+     * are kept null and hold no element. The data child is a LargeList when the elements
+     * do not fit in 32-bit offsets. The metadata and the array name are kept.
+     *
+     * @param tensors The array to gather from
+     * @param indices The rows of tensors, in the order of the result; they can repeat
+     * @return The gathered tensors, densely packed
+     *
+     * @pre each index is less than tensors.size()
+     * @throws std::runtime_error if the tensor elements are not of a numeric type
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API variable_shape_tensor_array
+    take_tensors(const variable_shape_tensor_array& tensors, std::span<const std::size_t> indices);
+
+    /**
+     * @brief Keeps the tensors of a variable_shape_tensor_array selected by a mask.
+     *
+     * Same as take_tensors with the rows whose flag is true, in their original order.
+     * A null flag drops the tensor.
+     *
+     * @param tensors The array to filter
+     * @param mask One flag per tensor
+     * @return The selected tensors, densely packed
+     *
+     * @pre mask.size() == tensors.size()
+     * @throws std::runtime_error if the tensor elements are not of a numeric type
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API variable_shape_tensor_array
+    filter_tensors(const variable_shape_tensor_array& tensors, const bool8_array& mask);
+
+    /**
+     * @brief Returns the rows of a variable_shape_tensor_array sorted by number of elements.
+     *
+     * The sort is stable, and null tensors count as empty. Sorting the tensors by
+     * decreasing size before splitting them between workers balances the load, and
+     * the result can be passed to take_tensors or reorder_tensors.
+     *
+     * @param tensors The array to sort
+     * @param descending Whether the largest tensors come first
+     * @return The permutation of the rows of tensors
+     */
+    [[nodiscard]] SPARROW_EXTENSIONS_API std::vector<std::size_t>
+    argsort_by_element_count(const variable_shape_tensor_array& tensors, bool descending = false);
+}
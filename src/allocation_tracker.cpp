@@ -0,0 +1,296 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sparrow_extensions/allocation_tracker.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#include <ostream>
+
+namespace sparrow_extensions
+{
+    struct allocation_site_list
+    {
+        static std::atomic<allocation_site*>& head() noexcept
+        {
+            // Constant-initialized, hence safe to use from other static initializers.
+            static constinit std::atomic<allocation_site*> list_head{nullptr};
+            return list_head;
+        }
+
+        static void push(allocation_site& site) noexcept
+        {
+            auto& list_head = head();
+            site.m_next = list_head.load(std::memory_order_relaxed);
+            while (!list_head.compare_exchange_weak(
+                site.m_next,
+                &site,
+                std::memory_order_release,
+                std::memory_order_relaxed
+            ))
+            {
+            }
+        }
+
+        static allocation_scope*& current_scope() noexcept
+        {
+            static constinit thread_local allocation_scope* scope = nullptr;
+            return scope;
+        }
+
+        static void record(std::size_t bytes) noexcept
+        {
+            for (allocation_scope* scope = current_scope(); scope != nullptr; scope = scope->m_parent)
+            {
+                scope->m_site.record(bytes);
+            }
+        }
+
+        template <class F>
+        static void for_each(F&& f)
+        {
+            for (allocation_site* site = head().load(std::memory_order_acquire); site != nullptr;
+                 site = site->m_next)
+            {
+                f(*site);
+            }
+        }
+    };
+
+    // allocation_site implementation
+
+    allocation_site::allocation_site(std::string_view name) noexcept
+        : m_name(name)
+    {
+        allocation_site_list::push(*this);
+    }
+
+    std::string_view allocation_site::name() const noexcept
+    {
+        return m_name;
+    }
+
+    void allocation_site::record(std::size_t bytes) noexcept
+    {
+        m_allocation_count.fetch_add(1, std::memory_order_relaxed);
+        m_allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    allocation_counters allocation_site::counters() const noexcept
+    {
+        return {
+            m_name,
+            m_allocation_count.load(std::memory_order_relaxed),
+            m_allocated_bytes.load(std::memory_order_relaxed)
+        };
+    }
+
+    void allocation_site::reset() noexcept
+    {
+        m_allocation_count.store(0, std::memory_order_relaxed);
+        m_allocated_bytes.store(0, std::memory_order_relaxed);
+    }
+
+    // allocation_scope implementation
+
+    allocation_scope::allocation_scope(allocation_site& site) noexcept
+        : m_site(site)
+        , m_parent(allocation_site_list::current_scope())
+    {
+        allocation_site_list::current_scope() = this;
+    }
+
+    allocation_scope::~allocation_scope()
+    {
+        allocation_site_list::current_scope() = m_parent;
+    }
+
+    // allocation_tracker implementation
+
+    namespace allocation_tracker
+    {
+        bool enabled() noexcept
+        {
+#if defined(SPARROW_EXTENSIONS_ALLOCATION_TRACKING)
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        void record_allocation(std::size_t bytes) noexcept
+        {
+            allocation_site_list::record(bytes);
+        }
+
+        std::vector<allocation_counters> snapshot()
+        {
+            // Sites declared in templates exist once per instantiation: their counters are merged by name
+            std::vector<allocation_counters> result;
+            allocation_site_list::for_each(
+                [&result](const allocation_site& site)
+                {
+                    const allocation_counters counters = site.counters();
+                    const auto it = std::ranges::find(result, counters.site, &allocation_counters::site);
+                    if (it == result.end())
+                    {
+                        result.push_back(counters);
+                    }
+                    else
+                    {
+                        it->allocation_count += counters.allocation_count;
+                        it->allocated_bytes += counters.allocated_bytes;
+                    }
+                }
+            );
+            std::ranges::sort(
+                result,
+                [](const allocation_counters& lhs, const allocation_counters& rhs)
+                {
+                    return lhs.allocated_bytes > rhs.allocated_bytes;
+                }
+            );
+            return result;
+        }
+
+        void reset() noexcept
+        {
+            allocation_site_list::for_each(
+                [](allocation_site& site)
+                {
+                    site.reset();
+                }
+            );
+        }
+
+        void dump(std::ostream& os)
+        {
+            for (const auto& counters : snapshot())
+            {
+                os << counters.site << ": " << counters.allocation_count << " allocations, "
+                   << counters.allocated_bytes << " bytes\n";
+            }
+        }
+    }
+}
+
+#if defined(SPARROW_EXTENSIONS_ALLOCATION_TRACKING)
+
+// Replacement of the global allocation functions. The aligned overloads are left untouched
+// and keep using the default implementation, which pairs with the default aligned delete.
+// On Windows, replacing them in a DLL only affects the allocations made by the DLL itself.
+
+#    if defined(_WIN32)
+#        define SPARROW_EXTENSIONS_REPLACEMENT_API
+#    else
+#        define SPARROW_EXTENSIONS_REPLACEMENT_API __attribute__((visibility("default")))
+#    endif
+
+namespace
+{
+    void* tracked_allocate(std::size_t size) noexcept
+    {
+        void* ptr = std::malloc(size == 0 ? 1 : size);
+        if (ptr != nullptr)
+        {
+            sparrow_extensions::allocation_tracker::record_allocation(size);
+        }
+        return ptr;
+    }
+
+    // Follows the standard behaviour of the throwing operator new: on failure, call the
+    // installed new_handler and retry, and only throw when no handler is installed.
+    void* tracked_allocate_or_throw(std::size_t size)
+    {
+        void* ptr = tracked_allocate(size);
+        while (ptr == nullptr)
+        {
+            const std::new_handler handler = std::get_new_handler();
+            if (handler == nullptr)
+            {
+                throw std::bad_alloc();
+            }
+            handler();
+            ptr = tracked_allocate(size);
+        }
+        return ptr;
+    }
+}
+
+SPARROW_EXTENSIONS_REPLACEMENT_API void* operator new(std::size_t size)
+{
+    return tracked_allocate_or_throw(size);
+}
+
+SPARROW_EXTENSIONS_REPLACEMENT_API void* operator new[](std::size_t size)
+{
+    return tracked_allocate_or_throw(size);
+}
+
+SPARROW_EXTENSIONS_REPLACEMENT_API void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    try
+    {
+        return tracked_allocate_or_throw(size);
+    }
+    catch (const std::bad_alloc&)
+    {
+        return nullptr;
+    }
+}
+
+SPARROW_EXTENSIONS_REPLACEMENT_API void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    try
+    {
+        return tracked_allocate_or_throw(size);
+    }
+    catch (const std::bad_alloc&)
+    {
+        return nullptr;
+    }
+}
+
+SPARROW_EXTENSIONS_REPLACEMENT_API void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+SPARROW_EXTENSIONS_REPLACEMENT_API void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+SPARROW_EXTENSIONS_REPLACEMENT_API void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+SPARROW_EXTENSIONS_REPLACEMENT_API void operator delete[](void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+SPARROW_EXTENSIONS_REPLACEMENT_API void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    std::free(ptr);
+}
+
+SPARROW_EXTENSIONS_REPLACEMENT_API void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+    std::free(ptr);
+}
+
+#endif
@@ -14,27 +14,50 @@
 
 #include "sparrow_extensions/bool8_array.hpp"
 
+#include <mutex>
+
 #include "sparrow/layout/array_registry.hpp"
 
+#include "sparrow_extensions/allocation_tracker.hpp"
 #include "sparrow_extensions/config/config.hpp"
+#include "sparrow_extensions/registration.hpp"
 
-namespace sparrow_extensions::detail
+namespace sparrow_extensions
 {
-    SPARROW_EXTENSIONS_API const bool bool8_array_registered = []()
+    void register_bool8_extension()
     {
-        auto& registry = sparrow::array_registry::instance();
-
-        registry.register_extension(
-            sparrow::data_type::INT8,
-            "arrow.bool8",
-            [](sparrow::arrow_proxy proxy)
+        static std::once_flag registered;
+        std::call_once(
+            registered,
+            []()
             {
-                return sparrow::cloning_ptr<sparrow::array_wrapper>{
-                    new sparrow::array_wrapper_impl<bool8_array>(bool8_array(std::move(proxy)))
-                };
+                auto& registry = sparrow::array_registry::instance();
+
+                registry.register_extension(
+                    sparrow::data_type::INT8,
+                    "arrow.bool8",
+                    [](sparrow::arrow_proxy proxy)
+                    {
+                        SPARROW_EXTENSIONS_ALLOCATION_SITE("bool8_array registry factory");
+                        return sparrow::cloning_ptr<sparrow::array_wrapper>{
+                            new sparrow::array_wrapper_impl<bool8_array>(bool8_array(std::move(proxy)))
+                        };
+                    }
+                );
             }
         );
+    }
+}
 
+namespace sparrow_extensions::detail
+{
+#if defined(SPARROW_EXTENSIONS_DISABLE_AUTO_REGISTRATION)
+    SPARROW_EXTENSIONS_API const bool bool8_array_registered = false;
+#else
+    SPARROW_EXTENSIONS_API const bool bool8_array_registered = []()
+    {
+        sparrow_extensions::register_bool8_extension();
         return true;
     }();
+#endif
 }
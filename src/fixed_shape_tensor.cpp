@@ -15,8 +15,10 @@
 #include "sparrow_extensions/fixed_shape_tensor.hpp"
 
 #include <algorithm>
+#include <mutex>
 #include <numeric>
 #include <stdexcept>
+#include <utility>
 
 #include <simdjson.h>
 
@@ -25,7 +27,10 @@
 #include "sparrow/layout/array_registry.hpp"
 #include "sparrow/utils/contracts.hpp"
 
+#include "sparrow_extensions/allocation_tracker.hpp"
 #include "sparrow_extensions/config/config.hpp"
+#include "sparrow_extensions/json_parser_pool.hpp"
+#include "sparrow_extensions/registration.hpp"
 
 namespace sparrow_extensions
 {
@@ -98,6 +103,8 @@ namespace sparrow_extensions
 
     std::string fixed_shape_tensor_extension::metadata::to_json() const
     {
+        SPARROW_EXTENSIONS_ALLOCATION_SITE("fixed_shape_tensor_extension::metadata::to_json");
+
         // Pre-calculate approximate size to minimize allocations
         std::size_t estimated_size = json_base_size;
         estimated_size += shape.size() * json_integer_avg_size;
@@ -175,6 +182,8 @@ namespace sparrow_extensions
     fixed_shape_tensor_extension::metadata
     fixed_shape_tensor_extension::metadata::from_json(std::string_view json)
     {
+        SPARROW_EXTENSIONS_ALLOCATION_SITE("fixed_shape_tensor_extension::metadata::from_json");
+
         auto parse_int_array = [](simdjson::ondemand::array arr) -> std::vector<std::int64_t>
         {
             std::vector<std::int64_t> result;
@@ -201,9 +210,9 @@ namespace sparrow_extensions
         {
             metadata result;
 
-            simdjson::ondemand::parser parser;
+            auto parser = detail::ondemand_parser_pool().acquire();
             simdjson::padded_string padded_json(json);
-            simdjson::ondemand::document doc = parser.iterate(padded_json);
+            simdjson::ondemand::document doc = parser->iterate(padded_json);
 
             // Parse shape (required)
             auto shape_field = doc["shape"];
@@ -247,6 +256,7 @@ namespace sparrow_extensions
 
     void fixed_shape_tensor_extension::init(sparrow::arrow_proxy& proxy, const metadata& tensor_metadata)
     {
+        SPARROW_EXTENSIONS_ALLOCATION_SITE("fixed_shape_tensor_extension::init");
         SPARROW_ASSERT_TRUE(tensor_metadata.is_valid());
 
         // Get existing metadata
@@ -286,6 +296,8 @@ namespace sparrow_extensions
     fixed_shape_tensor_extension::metadata
     fixed_shape_tensor_extension::extract_metadata(const sparrow::arrow_proxy& proxy)
     {
+        SPARROW_EXTENSIONS_ALLOCATION_SITE("fixed_shape_tensor_extension::extract_metadata");
+
         const auto metadata_opt = proxy.metadata();
         if (!metadata_opt.has_value())
         {
@@ -307,9 +319,20 @@ namespace sparrow_extensions
 
     fixed_shape_tensor_array::fixed_shape_tensor_array(sparrow::arrow_proxy proxy)
         : m_storage(proxy)
-        , m_metadata(fixed_shape_tensor_extension::extract_metadata(proxy))
+        , m_metadata(
+              std::make_shared<const metadata_type>(fixed_shape_tensor_extension::extract_metadata(proxy))
+          )
+    {
+        SPARROW_ASSERT_TRUE(m_metadata->is_valid());
+    }
+
+    fixed_shape_tensor_array::fixed_shape_tensor_array(
+        sparrow::fixed_sized_list_array&& storage,
+        std::shared_ptr<const metadata_type> tensor_metadata
+    )
+        : m_storage(std::move(storage))
+        , m_metadata(std::move(tensor_metadata))
     {
-        SPARROW_ASSERT_TRUE(m_metadata.is_valid());
     }
 
     fixed_shape_tensor_array::fixed_shape_tensor_array(
@@ -317,13 +340,15 @@ namespace sparrow_extensions
         sparrow::array&& flat_values,
         const metadata_type& tensor_metadata
     )
-        : m_storage(list_size, std::move(flat_values), std::vector<bool>{})
-        , m_metadata(tensor_metadata)
+        : m_storage(
+              detail::make_tensor_list(list_size, std::move(flat_values), std::vector<bool>{})
+          )
+        , m_metadata(std::make_shared<const metadata_type>(tensor_metadata))
     {
-        SPARROW_ASSERT_TRUE(m_metadata.is_valid());
-        SPARROW_ASSERT_TRUE(static_cast<std::int64_t>(list_size) == m_metadata.compute_size());
+        SPARROW_ASSERT_TRUE(m_metadata->is_valid());
+        SPARROW_ASSERT_TRUE(static_cast<std::int64_t>(list_size) == m_metadata->compute_size());
 
-        fixed_shape_tensor_extension::init(sparrow::detail::array_access::get_arrow_proxy(m_storage), m_metadata);
+        fixed_shape_tensor_extension::init(sparrow::detail::array_access::get_arrow_proxy(m_storage), *m_metadata);
     }
 
     fixed_shape_tensor_array::fixed_shape_tensor_array(
@@ -333,11 +358,13 @@ namespace sparrow_extensions
         std::string_view name,
         std::optional<std::vector<sparrow::metadata_pair>> arrow_metadata
     )
-        : m_storage(list_size, std::move(flat_values), std::vector<bool>{})
-        , m_metadata(tensor_metadata)
+        : m_storage(
+              detail::make_tensor_list(list_size, std::move(flat_values), std::vector<bool>{})
+          )
+        , m_metadata(std::make_shared<const metadata_type>(tensor_metadata))
     {
-        SPARROW_ASSERT_TRUE(m_metadata.is_valid());
-        SPARROW_ASSERT_TRUE(static_cast<std::int64_t>(list_size) == m_metadata.compute_size());
+        SPARROW_ASSERT_TRUE(m_metadata->is_valid());
+        SPARROW_ASSERT_TRUE(static_cast<std::int64_t>(list_size) == m_metadata->compute_size());
 
         auto& proxy = sparrow::detail::array_access::get_arrow_proxy(m_storage);
         proxy.set_name(name);
@@ -347,7 +374,7 @@ namespace sparrow_extensions
             proxy.set_metadata(std::make_optional(*arrow_metadata));
         }
 
-        fixed_shape_tensor_extension::init(proxy, m_metadata);
+        fixed_shape_tensor_extension::init(proxy, *m_metadata);
     }
 
     auto fixed_shape_tensor_array::size() const -> size_type
@@ -357,12 +384,12 @@ namespace sparrow_extensions
 
     auto fixed_shape_tensor_array::get_metadata() const -> const metadata_type&
     {
-        return m_metadata;
+        return *m_metadata;
     }
 
     auto fixed_shape_tensor_array::shape() const -> const std::vector<std::int64_t>&
     {
-        return m_metadata.shape;
+        return m_metadata->shape;
     }
 
     const sparrow::fixed_sized_list_array& fixed_shape_tensor_array::storage() const
@@ -406,7 +433,7 @@ namespace sparrow_extensions
 
     bool fixed_shape_tensor_array::is_valid() const
     {
-        return m_metadata.is_valid();
+        return m_metadata->is_valid();
     }
 
     auto fixed_shape_tensor_array::begin() const -> const_iterator
@@ -449,32 +476,63 @@ namespace sparrow_extensions
         return m_storage.crend();
     }
 
+    fixed_shape_tensor_array fixed_shape_tensor_array::slice(size_type start, size_type end) const
+    {
+        SPARROW_ASSERT_TRUE(start <= end && end <= size());
+        return {m_storage.slice(start, end), m_metadata};
+    }
+
+    fixed_shape_tensor_array fixed_shape_tensor_array::slice_view(size_type start, size_type end) const
+    {
+        SPARROW_ASSERT_TRUE(start <= end && end <= size());
+        return {m_storage.slice_view(start, end), m_metadata};
+    }
+
     void fixed_shape_tensor_array::finalize_construction()
     {
-        fixed_shape_tensor_extension::init(sparrow::detail::array_access::get_arrow_proxy(m_storage), m_metadata);
+        fixed_shape_tensor_extension::init(sparrow::detail::array_access::get_arrow_proxy(m_storage), *m_metadata);
     }
 
 }  // namespace sparrow_extensions
 
-namespace sparrow::detail
+namespace sparrow_extensions
 {
-    SPARROW_EXTENSIONS_API const bool fixed_shape_tensor_array_registered = []()
+    void register_fixed_shape_tensor_extension()
     {
-        auto& registry = array_registry::instance();
-
-        registry.register_extension(
-            data_type::FIXED_SIZED_LIST,
-            "arrow.fixed_shape_tensor",
-            [](arrow_proxy proxy)
+        static std::once_flag registered;
+        std::call_once(
+            registered,
+            []()
             {
-                return cloning_ptr<array_wrapper>{
-                    new array_wrapper_impl<sparrow_extensions::fixed_shape_tensor_array>(
-                        sparrow_extensions::fixed_shape_tensor_array(std::move(proxy))
-                    )
-                };
+                auto& registry = sparrow::array_registry::instance();
+
+                registry.register_extension(
+                    sparrow::data_type::FIXED_SIZED_LIST,
+                    "arrow.fixed_shape_tensor",
+                    [](sparrow::arrow_proxy proxy)
+                    {
+                        SPARROW_EXTENSIONS_ALLOCATION_SITE("fixed_shape_tensor_array registry factory");
+                        return sparrow::cloning_ptr<sparrow::array_wrapper>{
+                            new sparrow::array_wrapper_impl<sparrow_extensions::fixed_shape_tensor_array>(
+                                sparrow_extensions::fixed_shape_tensor_array(std::move(proxy))
+                            )
+                        };
+                    }
+                );
             }
         );
+    }
+}
 
+namespace sparrow::detail
+{
+#if defined(SPARROW_EXTENSIONS_DISABLE_AUTO_REGISTRATION)
+    SPARROW_EXTENSIONS_API const bool fixed_shape_tensor_array_registered = false;
+#else
+    SPARROW_EXTENSIONS_API const bool fixed_shape_tensor_array_registered = []()
+    {
+        sparrow_extensions::register_fixed_shape_tensor_extension();
         return true;
     }();
+#endif
 }
@@ -14,54 +14,81 @@
 
 #include "sparrow_extensions/json_array.hpp"
 
+#include <mutex>
+
 #include <sparrow/layout/array_registry.hpp>
 
+#include "sparrow_extensions/allocation_tracker.hpp"
 #include "sparrow_extensions/config/config.hpp"
+#include "sparrow_extensions/registration.hpp"
 
-namespace sparrow_extensions::detail
+namespace sparrow_extensions
 {
-    SPARROW_EXTENSIONS_API const bool json_arrays_registered = []()
+    void register_json_extension()
     {
-        auto& registry = sparrow::array_registry::instance();
+        static std::once_flag registered;
+        std::call_once(
+            registered,
+            []()
+            {
+                auto& registry = sparrow::array_registry::instance();
 
-        constexpr std::string_view extension_name = "arrow.json";
+                constexpr std::string_view extension_name = "arrow.json";
 
-        // Register json_array (STRING base type)
-        registry.register_extension(
-            sparrow::data_type::STRING,
-            extension_name,
-            [](sparrow::arrow_proxy proxy)
-            {
-                return sparrow::cloning_ptr<sparrow::array_wrapper>{
-                    new sparrow::array_wrapper_impl<json_array>(json_array(std::move(proxy)))
-                };
-            }
-        );
+                // Register json_array (STRING base type)
+                registry.register_extension(
+                    sparrow::data_type::STRING,
+                    extension_name,
+                    [](sparrow::arrow_proxy proxy)
+                    {
+                        SPARROW_EXTENSIONS_ALLOCATION_SITE("json_array registry factory");
+                        return sparrow::cloning_ptr<sparrow::array_wrapper>{
+                            new sparrow::array_wrapper_impl<json_array>(json_array(std::move(proxy)))
+                        };
+                    }
+                );
 
-        // Register big_json_array (LARGE_STRING base type)
-        registry.register_extension(
-            sparrow::data_type::LARGE_STRING,
-            extension_name,
-            [](sparrow::arrow_proxy proxy)
-            {
-                return sparrow::cloning_ptr<sparrow::array_wrapper>{
-                    new sparrow::array_wrapper_impl<big_json_array>(big_json_array(std::move(proxy)))
-                };
-            }
-        );
+                // Register big_json_array (LARGE_STRING base type)
+                registry.register_extension(
+                    sparrow::data_type::LARGE_STRING,
+                    extension_name,
+                    [](sparrow::arrow_proxy proxy)
+                    {
+                        SPARROW_EXTENSIONS_ALLOCATION_SITE("big_json_array registry factory");
+                        return sparrow::cloning_ptr<sparrow::array_wrapper>{
+                            new sparrow::array_wrapper_impl<big_json_array>(big_json_array(std::move(proxy)))
+                        };
+                    }
+                );
 
-        // Register json_view_array (STRING_VIEW base type)
-        registry.register_extension(
-            sparrow::data_type::STRING_VIEW,
-            extension_name,
-            [](sparrow::arrow_proxy proxy)
-            {
-                return sparrow::cloning_ptr<sparrow::array_wrapper>{
-                    new sparrow::array_wrapper_impl<json_view_array>(json_view_array(std::move(proxy)))
-                };
+                // Register json_view_array (STRING_VIEW base type)
+                registry.register_extension(
+                    sparrow::data_type::STRING_VIEW,
+                    extension_name,
+                    [](sparrow::arrow_proxy proxy)
+                    {
+                        SPARROW_EXTENSIONS_ALLOCATION_SITE("json_view_array registry factory");
+                        return sparrow::cloning_ptr<sparrow::array_wrapper>{
+                            new sparrow::array_wrapper_impl<json_view_array>(
+                                json_view_array(std::move(proxy))
+                            )
+                        };
+                    }
+                );
             }
         );
+    }
+}
 
+namespace sparrow_extensions::detail
+{
+#if defined(SPARROW_EXTENSIONS_DISABLE_AUTO_REGISTRATION)
+    SPARROW_EXTENSIONS_API const bool json_arrays_registered = false;
+#else
+    SPARROW_EXTENSIONS_API const bool json_arrays_registered = []()
+    {
+        sparrow_extensions::register_json_extension();
         return true;
     }();
+#endif
 }
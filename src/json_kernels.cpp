@@ -0,0 +1,2757 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sparrow_extensions/json_kernels.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <simdjson.h>
+
+#include "sparrow/buffer/u8_buffer.hpp"
+#include "sparrow/layout/array_access.hpp"
+#include "sparrow/list_array.hpp"
+#include "sparrow/null_array.hpp"
+#include "sparrow/primitive_array.hpp"
+#include "sparrow/variable_size_binary_array.hpp"
+#include "sparrow/utils/contracts.hpp"
+
+#include "sparrow_extensions/json_parser_pool.hpp"
+#include "sparrow_extensions/parallel.hpp"
+
+namespace sparrow_extensions
+{
+    namespace
+    {
+        // Minimum number of JSON values parsed by each thread
+        constexpr std::size_t json_parse_grain_size = 1024;
+
+        // Minimum number of rows serialised by each thread
+        constexpr std::size_t json_serialize_grain_size = 1024;
+
+        // Size of a view of a StringView array, and longest value stored inline in it
+        constexpr std::size_t string_view_size = 16;
+        constexpr std::int32_t max_inline_size = 12;
+
+        // Raw buffers of the storage of a JSON array
+        struct json_buffers
+        {
+            const std::uint8_t* validity = nullptr;
+            std::int64_t offset = 0;
+            std::size_t size = 0;
+            // Offsets and characters of a String or LargeString storage, the offsets are
+            // 64-bit if large_offsets is true, 32-bit otherwise
+            const void* offsets = nullptr;
+            bool large_offsets = false;
+            const char* data = nullptr;
+            // Views and data buffers of a StringView storage, views is null otherwise
+            const std::uint8_t* views = nullptr;
+            std::vector<std::span<const char>> view_buffers;
+        };
+
+        // Characters of a JSON value, and number of bytes that can be read from its first one
+        struct json_row
+        {
+            std::string_view value;
+            std::size_t capacity = 0;
+        };
+
+        json_buffers get_json_buffers(const sparrow::arrow_proxy& proxy)
+        {
+            const ArrowArray& array = proxy.array();
+            const std::string_view format = proxy.schema().format;
+
+            json_buffers result;
+            result.validity = static_cast<const std::uint8_t*>(array.buffers[0]);
+            result.offset = array.offset;
+            result.size = static_cast<std::size_t>(array.length);
+            if (format == "vu")
+            {
+                // The last buffer holds the sizes of the data buffers
+                result.views = static_cast<const std::uint8_t*>(array.buffers[1]);
+                const auto data_buffer_count = static_cast<std::size_t>(array.n_buffers - 3);
+                const auto* buffer_sizes = static_cast<const std::int64_t*>(
+                    array.buffers[array.n_buffers - 1]
+                );
+                result.view_buffers.reserve(data_buffer_count);
+                for (std::size_t b = 0; b < data_buffer_count; ++b)
+                {
+                    result.view_buffers.emplace_back(
+                        static_cast<const char*>(array.buffers[b + 2]),
+                        static_cast<std::size_t>(buffer_sizes[b])
+                    );
+                }
+            }
+            else
+            {
+                result.offsets = array.buffers[1];
+                result.large_offsets = format == "U";
+                result.data = static_cast<const char*>(array.buffers[2]);
+            }
+            return result;
+        }
+
+        template <class A>
+        json_buffers get_json_buffers(const A& json_values)
+        {
+            return get_json_buffers(sparrow::detail::array_access::get_arrow_proxy(json_values));
+        }
+
+        template <class O>
+        std::int64_t string_offset(const json_buffers& buffers, std::int64_t position)
+        {
+            return static_cast<const O*>(buffers.offsets)[position];
+        }
+
+        std::int64_t string_offset(const json_buffers& buffers, std::int64_t position)
+        {
+            return buffers.large_offsets ? string_offset<std::int64_t>(buffers, position)
+                                         : string_offset<std::int32_t>(buffers, position);
+        }
+
+        bool is_valid_row(const json_buffers& buffers, std::size_t i)
+        {
+            if (buffers.validity == nullptr)
+            {
+                return true;
+            }
+            const auto bit = static_cast<std::size_t>(buffers.offset) + i;
+            return ((buffers.validity[bit / 8] >> (bit % 8)) & 1) != 0;
+        }
+
+        json_row get_row(const json_buffers& buffers, std::size_t i)
+        {
+            const auto position = buffers.offset + static_cast<std::int64_t>(i);
+            if (buffers.views != nullptr)
+            {
+                const auto* view = buffers.views + static_cast<std::size_t>(position) * string_view_size;
+                std::int32_t length = 0;
+                std::memcpy(&length, view, sizeof(length));
+                if (length <= max_inline_size)
+                {
+                    const auto* inline_data = reinterpret_cast<const char*>(view + sizeof(length));
+                    return {
+                        {inline_data, static_cast<std::size_t>(length)},
+                        string_view_size - sizeof(length)
+                    };
+                }
+                std::int32_t buffer_index = 0;
+                std::int32_t buffer_offset = 0;
+                std::memcpy(&buffer_index, view + 8, sizeof(buffer_index));
+                std::memcpy(&buffer_offset, view + 12, sizeof(buffer_offset));
+                const auto data_buffer = buffers.view_buffers[static_cast<std::size_t>(buffer_index)];
+                return {
+                    {data_buffer.data() + buffer_offset, static_cast<std::size_t>(length)},
+                    data_buffer.size() - static_cast<std::size_t>(buffer_offset)
+                };
+            }
+            const auto begin = string_offset(buffers, position);
+            const auto end = string_offset(buffers, position + 1);
+            const auto last = buffers.offset + static_cast<std::int64_t>(buffers.size);
+            const auto data_end = string_offset(buffers, last);
+            return {
+                {buffers.data + begin, static_cast<std::size_t>(end - begin)},
+                static_cast<std::size_t>(data_end - begin)
+            };
+        }
+
+        // Characters of the JSON values followed by the padding simdjson requires: the buffer
+        // holding a value when it extends far enough past it, a reused padded copy otherwise
+        class padded_input
+        {
+        public:
+
+            simdjson::padded_string_view operator()(const json_row& row)
+            {
+                const auto& value = row.value;
+                if (row.capacity >= value.size() + simdjson::SIMDJSON_PADDING)
+                {
+                    return {value.data(), value.size(), row.capacity};
+                }
+                m_scratch.resize(std::max(m_scratch.size(), value.size() + simdjson::SIMDJSON_PADDING));
+                std::ranges::copy(value, m_scratch.begin());
+                return {m_scratch.data(), value.size(), m_scratch.size()};
+            }
+
+        private:
+
+            std::vector<char> m_scratch;
+        };
+
+        // DOM parser drawn from the pool of the library, which checks the whole document
+        class dom_parser
+        {
+        public:
+
+            simdjson::simdjson_result<simdjson::dom::element> parse(const json_row& row)
+            {
+                const auto input = m_input(row);
+                return m_parser->parse(input.data(), input.size(), false);
+            }
+
+            simdjson::error_code validate(const json_row& row)
+            {
+                return parse(row).error();
+            }
+
+        private:
+
+            using parser_lease = detail::json_parser_pool<simdjson::dom::parser>::lease;
+
+            padded_input m_input;
+            parser_lease m_parser = detail::dom_parser_pool().acquire();
+        };
+
+        std::optional<json_validation_error> validate_json_buffers(const json_buffers& buffers)
+        {
+            // Rows are checked in parallel, each thread stops past the first invalid row found so far
+            std::atomic<std::size_t> first_invalid_row = buffers.size;
+            detail::parallel_for(
+                buffers.size,
+                json_parse_grain_size,
+                [&](std::size_t begin, std::size_t end)
+                {
+                    const auto already_found = [&first_invalid_row](std::size_t i)
+                    {
+                        return i >= first_invalid_row.load(std::memory_order_relaxed);
+                    };
+                    dom_parser parser;
+                    for (std::size_t i = begin; i < end && !already_found(i); ++i)
+                    {
+                        if (is_valid_row(buffers, i)
+                            && parser.validate(get_row(buffers, i)) != simdjson::SUCCESS)
+                        {
+                            auto current = first_invalid_row.load(std::memory_order_relaxed);
+                            while (i < current && !first_invalid_row.compare_exchange_weak(current, i))
+                            {
+                            }
+                            return;
+                        }
+                    }
+                }
+            );
+
+            const std::size_t row = first_invalid_row.load();
+            if (row == buffers.size)
+            {
+                return std::nullopt;
+            }
+            dom_parser parser;
+            const auto error = parser.validate(get_row(buffers, row));
+            return json_validation_error{row, std::string(simdjson::error_message(error))};
+        }
+
+        // Flags of the rows, null for the null values
+        bool8_array make_flag_array(const json_buffers& buffers, sparrow::u8_buffer<bool>&& flag_values)
+        {
+            if (buffers.validity == nullptr)
+            {
+                return bool8_array(std::move(flag_values), buffers.size);
+            }
+            std::vector<bool> validity(buffers.size);
+            for (std::size_t i = 0; i < buffers.size; ++i)
+            {
+                validity[i] = is_valid_row(buffers, i);
+            }
+            return bool8_array(std::move(flag_values), buffers.size, std::move(validity));
+        }
+
+        bool8_array is_valid_json_buffers(const json_buffers& buffers)
+        {
+            sparrow::u8_buffer<bool> flag_values(buffers.size, false);
+            bool* flags = flag_values.data();
+            detail::parallel_for(
+                buffers.size,
+                json_parse_grain_size,
+                [&](std::size_t begin, std::size_t end)
+                {
+                    dom_parser parser;
+                    for (std::size_t i = begin; i < end; ++i)
+                    {
+                        flags[i] = is_valid_row(buffers, i)
+                                   && parser.validate(get_row(buffers, i)) == simdjson::SUCCESS;
+                    }
+                }
+            );
+            return make_flag_array(buffers, std::move(flag_values));
+        }
+
+        // Checks the syntax of a JSON pointer (RFC 6901)
+        void check_json_pointer(std::string_view pointer, std::string_view function)
+        {
+            bool valid = pointer.empty() || pointer.front() == '/';
+            for (std::size_t i = 0; valid && i < pointer.size(); ++i)
+            {
+                if (pointer[i] == '~')
+                {
+                    valid = i + 1 < pointer.size() && (pointer[i + 1] == '0' || pointer[i + 1] == '1');
+                }
+            }
+            if (!valid)
+            {
+                throw std::runtime_error(
+                    std::string(function) + ": invalid JSON pointer '" + std::string(pointer) + "'"
+                );
+            }
+        }
+
+        // Characters of the strings extracted from a block of rows
+        struct string_block
+        {
+            std::string characters;
+            // End of the string of each row of the block in characters
+            std::vector<std::int64_t> ends;
+        };
+
+        // Values of a field, written by the threads at the rows they process; only the
+        // buffer of the type of the field is allocated
+        struct extracted_column
+        {
+            std::vector<std::uint8_t> found;
+            sparrow::u8_buffer<std::int64_t> integers{0, std::int64_t{0}};
+            sparrow::u8_buffer<double> doubles{0, 0.0};
+            sparrow::u8_buffer<bool> booleans{0, false};
+            std::vector<string_block> string_blocks;
+        };
+
+        extracted_column
+        make_extracted_column(json_field_type type, std::size_t row_count, std::size_t block_count)
+        {
+            extracted_column result;
+            result.found.resize(row_count);
+            switch (type)
+            {
+                case json_field_type::int64:
+                    result.integers = sparrow::u8_buffer<std::int64_t>(row_count, std::int64_t{0});
+                    break;
+                case json_field_type::float64:
+                    result.doubles = sparrow::u8_buffer<double>(row_count, 0.0);
+                    break;
+                case json_field_type::boolean:
+                    result.booleans = sparrow::u8_buffer<bool>(row_count, false);
+                    break;
+                case json_field_type::string:
+                    result.string_blocks.resize(block_count);
+                    break;
+            }
+            return result;
+        }
+
+        // Reads the value of field in document into row i of column, returns false if it is
+        // missing or not of the type of the field
+        bool read_field(
+            simdjson::ondemand::document& document,
+            const json_field& field,
+            extracted_column& column,
+            std::size_t i,
+            std::size_t block
+        )
+        {
+            simdjson::ondemand::value value;
+            if (document.at_pointer(field.pointer).get(value) != simdjson::SUCCESS)
+            {
+                return false;
+            }
+            switch (field.type)
+            {
+                case json_field_type::int64:
+                    return value.get_int64().get(column.integers.data()[i]) == simdjson::SUCCESS;
+                case json_field_type::float64:
+                    return value.get_double().get(column.doubles.data()[i]) == simdjson::SUCCESS;
+                case json_field_type::boolean:
+                    return value.get_bool().get(column.booleans.data()[i]) == simdjson::SUCCESS;
+                case json_field_type::string:
+                {
+                    std::string_view text;
+                    if (value.get_string().get(text) != simdjson::SUCCESS)
+                    {
+                        return false;
+                    }
+                    column.string_blocks[block].characters.append(text);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Writes row i of column, null if the document could not be parsed
+        void extract_field(
+            simdjson::ondemand::document* document,
+            const json_field& field,
+            extracted_column& column,
+            std::size_t i,
+            std::size_t block
+        )
+        {
+            column.found[i] = document != nullptr && read_field(*document, field, column, i, block);
+            if (field.type == json_field_type::string)
+            {
+                auto& strings = column.string_blocks[block];
+                strings.ends.push_back(static_cast<std::int64_t>(strings.characters.size()));
+            }
+        }
+
+        template <bool BIG>
+        sparrow::array make_string_column(std::vector<string_block>&& blocks, std::vector<bool>&& validity)
+        {
+            using offset_type = std::conditional_t<BIG, std::int64_t, std::int32_t>;
+            using string_type = std::conditional_t<BIG, sparrow::big_string_array, sparrow::string_array>;
+            std::size_t character_count = 0;
+            for (const auto& block : blocks)
+            {
+                character_count += block.characters.size();
+            }
+
+            sparrow::u8_buffer<char> characters(character_count, '\0');
+            sparrow::u8_buffer<offset_type> offsets(validity.size() + 1, offset_type{0});
+            offset_type* offsets_data = offsets.data();
+            std::int64_t block_offset = 0;
+            std::size_t row = 0;
+            for (const auto& block : blocks)
+            {
+                std::ranges::copy(block.characters, characters.data() + block_offset);
+                for (const auto end : block.ends)
+                {
+                    offsets_data[++row] = static_cast<offset_type>(block_offset + end);
+                }
+                block_offset += static_cast<std::int64_t>(block.characters.size());
+            }
+            return sparrow::array(
+                string_type(std::move(characters), std::move(offsets), std::move(validity))
+            );
+        }
+
+        sparrow::array make_column(json_field_type type, extracted_column&& column)
+        {
+            const std::size_t size = column.found.size();
+            std::vector<bool> validity(column.found.begin(), column.found.end());
+            switch (type)
+            {
+                case json_field_type::int64:
+                    return sparrow::array(sparrow::primitive_array<std::int64_t>(
+                        std::move(column.integers),
+                        size,
+                        std::move(validity)
+                    ));
+                case json_field_type::float64:
+                    return sparrow::array(
+                        sparrow::primitive_array<double>(std::move(column.doubles), size, std::move(validity))
+                    );
+                case json_field_type::boolean:
+                    return sparrow::array(bool8_array(std::move(column.booleans), size, std::move(validity)));
+                case json_field_type::string:
+                    break;
+            }
+            std::size_t character_count = 0;
+            for (const auto& block : column.string_blocks)
+            {
+                character_count += block.characters.size();
+            }
+            if (character_count > static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max()))
+            {
+                return make_string_column<true>(std::move(column.string_blocks), std::move(validity));
+            }
+            return make_string_column<false>(std::move(column.string_blocks), std::move(validity));
+        }
+
+        std::vector<sparrow::array>
+        extract_json_buffers(const json_buffers& buffers, std::span<const json_field> fields)
+        {
+            for (const auto& field : fields)
+            {
+                check_json_pointer(field.pointer, "extract_json_fields");
+            }
+
+            // The rows are processed by blocks, so that the strings of a block are appended
+            // to a buffer of their own and concatenated at the end in row order
+            const std::size_t row_count = buffers.size;
+            const std::size_t block_count = (row_count + json_parse_grain_size - 1) / json_parse_grain_size;
+            std::vector<extracted_column> columns;
+            columns.reserve(fields.size());
+            for (const auto& field : fields)
+            {
+                columns.push_back(make_extracted_column(field.type, row_count, block_count));
+            }
+
+            detail::parallel_for(
+                block_count,
+                1,
+                [&](std::size_t first_block, std::size_t last_block)
+                {
+                    padded_input input;
+                    auto parser = detail::ondemand_parser_pool().acquire();
+                    for (std::size_t block = first_block; block < last_block; ++block)
+                    {
+                        const std::size_t begin = block * json_parse_grain_size;
+                        const std::size_t end = std::min(begin + json_parse_grain_size, row_count);
+                        for (std::size_t i = begin; i < end; ++i)
+                        {
+                            // The on-demand parser only reads the document up to the fields
+                            simdjson::ondemand::document document;
+                            const bool parsed = is_valid_row(buffers, i)
+                                                && parser->iterate(input(get_row(buffers, i))).get(document)
+                                                       == simdjson::SUCCESS;
+                            for (std::size_t f = 0; f < fields.size(); ++f)
+                            {
+                                extract_field(parsed ? &document : nullptr, fields[f], columns[f], i, block);
+                            }
+                        }
+                    }
+                }
+            );
+
+            std::vector<sparrow::array> result;
+            result.reserve(fields.size());
+            for (std::size_t f = 0; f < fields.size(); ++f)
+            {
+                result.push_back(make_column(fields[f].type, std::move(columns[f])));
+            }
+            return result;
+        }
+
+        // Appends the entries of a value to the tape of a block
+        void append_tape_entries(detail::json_tape_block& block, simdjson::dom::element element);
+
+        void append_tape_string(detail::json_tape_block& block, std::string_view text)
+        {
+            const auto length = static_cast<std::uint32_t>(text.size());
+            block.tape.push_back({block.characters.size(), length, detail::json_tape_type::string});
+            block.characters.append(text);
+        }
+
+        void append_tape_entries(detail::json_tape_block& block, simdjson::dom::element element)
+        {
+            using detail::json_tape_type;
+            if (element.type() == simdjson::dom::element_type::STRING)
+            {
+                append_tape_string(block, element.get_string().value_unsafe());
+                return;
+            }
+
+            // The entry of an array or an object is written once its items are appended
+            const std::size_t position = block.tape.size();
+            block.tape.emplace_back();
+            detail::json_tape_entry entry;
+            switch (element.type())
+            {
+                case simdjson::dom::element_type::NULL_VALUE:
+                case simdjson::dom::element_type::STRING:
+                    break;
+                case simdjson::dom::element_type::BOOL:
+                    entry = {element.get_bool().value_unsafe() ? 1U : 0U, 0, json_tape_type::boolean};
+                    break;
+                case simdjson::dom::element_type::INT64:
+                {
+                    const std::int64_t value = element.get_int64().value_unsafe();
+                    entry = {std::bit_cast<std::uint64_t>(value), 0, json_tape_type::int64};
+                    break;
+                }
+                case simdjson::dom::element_type::UINT64:
+                    entry = {element.get_uint64().value_unsafe(), 0, json_tape_type::uint64};
+                    break;
+                case simdjson::dom::element_type::DOUBLE:
+                {
+                    const double value = element.get_double().value_unsafe();
+                    entry = {std::bit_cast<std::uint64_t>(value), 0, json_tape_type::float64};
+                    break;
+                }
+                case simdjson::dom::element_type::ARRAY:
+                {
+                    std::uint32_t count = 0;
+                    for (const simdjson::dom::element value : element.get_array().value_unsafe())
+                    {
+                        append_tape_entries(block, value);
+                        ++count;
+                    }
+                    entry = {block.tape.size(), count, json_tape_type::array};
+                    break;
+                }
+                case simdjson::dom::element_type::OBJECT:
+                {
+                    std::uint32_t count = 0;
+                    for (const auto [key, value] : element.get_object().value_unsafe())
+                    {
+                        append_tape_string(block, key);
+                        append_tape_entries(block, value);
+                        ++count;
+                    }
+                    entry = {block.tape.size(), count, json_tape_type::object};
+                    break;
+                }
+            }
+            block.tape[position] = entry;
+        }
+
+        std::vector<detail::json_tape_block> index_json_buffers(const json_buffers& buffers)
+        {
+            const std::size_t row_count = buffers.size;
+            const std::size_t block_count = (row_count + json_parse_grain_size - 1) / json_parse_grain_size;
+            std::vector<detail::json_tape_block> blocks(block_count);
+            detail::parallel_for(
+                block_count,
+                1,
+                [&](std::size_t first_block, std::size_t last_block)
+                {
+                    dom_parser parser;
+                    for (std::size_t b = first_block; b < last_block; ++b)
+                    {
+                        auto& block = blocks[b];
+                        const std::size_t begin = b * json_parse_grain_size;
+                        const std::size_t end = std::min(begin + json_parse_grain_size, row_count);
+                        block.roots.reserve(end - begin);
+                        for (std::size_t i = begin; i < end; ++i)
+                        {
+                            simdjson::dom::element document;
+                            if (is_valid_row(buffers, i)
+                                && parser.parse(get_row(buffers, i)).get(document) == simdjson::SUCCESS)
+                            {
+                                block.roots.push_back(block.tape.size());
+                                append_tape_entries(block, document);
+                            }
+                            else
+                            {
+                                block.roots.push_back(detail::json_tape_block::no_document);
+                            }
+                        }
+                        block.tape.shrink_to_fit();
+                        block.characters.shrink_to_fit();
+                    }
+                }
+            );
+            return blocks;
+        }
+
+        // Reference tokens of a JSON pointer, unescaped
+        std::vector<std::string> get_pointer_tokens(std::string_view pointer, std::string_view function)
+        {
+            check_json_pointer(pointer, function);
+            std::vector<std::string> result;
+            for (std::size_t begin = 1; begin <= pointer.size();)
+            {
+                const std::size_t end = std::min(pointer.find('/', begin), pointer.size());
+                std::string token;
+                for (std::size_t k = begin; k < end; ++k)
+                {
+                    if (pointer[k] == '~')
+                    {
+                        token.push_back(pointer[++k] == '0' ? '~' : '/');
+                    }
+                    else
+                    {
+                        token.push_back(pointer[k]);
+                    }
+                }
+                result.push_back(std::move(token));
+                begin = end + 1;
+            }
+            return result;
+        }
+
+        // Position past the entries of the value at a position of the tape
+        std::size_t skip_tape_value(const detail::json_tape_block& block, std::size_t position)
+        {
+            const auto& entry = block.tape[position];
+            const bool is_container = entry.type == detail::json_tape_type::array
+                                      || entry.type == detail::json_tape_type::object;
+            return is_container ? static_cast<std::size_t>(entry.payload) : position + 1;
+        }
+
+        std::string_view
+        get_tape_string(const detail::json_tape_block& block, const detail::json_tape_entry& entry)
+        {
+            const auto begin = static_cast<std::size_t>(entry.payload);
+            return std::string_view(block.characters).substr(begin, entry.count);
+        }
+
+        // Position of the value at a JSON pointer in the tape, no_document if it is missing
+        std::size_t find_tape_value(
+            const detail::json_tape_block& block,
+            std::size_t position,
+            const std::vector<std::string>& tokens
+        )
+        {
+            constexpr std::size_t missing = detail::json_tape_block::no_document;
+            for (const auto& token : tokens)
+            {
+                const auto& entry = block.tape[position];
+                std::size_t item = position + 1;
+                if (entry.type == detail::json_tape_type::object)
+                {
+                    std::uint32_t k = 0;
+                    while (k < entry.count && get_tape_string(block, block.tape[item]) != token)
+                    {
+                        item = skip_tape_value(block, item + 1);
+                        ++k;
+                    }
+                    if (k == entry.count)
+                    {
+                        return missing;
+                    }
+                    position = item + 1;
+                }
+                else if (entry.type == detail::json_tape_type::array)
+                {
+                    // Array indices are decimal numbers without leading zeros
+                    std::uint32_t index = 0;
+                    const auto* last = token.data() + token.size();
+                    const auto result = std::from_chars(token.data(), last, index);
+                    const bool leading_zero = token.size() > 1 && token[0] == '0';
+                    const bool is_index = result.ec == std::errc() && result.ptr == last && !leading_zero;
+                    if (!is_index || index >= entry.count)
+                    {
+                        return missing;
+                    }
+                    for (std::uint32_t k = 0; k < index; ++k)
+                    {
+                        item = skip_tape_value(block, item);
+                    }
+                    position = item;
+                }
+                else
+                {
+                    return missing;
+                }
+            }
+            return position;
+        }
+
+        // Reads the value of an entry of the tape into row i of column, with the conversions
+        // of read_field(), returns false if it is not of the type of the field
+        bool read_tape_value(
+            const detail::json_tape_block& block,
+            const detail::json_tape_entry& entry,
+            json_field_type type,
+            extracted_column& column,
+            std::size_t i,
+            std::size_t block_index
+        )
+        {
+            using detail::json_tape_type;
+            switch (type)
+            {
+                case json_field_type::int64:
+                    if (entry.type != json_tape_type::int64)
+                    {
+                        return false;
+                    }
+                    column.integers.data()[i] = std::bit_cast<std::int64_t>(entry.payload);
+                    return true;
+                case json_field_type::float64:
+                    switch (entry.type)
+                    {
+                        case json_tape_type::int64:
+                        {
+                            const auto value = std::bit_cast<std::int64_t>(entry.payload);
+                            column.doubles.data()[i] = static_cast<double>(value);
+                            return true;
+                        }
+                        case json_tape_type::uint64:
+                            column.doubles.data()[i] = static_cast<double>(entry.payload);
+                            return true;
+                        case json_tape_type::float64:
+                            column.doubles.data()[i] = std::bit_cast<double>(entry.payload);
+                            return true;
+                        default:
+                            return false;
+                    }
+                case json_field_type::boolean:
+                    if (entry.type != json_tape_type::boolean)
+                    {
+                        return false;
+                    }
+                    column.booleans.data()[i] = entry.payload != 0;
+                    return true;
+                case json_field_type::string:
+                    if (entry.type != json_tape_type::string)
+                    {
+                        return false;
+                    }
+                    column.string_blocks[block_index].characters.append(get_tape_string(block, entry));
+                    return true;
+            }
+            return false;
+        }
+
+        // Writes row i of column from the r-th row of a block, null if it is not a document
+        void extract_indexed_field(
+            const detail::json_tape_block& block,
+            std::size_t r,
+            const std::vector<std::string>& tokens,
+            json_field_type type,
+            extracted_column& column,
+            std::size_t i,
+            std::size_t block_index
+        )
+        {
+            constexpr std::size_t missing = detail::json_tape_block::no_document;
+            const std::size_t root = block.roots[r];
+            const std::size_t position = root == missing ? missing : find_tape_value(block, root, tokens);
+            column.found[i] = position != missing
+                              && read_tape_value(block, block.tape[position], type, column, i, block_index);
+            if (type == json_field_type::string)
+            {
+                auto& strings = column.string_blocks[block_index];
+                strings.ends.push_back(static_cast<std::int64_t>(strings.characters.size()));
+            }
+        }
+
+        std::vector<sparrow::array> extract_indexed_fields(
+            const std::vector<detail::json_tape_block>& blocks,
+            std::size_t row_count,
+            std::span<const json_field> fields
+        )
+        {
+            std::vector<std::vector<std::string>> field_tokens;
+            field_tokens.reserve(fields.size());
+            std::vector<extracted_column> columns;
+            columns.reserve(fields.size());
+            for (const auto& field : fields)
+            {
+                field_tokens.push_back(get_pointer_tokens(field.pointer, "extract_json_fields"));
+                columns.push_back(make_extracted_column(field.type, row_count, blocks.size()));
+            }
+
+            detail::parallel_for(
+                blocks.size(),
+                1,
+                [&](std::size_t first_block, std::size_t last_block)
+                {
+                    for (std::size_t b = first_block; b < last_block; ++b)
+                    {
+                        const auto& block = blocks[b];
+                        for (std::size_t r = 0; r < block.roots.size(); ++r)
+                        {
+                            const std::size_t i = b * json_parse_grain_size + r;
+                            for (std::size_t f = 0; f < fields.size(); ++f)
+                            {
+                                const auto type = fields[f].type;
+                                extract_indexed_field(block, r, field_tokens[f], type, columns[f], i, b);
+                            }
+                        }
+                    }
+                }
+            );
+
+            std::vector<sparrow::array> result;
+            result.reserve(fields.size());
+            for (std::size_t f = 0; f < fields.size(); ++f)
+            {
+                result.push_back(make_column(fields[f].type, std::move(columns[f])));
+            }
+            return result;
+        }
+
+        // Scalar of a JSON value, the strings referring to the document
+        using json_scalar_view = std::variant<std::nullptr_t, bool, std::int64_t, double, std::string_view>;
+
+        // Texts one of which a row must contain to match a predicate
+        using json_needles = std::vector<std::string>;
+
+        void check_json_predicate(const json_predicate& predicate)
+        {
+            check_json_pointer(predicate.pointer, "filter_json");
+            const bool has_single_value = predicate.values.size() == 1;
+            const bool valid_values = [&]
+            {
+                switch (predicate.type)
+                {
+                    case json_predicate_type::equals:
+                        return has_single_value;
+                    case json_predicate_type::prefix:
+                        return has_single_value
+                               && std::holds_alternative<std::string>(predicate.values.front());
+                    default:
+                        return true;
+                }
+            }();
+            if (!valid_values)
+            {
+                throw std::runtime_error(
+                    "filter_json: invalid values for the predicate on '" + predicate.pointer + "'"
+                );
+            }
+        }
+
+        // Quoted text of a JSON string, empty if the string needs an escape sequence
+        std::optional<std::string> get_string_literal(std::string_view text, bool closed)
+        {
+            const bool needs_escape = std::ranges::any_of(
+                text,
+                [](char c)
+                {
+                    return c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20;
+                }
+            );
+            if (needs_escape)
+            {
+                return std::nullopt;
+            }
+            std::string result = "\"" + std::string(text);
+            if (closed)
+            {
+                result.push_back('"');
+            }
+            return result;
+        }
+
+        // Text of a scalar in a JSON document, empty for the numbers which can be written
+        // in several ways
+        std::optional<std::string> get_scalar_literal(const json_scalar& value)
+        {
+            if (const auto* text = std::get_if<std::string>(&value))
+            {
+                return get_string_literal(*text, true);
+            }
+            if (const auto* boolean = std::get_if<bool>(&value))
+            {
+                return std::string(*boolean ? "true" : "false");
+            }
+            if (std::holds_alternative<std::nullptr_t>(value))
+            {
+                return std::string("null");
+            }
+            return std::nullopt;
+        }
+
+        bool is_array_index(std::string_view token)
+        {
+            return !token.empty() && std::ranges::all_of(token, [](char c) { return c >= '0' && c <= '9'; });
+        }
+
+        // Needles of a predicate: its last key, and its possible values when they can only be
+        // written one way
+        std::vector<json_needles> get_predicate_needles(const json_predicate& predicate)
+        {
+            std::vector<json_needles> result;
+            const auto tokens = get_pointer_tokens(predicate.pointer, "filter_json");
+            if (!tokens.empty() && !is_array_index(tokens.back()))
+            {
+                if (auto key = get_string_literal(tokens.back(), true); key.has_value())
+                {
+                    result.push_back({std::move(*key)});
+                }
+            }
+            switch (predicate.type)
+            {
+                case json_predicate_type::equals:
+                case json_predicate_type::in_set:
+                {
+                    json_needles literals;
+                    for (const auto& value : predicate.values)
+                    {
+                        auto literal = get_scalar_literal(value);
+                        if (!literal.has_value())
+                        {
+                            return result;
+                        }
+                        literals.push_back(std::move(*literal));
+                    }
+                    result.push_back(std::move(literals));
+                    break;
+                }
+                case json_predicate_type::prefix:
+                {
+                    const auto& prefix = std::get<std::string>(predicate.values.front());
+                    if (auto literal = get_string_literal(prefix, false); literal.has_value())
+                    {
+                        result.push_back({std::move(*literal)});
+                    }
+                    break;
+                }
+                case json_predicate_type::exists:
+                case json_predicate_type::range:
+                    break;
+            }
+            return result;
+        }
+
+        // Checks that a value contains a needle of each group, or an escape sequence that
+        // could spell one differently. Most rows of a selective filter stop here, after a few
+        // string_view::find over their text, without reaching the parser
+        bool may_match(std::string_view value, const std::vector<json_needles>& needle_groups)
+        {
+            const auto contains = [value](const std::string& needle)
+            {
+                return value.find(needle) != std::string_view::npos;
+            };
+            const bool found = std::ranges::all_of(
+                needle_groups,
+                [&contains](const json_needles& needles)
+                {
+                    return std::ranges::any_of(needles, contains);
+                }
+            );
+            return found || value.find('\\') != std::string_view::npos;
+        }
+
+        // Scalar of a value, empty for an array or an object
+        std::optional<json_scalar_view> read_scalar(simdjson::ondemand::value& value)
+        {
+            simdjson::ondemand::json_type type;
+            if (value.type().get(type) != simdjson::SUCCESS)
+            {
+                return std::nullopt;
+            }
+            switch (type)
+            {
+                case simdjson::ondemand::json_type::null:
+                {
+                    bool is_null = false;
+                    if (value.is_null().get(is_null) == simdjson::SUCCESS && is_null)
+                    {
+                        return json_scalar_view{nullptr};
+                    }
+                    break;
+                }
+                case simdjson::ondemand::json_type::boolean:
+                {
+                    bool boolean = false;
+                    if (value.get_bool().get(boolean) == simdjson::SUCCESS)
+                    {
+                        return json_scalar_view{boolean};
+                    }
+                    break;
+                }
+                case simdjson::ondemand::json_type::number:
+                {
+                    simdjson::ondemand::number number;
+                    if (value.get_number().get(number) == simdjson::SUCCESS)
+                    {
+                        return number.is_int64() ? json_scalar_view{number.get_int64()}
+                                                 : json_scalar_view{number.as_double()};
+                    }
+                    break;
+                }
+                case simdjson::ondemand::json_type::string:
+                {
+                    std::string_view text;
+                    if (value.get_string().get(text) == simdjson::SUCCESS)
+                    {
+                        return json_scalar_view{text};
+                    }
+                    break;
+                }
+                default:
+                    break;
+            }
+            return std::nullopt;
+        }
+
+        template <class S>
+        std::optional<double> get_number(const S& scalar)
+        {
+            if (const auto* integer = std::get_if<std::int64_t>(&scalar))
+            {
+                return static_cast<double>(*integer);
+            }
+            if (const auto* number = std::get_if<double>(&scalar))
+            {
+                return *number;
+            }
+            return std::nullopt;
+        }
+
+        bool scalar_equals(const json_scalar_view& value, const json_scalar& expected)
+        {
+            if (const auto* text = std::get_if<std::string_view>(&value))
+            {
+                const auto* expected_text = std::get_if<std::string>(&expected);
+                return expected_text != nullptr && *text == *expected_text;
+            }
+            if (const auto* boolean = std::get_if<bool>(&value))
+            {
+                const auto* expected_boolean = std::get_if<bool>(&expected);
+                return expected_boolean != nullptr && *boolean == *expected_boolean;
+            }
+            if (std::holds_alternative<std::nullptr_t>(value))
+            {
+                return std::holds_alternative<std::nullptr_t>(expected);
+            }
+            // Integers are compared exactly with each other, by value with the other numbers
+            const auto* integer = std::get_if<std::int64_t>(&value);
+            const auto* expected_integer = std::get_if<std::int64_t>(&expected);
+            if (integer != nullptr && expected_integer != nullptr)
+            {
+                return *integer == *expected_integer;
+            }
+            const auto number = get_number(value);
+            const auto expected_number = get_number(expected);
+            return number.has_value() && expected_number.has_value() && *number == *expected_number;
+        }
+
+        bool matches(simdjson::ondemand::document& document, const json_predicate& predicate)
+        {
+            simdjson::ondemand::value value;
+            if (document.at_pointer(predicate.pointer).get(value) != simdjson::SUCCESS)
+            {
+                return false;
+            }
+            switch (predicate.type)
+            {
+                case json_predicate_type::exists:
+                    return true;
+                case json_predicate_type::range:
+                {
+                    double number = 0.0;
+                    return value.get_double().get(number) == simdjson::SUCCESS
+                           && (!predicate.lower.has_value() || *predicate.lower <= number)
+                           && (!predicate.upper.has_value() || number <= *predicate.upper);
+                }
+                case json_predicate_type::prefix:
+                {
+                    std::string_view text;
+                    return value.get_string().get(text) == simdjson::SUCCESS
+                           && text.starts_with(std::get<std::string>(predicate.values.front()));
+                }
+                case json_predicate_type::equals:
+                case json_predicate_type::in_set:
+                {
+                    const auto scalar = read_scalar(value);
+                    return scalar.has_value()
+                           && std::ranges::any_of(
+                               predicate.values,
+                               [&scalar](const json_scalar& expected)
+                               {
+                                   return scalar_equals(*scalar, expected);
+                               }
+                           );
+                }
+            }
+            return false;
+        }
+
+        bool8_array
+        filter_json_buffers(const json_buffers& buffers, std::span<const json_predicate> predicates)
+        {
+            std::vector<json_needles> needle_groups;
+            for (const auto& predicate : predicates)
+            {
+                check_json_predicate(predicate);
+                auto predicate_needles = get_predicate_needles(predicate);
+                std::ranges::move(predicate_needles, std::back_inserter(needle_groups));
+            }
+
+            sparrow::u8_buffer<bool> flag_values(buffers.size, false);
+            bool* flags = flag_values.data();
+            detail::parallel_for(
+                buffers.size,
+                json_parse_grain_size,
+                [&](std::size_t begin, std::size_t end)
+                {
+                    padded_input input;
+                    auto parser = detail::ondemand_parser_pool().acquire();
+                    for (std::size_t i = begin; i < end; ++i)
+                    {
+                        if (!is_valid_row(buffers, i))
+                        {
+                            continue;
+                        }
+                        // Rows missing the text of a predicate are rejected without being parsed
+                        const auto row = get_row(buffers, i);
+                        simdjson::ondemand::document document;
+                        if (!may_match(row.value, needle_groups)
+                            || parser->iterate(input(row)).get(document) != simdjson::SUCCESS)
+                        {
+                            continue;
+                        }
+                        flags[i] = std::ranges::all_of(
+                            predicates,
+                            [&document](const json_predicate& predicate)
+                            {
+                                return matches(document, predicate);
+                            }
+                        );
+                    }
+                }
+            );
+            return make_flag_array(buffers, std::move(flag_values));
+        }
+
+        void merge_field(json_schema_field& into, json_schema_field&& other);
+
+        // A field of type null that is not nullable has not been seen yet
+        bool is_unseen(const json_schema_field& field)
+        {
+            return field.type == json_schema_type::null && !field.nullable;
+        }
+
+        // Fields of two objects: the fields missing from one of them become nullable, and the
+        // new fields are appended in their order of appearance
+        void
+        merge_object_fields(std::vector<json_schema_field>& into, std::vector<json_schema_field>&& other)
+        {
+            std::vector<bool> merged(into.size(), false);
+            for (std::size_t k = 0; k < other.size(); ++k)
+            {
+                // The objects of a JSON dataset usually have their fields in the same order
+                auto it = k < into.size() && into[k].name == other[k].name
+                              ? into.begin() + static_cast<std::ptrdiff_t>(k)
+                              : std::ranges::find(into, other[k].name, &json_schema_field::name);
+                if (it == into.end())
+                {
+                    other[k].nullable = true;
+                    into.push_back(std::move(other[k]));
+                }
+                else
+                {
+                    merged[static_cast<std::size_t>(it - into.begin())] = true;
+                    merge_field(*it, std::move(other[k]));
+                }
+            }
+            for (std::size_t k = 0; k < merged.size(); ++k)
+            {
+                into[k].nullable = into[k].nullable || !merged[k];
+            }
+        }
+
+        void merge_field(json_schema_field& into, json_schema_field&& other)
+        {
+            if (is_unseen(other))
+            {
+                return;
+            }
+            if (is_unseen(into))
+            {
+                other.name = std::move(into.name);
+                into = std::move(other);
+                return;
+            }
+            into.nullable = into.nullable || other.nullable;
+            if (other.type == json_schema_type::null)
+            {
+                return;
+            }
+            if (other.type == into.type)
+            {
+                if (into.type == json_schema_type::object)
+                {
+                    merge_object_fields(into.children, std::move(other.children));
+                }
+                else if (into.type == json_schema_type::list)
+                {
+                    merge_field(into.children.front(), std::move(other.children.front()));
+                }
+                return;
+            }
+            if (into.type == json_schema_type::null)
+            {
+                into.type = other.type;
+                into.children = std::move(other.children);
+                return;
+            }
+
+            // Integers and floating point numbers are stored as floating point numbers, the
+            // other conflicting types as JSON text
+            const auto is_number = [](json_schema_type type)
+            {
+                return type == json_schema_type::int64 || type == json_schema_type::float64;
+            };
+            into.type = is_number(into.type) && is_number(other.type) ? json_schema_type::float64
+                                                                      : json_schema_type::json;
+            into.children.clear();
+        }
+
+        // Schema of a single JSON value
+        json_schema_field infer_field(std::string name, simdjson::dom::element element)
+        {
+            json_schema_field result{std::move(name), json_schema_type::null, false, {}};
+            switch (element.type())
+            {
+                case simdjson::dom::element_type::NULL_VALUE:
+                    result.nullable = true;
+                    break;
+                case simdjson::dom::element_type::BOOL:
+                    result.type = json_schema_type::boolean;
+                    break;
+                case simdjson::dom::element_type::INT64:
+                    result.type = json_schema_type::int64;
+                    break;
+                case simdjson::dom::element_type::UINT64:
+                case simdjson::dom::element_type::DOUBLE:
+                    result.type = json_schema_type::float64;
+                    break;
+                case simdjson::dom::element_type::STRING:
+                    result.type = json_schema_type::string;
+                    break;
+                case simdjson::dom::element_type::ARRAY:
+                {
+                    result.type = json_schema_type::list;
+                    json_schema_field item{"item", json_schema_type::null, false, {}};
+                    for (const simdjson::dom::element value : element.get_array().value_unsafe())
+                    {
+                        merge_field(item, infer_field("item", value));
+                    }
+                    result.children.push_back(std::move(item));
+                    break;
+                }
+                case simdjson::dom::element_type::OBJECT:
+                {
+                    result.type = json_schema_type::object;
+                    for (const auto [key, value] : element.get_object().value_unsafe())
+                    {
+                        result.children.push_back(infer_field(std::string(key), value));
+                    }
+                    break;
+                }
+            }
+            return result;
+        }
+
+        json_schema infer_json_schema_buffers(
+            const json_buffers& buffers,
+            const json_schema_inference_options& options
+        )
+        {
+            const std::size_t row_count = options.sample_size == 0
+                                              ? buffers.size
+                                              : std::min(options.sample_size, buffers.size);
+            const std::size_t block_count = (row_count + json_parse_grain_size - 1) / json_parse_grain_size;
+
+            // Each block infers the schema of its rows, the schemas are merged in row order
+            std::vector<json_schema_field> block_schemas(block_count);
+            detail::parallel_for(
+                block_count,
+                1,
+                [&](std::size_t first_block, std::size_t last_block)
+                {
+                    dom_parser parser;
+                    for (std::size_t block = first_block; block < last_block; ++block)
+                    {
+                        const std::size_t begin = block * json_parse_grain_size;
+                        const std::size_t end = std::min(begin + json_parse_grain_size, row_count);
+                        for (std::size_t i = begin; i < end; ++i)
+                        {
+                            simdjson::dom::element document;
+                            if (is_valid_row(buffers, i)
+                                && parser.parse(get_row(buffers, i)).get(document) == simdjson::SUCCESS
+                                && document.is_object())
+                            {
+                                merge_field(block_schemas[block], infer_field({}, document));
+                            }
+                        }
+                    }
+                }
+            );
+
+            json_schema_field root;
+            for (auto& block_schema : block_schemas)
+            {
+                merge_field(root, std::move(block_schema));
+            }
+            return json_schema{std::move(root.children)};
+        }
+
+        // Values of a field of a json_schema, for a block of rows
+        struct field_builder
+        {
+            const json_schema_field* field = nullptr;
+            std::vector<std::uint8_t> validity;
+            std::vector<std::int64_t> integers;
+            std::vector<double> doubles;
+            std::vector<std::uint8_t> booleans;
+            // Characters of the strings and JSON texts, and end of each of them
+            std::string characters;
+            std::vector<std::int64_t> ends;
+            // End of each list in the rows of the item builder
+            std::vector<std::int64_t> list_ends;
+            // Builders of the fields of an object, or of the items of a list
+            std::vector<field_builder> children;
+            // Position of the fields of an object in children, and which of them a row sets
+            std::unordered_map<std::string_view, std::size_t> child_positions;
+            std::vector<std::uint8_t> child_set;
+        };
+
+        field_builder make_field_builder(const json_schema_field& field)
+        {
+            field_builder result;
+            result.field = &field;
+            result.children.reserve(field.children.size());
+            for (std::size_t k = 0; k < field.children.size(); ++k)
+            {
+                result.children.push_back(make_field_builder(field.children[k]));
+                if (field.type == json_schema_type::object)
+                {
+                    result.child_positions.emplace(field.children[k].name, k);
+                }
+            }
+            result.child_set.resize(field.children.size());
+            return result;
+        }
+
+        void append_null(field_builder& builder)
+        {
+            builder.validity.push_back(0);
+            switch (builder.field->type)
+            {
+                case json_schema_type::null:
+                    break;
+                case json_schema_type::boolean:
+                    builder.booleans.push_back(0);
+                    break;
+                case json_schema_type::int64:
+                    builder.integers.push_back(0);
+                    break;
+                case json_schema_type::float64:
+                    builder.doubles.push_back(0);
+                    break;
+                case json_schema_type::string:
+                case json_schema_type::json:
+                    builder.ends.push_back(static_cast<std::int64_t>(builder.characters.size()));
+                    break;
+                case json_schema_type::list:
+                    builder.list_ends.push_back(
+                        static_cast<std::int64_t>(builder.children.front().validity.size())
+                    );
+                    break;
+                case json_schema_type::object:
+                    for (auto& child : builder.children)
+                    {
+                        append_null(child);
+                    }
+                    break;
+            }
+        }
+
+        // Appends a JSON value to the builder, as a null if it does not match the type of the field
+        void append_value(field_builder& builder, simdjson::dom::element element)
+        {
+            bool matches = false;
+            switch (builder.field->type)
+            {
+                case json_schema_type::null:
+                    break;
+                case json_schema_type::boolean:
+                {
+                    bool value = false;
+                    matches = element.get_bool().get(value) == simdjson::SUCCESS;
+                    if (matches)
+                    {
+                        builder.booleans.push_back(value ? 1 : 0);
+                    }
+                    break;
+                }
+                case json_schema_type::int64:
+                {
+                    std::int64_t value = 0;
+                    matches = element.get_int64().get(value) == simdjson::SUCCESS;
+                    if (matches)
+                    {
+                        builder.integers.push_back(value);
+                    }
+                    break;
+                }
+                case json_schema_type::float64:
+                {
+                    double value = 0;
+                    matches = element.get_double().get(value) == simdjson::SUCCESS;
+                    if (matches)
+                    {
+                        builder.doubles.push_back(value);
+                    }
+                    break;
+                }
+                case json_schema_type::string:
+                {
+                    std::string_view value;
+                    matches = element.get_string().get(value) == simdjson::SUCCESS;
+                    if (matches)
+                    {
+                        builder.characters.append(value);
+                        builder.ends.push_back(static_cast<std::int64_t>(builder.characters.size()));
+                    }
+                    break;
+                }
+                case json_schema_type::json:
+                {
+                    matches = !element.is_null();
+                    if (matches)
+                    {
+                        builder.characters.append(simdjson::minify(element));
+                        builder.ends.push_back(static_cast<std::int64_t>(builder.characters.size()));
+                    }
+                    break;
+                }
+                case json_schema_type::list:
+                {
+                    simdjson::dom::array values;
+                    matches = element.get_array().get(values) == simdjson::SUCCESS;
+                    if (matches)
+                    {
+                        auto& items = builder.children.front();
+                        for (const simdjson::dom::element value : values)
+                        {
+                            append_value(items, value);
+                        }
+                        builder.list_ends.push_back(static_cast<std::int64_t>(items.validity.size()));
+                    }
+                    break;
+                }
+                case json_schema_type::object:
+                {
+                    simdjson::dom::object fields;
+                    matches = element.get_object().get(fields) == simdjson::SUCCESS;
+                    if (matches)
+                    {
+                        std::ranges::fill(builder.child_set, 0);
+                        for (const auto [key, value] : fields)
+                        {
+                            const auto it = builder.child_positions.find(key);
+                            if (it != builder.child_positions.end() && builder.child_set[it->second] == 0)
+                            {
+                                builder.child_set[it->second] = 1;
+                                append_value(builder.children[it->second], value);
+                            }
+                        }
+                        for (std::size_t k = 0; k < builder.children.size(); ++k)
+                        {
+                            if (builder.child_set[k] == 0)
+                            {
+                                append_null(builder.children[k]);
+                            }
+                        }
+                    }
+                    break;
+                }
+            }
+            if (matches)
+            {
+                builder.validity.push_back(1);
+            }
+            else
+            {
+                append_null(builder);
+            }
+        }
+
+        // Appends the values of a block to the values of the previous blocks
+        void append_block(field_builder& into, field_builder&& block)
+        {
+            const auto character_base = static_cast<std::int64_t>(into.characters.size());
+            const auto item_base = into.field->type == json_schema_type::list
+                                       ? static_cast<std::int64_t>(into.children.front().validity.size())
+                                       : std::int64_t{0};
+            into.validity.insert(into.validity.end(), block.validity.begin(), block.validity.end());
+            into.integers.insert(into.integers.end(), block.integers.begin(), block.integers.end());
+            into.doubles.insert(into.doubles.end(), block.doubles.begin(), block.doubles.end());
+            into.booleans.insert(into.booleans.end(), block.booleans.begin(), block.booleans.end());
+            into.characters.append(block.characters);
+            for (const auto end : block.ends)
+            {
+                into.ends.push_back(character_base + end);
+            }
+            for (const auto end : block.list_ends)
+            {
+                into.list_ends.push_back(item_base + end);
+            }
+            for (std::size_t k = 0; k < into.children.size(); ++k)
+            {
+                append_block(into.children[k], std::move(block.children[k]));
+            }
+        }
+
+        template <class T, class V>
+        sparrow::u8_buffer<T> to_buffer(const std::vector<V>& values)
+        {
+            sparrow::u8_buffer<T> result(values.size(), T{});
+            std::ranges::transform(
+                values,
+                result.data(),
+                [](V value)
+                {
+                    return static_cast<T>(value);
+                }
+            );
+            return result;
+        }
+
+        // Offsets starting at 0 followed by ends
+        template <class O>
+        sparrow::u8_buffer<O> to_offsets(const std::vector<std::int64_t>& ends)
+        {
+            sparrow::u8_buffer<O> result(ends.size() + 1, O{0});
+            std::ranges::transform(
+                ends,
+                result.data() + 1,
+                [](std::int64_t end)
+                {
+                    return static_cast<O>(end);
+                }
+            );
+            return result;
+        }
+
+        // Strings or JSON texts, with 64-bit offsets when their cumulative length requires it
+        template <class A, class BIG_A>
+        sparrow::array make_text_array(field_builder&& builder, std::vector<bool>&& validity)
+        {
+            sparrow::u8_buffer<char> characters(builder.characters.size(), '\0');
+            std::ranges::copy(builder.characters, characters.data());
+            const std::string& name = builder.field->name;
+            constexpr auto max_size = static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max());
+            if (builder.characters.size() > max_size)
+            {
+                return sparrow::array(BIG_A(
+                    std::move(characters),
+                    to_offsets<std::int64_t>(builder.ends),
+                    std::move(validity),
+                    name
+                ));
+            }
+            return sparrow::array(
+                A(std::move(characters), to_offsets<std::int32_t>(builder.ends), std::move(validity), name)
+            );
+        }
+
+        sparrow::array make_shredded_array(field_builder&& builder)
+        {
+            const json_schema_field& field = *builder.field;
+            const std::size_t size = builder.validity.size();
+            std::vector<bool> validity(builder.validity.begin(), builder.validity.end());
+            switch (field.type)
+            {
+                case json_schema_type::null:
+                    return sparrow::array(sparrow::null_array(size, field.name));
+                case json_schema_type::boolean:
+                    return sparrow::array(
+                        bool8_array(to_buffer<bool>(builder.booleans), size, std::move(validity), field.name)
+                    );
+                case json_schema_type::int64:
+                    return sparrow::array(sparrow::primitive_array<std::int64_t>(
+                        to_buffer<std::int64_t>(builder.integers),
+                        size,
+                        std::move(validity),
+                        field.name
+                    ));
+                case json_schema_type::float64:
+                    return sparrow::array(sparrow::primitive_array<double>(
+                        to_buffer<double>(builder.doubles),
+                        size,
+                        std::move(validity),
+                        field.name
+                    ));
+                case json_schema_type::string:
+                    return make_text_array<sparrow::string_array, sparrow::big_string_array>(
+                        std::move(builder),
+                        std::move(validity)
+                    );
+                case json_schema_type::json:
+                    return make_text_array<json_array, big_json_array>(
+                        std::move(builder),
+                        std::move(validity)
+                    );
+                case json_schema_type::list:
+                {
+                    const auto item_count = builder.children.front().validity.size();
+                    sparrow::array items = make_shredded_array(std::move(builder.children.front()));
+                    if (item_count > static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max()))
+                    {
+                        return sparrow::array(sparrow::big_list_array(
+                            std::move(items),
+                            to_offsets<std::int64_t>(builder.list_ends),
+                            std::move(validity),
+                            field.name
+                        ));
+                    }
+                    return sparrow::array(sparrow::list_array(
+                        std::move(items),
+                        to_offsets<std::int32_t>(builder.list_ends),
+                        std::move(validity),
+                        field.name
+                    ));
+                }
+                case json_schema_type::object:
+                    break;
+            }
+            std::vector<sparrow::array> children;
+            children.reserve(builder.children.size());
+            for (auto& child : builder.children)
+            {
+                children.push_back(make_shredded_array(std::move(child)));
+            }
+            return sparrow::array(
+                sparrow::struct_array(std::move(children), std::move(validity), field.name)
+            );
+        }
+
+        sparrow::struct_array shred_json_buffers(const json_buffers& buffers, const json_schema& schema)
+        {
+            const json_schema_field root{{}, json_schema_type::object, true, schema.fields};
+            const std::size_t row_count = buffers.size;
+            const std::size_t block_count = (row_count + json_parse_grain_size - 1) / json_parse_grain_size;
+
+            // Each block is shredded in builders of its own, concatenated in row order
+            std::vector<field_builder> blocks;
+            blocks.reserve(block_count);
+            for (std::size_t block = 0; block < block_count; ++block)
+            {
+                blocks.push_back(make_field_builder(root));
+            }
+            detail::parallel_for(
+                block_count,
+                1,
+                [&](std::size_t first_block, std::size_t last_block)
+                {
+                    dom_parser parser;
+                    for (std::size_t block = first_block; block < last_block; ++block)
+                    {
+                        const std::size_t begin = block * json_parse_grain_size;
+                        const std::size_t end = std::min(begin + json_parse_grain_size, row_count);
+                        for (std::size_t i = begin; i < end; ++i)
+                        {
+                            simdjson::dom::element document;
+                            if (is_valid_row(buffers, i)
+                                && parser.parse(get_row(buffers, i)).get(document) == simdjson::SUCCESS)
+                            {
+                                append_value(blocks[block], document);
+                            }
+                            else
+                            {
+                                append_null(blocks[block]);
+                            }
+                        }
+                    }
+                }
+            );
+
+            field_builder result = make_field_builder(root);
+            for (auto& block : blocks)
+            {
+                append_block(result, std::move(block));
+            }
+            std::vector<bool> validity(result.validity.begin(), result.validity.end());
+            std::vector<sparrow::array> children;
+            children.reserve(result.children.size());
+            for (auto& child : result.children)
+            {
+                children.push_back(make_shredded_array(std::move(child)));
+            }
+            return sparrow::struct_array(std::move(children), std::move(validity));
+        }
+
+        // Kind of the values of a column serialised by serialize_json()
+        enum class json_value_kind
+        {
+            null,
+            boolean,
+            bool8,
+            signed_integer,
+            unsigned_integer,
+            float32,
+            float64,
+            string,
+            json,
+            uuid,
+            list,
+            fixed_size_list,
+            object
+        };
+
+        // Buffers of a column serialised by serialize_json(), and of its children
+        struct json_column
+        {
+            json_value_kind kind = json_value_kind::null;
+            const std::uint8_t* validity = nullptr;
+            std::int64_t offset = 0;
+            // Values of a primitive column, and size of an integer in bytes
+            const void* values = nullptr;
+            std::size_t width = 0;
+            // Offsets of a list, or size of a fixed-size list
+            const void* offsets = nullptr;
+            bool large_offsets = false;
+            std::int64_t list_size = 0;
+            // Storage of a string or JSON column
+            json_buffers strings;
+            // Quoted names of the fields of an object, followed by a colon
+            std::vector<std::string> keys;
+            std::vector<json_column> children;
+        };
+
+        // Counts the characters of a serialised value
+        class json_size_counter
+        {
+        public:
+
+            void append(char)
+            {
+                ++m_size;
+            }
+
+            void append(std::string_view characters)
+            {
+                m_size += characters.size();
+            }
+
+            [[nodiscard]] std::size_t size() const
+            {
+                return m_size;
+            }
+
+        private:
+
+            std::size_t m_size = 0;
+        };
+
+        // Writes a serialised value to a buffer sized by a json_size_counter
+        class json_writer
+        {
+        public:
+
+            explicit json_writer(char* out)
+                : m_out(out)
+            {
+            }
+
+            void append(char c)
+            {
+                *m_out++ = c;
+            }
+
+            void append(std::string_view characters)
+            {
+                m_out = std::ranges::copy(characters, m_out).out;
+            }
+
+        private:
+
+            char* m_out;
+        };
+
+        constexpr std::uint64_t repeat_byte(std::uint8_t byte)
+        {
+            return 0x0101010101010101ULL * byte;
+        }
+
+        // Whether one of the 8 bytes of a word is a control character, a quote or a backslash,
+        // tested on the whole word at once
+        bool needs_escaping(std::uint64_t word)
+        {
+            const auto has_zero_byte = [](std::uint64_t value)
+            {
+                return (value - repeat_byte(0x01)) & ~value & repeat_byte(0x80);
+            };
+            const std::uint64_t has_control = (word - repeat_byte(0x20)) & ~word & repeat_byte(0x80);
+            const std::uint64_t has_quote = has_zero_byte(word ^ repeat_byte('"'));
+            const std::uint64_t has_backslash = has_zero_byte(word ^ repeat_byte('\\'));
+            return (has_control | has_quote | has_backslash) != 0;
+        }
+
+        // \u00XX escape sequences of the control characters
+        constexpr auto control_escapes = []
+        {
+            constexpr std::string_view hex_digits = "0123456789abcdef";
+            std::array<std::array<char, 6>, 0x20> result{};
+            for (std::size_t c = 0; c < result.size(); ++c)
+            {
+                result[c] = {'\\', 'u', '0', '0', hex_digits[c / 16], hex_digits[c % 16]};
+            }
+            return result;
+        }();
+
+        // Escape sequence of a character in a JSON string, empty if it is written as is
+        std::string_view escape_sequence(char c)
+        {
+            switch (c)
+            {
+                case '"':
+                    return "\\\"";
+                case '\\':
+                    return "\\\\";
+                case '\b':
+                    return "\\b";
+                case '\f':
+                    return "\\f";
+                case '\n':
+                    return "\\n";
+                case '\r':
+                    return "\\r";
+                case '\t':
+                    return "\\t";
+                default:
+                    break;
+            }
+            const auto code = static_cast<unsigned char>(c);
+            if (code < control_escapes.size())
+            {
+                return {control_escapes[code].data(), control_escapes[code].size()};
+            }
+            return {};
+        }
+
+        // Writes a quoted JSON string, skipping 8 characters at a time while none needs escaping
+        template <class S>
+        void write_string(std::string_view value, S& sink)
+        {
+            sink.append('"');
+            std::size_t unescaped_begin = 0;
+            for (std::size_t k = 0; k < value.size();)
+            {
+                if (k + sizeof(std::uint64_t) <= value.size())
+                {
+                    std::uint64_t word = 0;
+                    std::memcpy(&word, value.data() + k, sizeof(word));
+                    if (!needs_escaping(word))
+                    {
+                        k += sizeof(word);
+                        continue;
+                    }
+                }
+                const auto escape = escape_sequence(value[k]);
+                if (!escape.empty())
+                {
+                    sink.append(value.substr(unescaped_begin, k - unescaped_begin));
+                    sink.append(escape);
+                    unescaped_begin = k + 1;
+                }
+                ++k;
+            }
+            sink.append(value.substr(unescaped_begin));
+            sink.append('"');
+        }
+
+        // Writes a number in its shortest representation, null for the non-finite ones
+        template <class T, class S>
+        void write_number(T value, S& sink)
+        {
+            if constexpr (std::is_floating_point_v<T>)
+            {
+                if (!std::isfinite(value))
+                {
+                    sink.append("null");
+                    return;
+                }
+            }
+            std::array<char, 32> characters;
+            char* const first = characters.data();
+            const auto result = std::to_chars(first, first + characters.size(), value);
+            sink.append(std::string_view(first, static_cast<std::size_t>(result.ptr - first)));
+        }
+
+        template <class T>
+        T read_value(const void* values, std::int64_t position)
+        {
+            return static_cast<const T*>(values)[position];
+        }
+
+        std::int64_t read_signed(const json_column& column, std::int64_t position)
+        {
+            switch (column.width)
+            {
+                case 1:
+                    return read_value<std::int8_t>(column.values, position);
+                case 2:
+                    return read_value<std::int16_t>(column.values, position);
+                case 4:
+                    return read_value<std::int32_t>(column.values, position);
+                default:
+                    return read_value<std::int64_t>(column.values, position);
+            }
+        }
+
+        std::uint64_t read_unsigned(const json_column& column, std::int64_t position)
+        {
+            switch (column.width)
+            {
+                case 1:
+                    return read_value<std::uint8_t>(column.values, position);
+                case 2:
+                    return read_value<std::uint16_t>(column.values, position);
+                case 4:
+                    return read_value<std::uint32_t>(column.values, position);
+                default:
+                    return read_value<std::uint64_t>(column.values, position);
+            }
+        }
+
+        bool is_bit_set(const std::uint8_t* bits, std::int64_t position)
+        {
+            const auto bit = static_cast<std::size_t>(position);
+            return ((bits[bit / 8] >> (bit % 8)) & 1) != 0;
+        }
+
+        template <class S>
+        void write_uuid(const std::uint8_t* bytes, S& sink)
+        {
+            constexpr std::string_view hex_digits = "0123456789abcdef";
+            std::array<char, 38> characters{};
+            std::size_t position = 0;
+            characters[position++] = '"';
+            for (std::size_t b = 0; b < 16; ++b)
+            {
+                if (b == 4 || b == 6 || b == 8 || b == 10)
+                {
+                    characters[position++] = '-';
+                }
+                characters[position++] = hex_digits[bytes[b] >> 4];
+                characters[position++] = hex_digits[bytes[b] & 0xF];
+            }
+            characters[position] = '"';
+            sink.append(std::string_view(characters.data(), characters.size()));
+        }
+
+        // Writes the value at index i of a column; the children of an object are aligned with
+        // it, so that they are read at the same position, offset included
+        template <class S>
+        void write_value(const json_column& column, std::int64_t i, S& sink)
+        {
+            const std::int64_t position = column.offset + i;
+            if (column.validity != nullptr && !is_bit_set(column.validity, position))
+            {
+                sink.append("null");
+                return;
+            }
+            switch (column.kind)
+            {
+                case json_value_kind::null:
+                    sink.append("null");
+                    break;
+                case json_value_kind::boolean:
+                {
+                    const auto* bits = static_cast<const std::uint8_t*>(column.values);
+                    sink.append(is_bit_set(bits, position) ? "true" : "false");
+                    break;
+                }
+                case json_value_kind::bool8:
+                    sink.append(read_value<std::int8_t>(column.values, position) != 0 ? "true" : "false");
+                    break;
+                case json_value_kind::signed_integer:
+                    write_number(read_signed(column, position), sink);
+                    break;
+                case json_value_kind::unsigned_integer:
+                    write_number(read_unsigned(column, position), sink);
+                    break;
+                case json_value_kind::float32:
+                    write_number(read_value<float>(column.values, position), sink);
+                    break;
+                case json_value_kind::float64:
+                    write_number(read_value<double>(column.values, position), sink);
+                    break;
+                case json_value_kind::string:
+                    write_string(get_row(column.strings, static_cast<std::size_t>(i)).value, sink);
+                    break;
+                case json_value_kind::json:
+                    sink.append(get_row(column.strings, static_cast<std::size_t>(i)).value);
+                    break;
+                case json_value_kind::uuid:
+                    write_uuid(static_cast<const std::uint8_t*>(column.values) + position * 16, sink);
+                    break;
+                case json_value_kind::list:
+                case json_value_kind::fixed_size_list:
+                {
+                    std::int64_t begin = position * column.list_size;
+                    std::int64_t end = begin + column.list_size;
+                    if (column.kind == json_value_kind::list)
+                    {
+                        begin = column.large_offsets ? read_value<std::int64_t>(column.offsets, position)
+                                                     : read_value<std::int32_t>(column.offsets, position);
+                        end = column.large_offsets ? read_value<std::int64_t>(column.offsets, position + 1)
+                                                   : read_value<std::int32_t>(column.offsets, position + 1);
+                    }
+                    sink.append('[');
+                    for (std::int64_t k = begin; k < end; ++k)
+                    {
+                        if (k != begin)
+                        {
+                            sink.append(',');
+                        }
+                        write_value(column.children.front(), k, sink);
+                    }
+                    sink.append(']');
+                    break;
+                }
+                case json_value_kind::object:
+                {
+                    sink.append('{');
+                    for (std::size_t k = 0; k < column.children.size(); ++k)
+                    {
+                        if (k != 0)
+                        {
+                            sink.append(',');
+                        }
+                        sink.append(column.keys[k]);
+                        write_value(column.children[k], position, sink);
+                    }
+                    sink.append('}');
+                    break;
+                }
+            }
+        }
+
+        std::string make_key(std::string_view name)
+        {
+            json_size_counter counter;
+            write_string(name, counter);
+            std::string result(counter.size() + 1, ':');
+            json_writer writer(result.data());
+            write_string(name, writer);
+            return result;
+        }
+
+        std::string_view get_extension_name(const sparrow::arrow_proxy& proxy)
+        {
+            const auto metadata = proxy.metadata();
+            if (metadata.has_value())
+            {
+                for (const auto& [key, value] : *metadata)
+                {
+                    if (key == "ARROW:extension:name")
+                    {
+                        return value;
+                    }
+                }
+            }
+            return {};
+        }
+
+        // Kind and size in bytes of the values of a primitive format
+        struct primitive_format
+        {
+            std::string_view format;
+            json_value_kind kind;
+            std::size_t width;
+        };
+
+        constexpr std::array<primitive_format, 10> primitive_formats = {{
+            {"c", json_value_kind::signed_integer, 1},
+            {"s", json_value_kind::signed_integer, 2},
+            {"i", json_value_kind::signed_integer, 4},
+            {"l", json_value_kind::signed_integer, 8},
+            {"C", json_value_kind::unsigned_integer, 1},
+            {"S", json_value_kind::unsigned_integer, 2},
+            {"I", json_value_kind::unsigned_integer, 4},
+            {"L", json_value_kind::unsigned_integer, 8},
+            {"f", json_value_kind::float32, 4},
+            {"g", json_value_kind::float64, 8}
+        }};
+
+        json_column make_json_column(const sparrow::arrow_proxy& proxy)
+        {
+            const ArrowArray& array = proxy.array();
+            const std::string_view format = proxy.schema().format;
+            const std::string_view extension_name = get_extension_name(proxy);
+
+            json_column result;
+            result.validity = array.n_buffers > 0 ? static_cast<const std::uint8_t*>(array.buffers[0])
+                                                  : nullptr;
+            result.offset = array.offset;
+            result.values = array.n_buffers > 1 ? array.buffers[1] : nullptr;
+            const auto primitive = std::ranges::find(primitive_formats, format, &primitive_format::format);
+            if (extension_name == "arrow.json")
+            {
+                result.kind = json_value_kind::json;
+                result.strings = get_json_buffers(proxy);
+            }
+            else if (extension_name == "arrow.bool8")
+            {
+                result.kind = json_value_kind::bool8;
+            }
+            else if (extension_name == "arrow.uuid")
+            {
+                result.kind = json_value_kind::uuid;
+            }
+            else if (primitive != primitive_formats.end())
+            {
+                result.kind = primitive->kind;
+                result.width = primitive->width;
+            }
+            else if (format == "n")
+            {
+                result.kind = json_value_kind::null;
+            }
+            else if (format == "b")
+            {
+                result.kind = json_value_kind::boolean;
+            }
+            else if (format == "u" || format == "U" || format == "vu")
+            {
+                result.kind = json_value_kind::string;
+                result.strings = get_json_buffers(proxy);
+            }
+            else if (format == "+l" || format == "+L")
+            {
+                result.kind = json_value_kind::list;
+                result.offsets = result.values;
+                result.large_offsets = format == "+L";
+                result.children.push_back(make_json_column(proxy.children().front()));
+            }
+            else if (format.starts_with("+w:"))
+            {
+                result.kind = json_value_kind::fixed_size_list;
+                result.list_size = std::stoll(std::string(format.substr(3)));
+                result.children.push_back(make_json_column(proxy.children().front()));
+            }
+            else if (format == "+s")
+            {
+                result.kind = json_value_kind::object;
+                for (const auto& child : proxy.children())
+                {
+                    result.keys.push_back(make_key(child.name().value_or("")));
+                    result.children.push_back(make_json_column(child));
+                }
+            }
+            else
+            {
+                throw std::runtime_error(
+                    "serialize_json: the format \"" + std::string(format) + "\" of the field \""
+                    + std::string(proxy.name().value_or("")) + "\" cannot be serialised"
+                );
+            }
+            return result;
+        }
+
+        // Serialises each row of an object column: the size of every value is computed in a
+        // first pass, so that the second one writes the values in place in the data buffer
+        template <bool BIG>
+        auto serialize_rows(const json_column& records, std::size_t row_count)
+        {
+            using offset_type = std::conditional_t<BIG, std::int64_t, std::int32_t>;
+            using result_type = std::conditional_t<BIG, big_json_array, json_array>;
+            std::vector<std::uint8_t> row_validity(row_count, 0);
+            sparrow::u8_buffer<offset_type> offsets(row_count + 1, offset_type{0});
+            offset_type* offsets_data = offsets.data();
+            std::vector<std::size_t> sizes(row_count, 0);
+            detail::parallel_for(
+                row_count,
+                json_serialize_grain_size,
+                [&](std::size_t begin, std::size_t end)
+                {
+                    for (std::size_t i = begin; i < end; ++i)
+                    {
+                        const auto position = records.offset + static_cast<std::int64_t>(i);
+                        if (records.validity == nullptr || is_bit_set(records.validity, position))
+                        {
+                            json_size_counter counter;
+                            write_value(records, static_cast<std::int64_t>(i), counter);
+                            sizes[i] = counter.size();
+                            row_validity[i] = 1;
+                        }
+                    }
+                }
+            );
+
+            std::size_t character_count = 0;
+            for (std::size_t i = 0; i < row_count; ++i)
+            {
+                character_count += sizes[i];
+                constexpr auto max_size = static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max());
+                if (!BIG && character_count > max_size)
+                {
+                    throw std::runtime_error(
+                        "serialize_json: the JSON values exceed 2^31-1 bytes, use serialize_big_json"
+                    );
+                }
+                offsets_data[i + 1] = static_cast<offset_type>(character_count);
+            }
+
+            sparrow::u8_buffer<char> characters(character_count, '\0');
+            char* characters_data = characters.data();
+            detail::parallel_for(
+                row_count,
+                json_serialize_grain_size,
+                [&](std::size_t begin, std::size_t end)
+                {
+                    for (std::size_t i = begin; i < end; ++i)
+                    {
+                        if (row_validity[i] != 0)
+                        {
+                            json_writer writer(characters_data + offsets_data[i]);
+                            write_value(records, static_cast<std::int64_t>(i), writer);
+                        }
+                    }
+                }
+            );
+            std::vector<bool> validity(row_validity.begin(), row_validity.end());
+            return result_type(std::move(characters), std::move(offsets), std::move(validity));
+        }
+
+        template <bool BIG>
+        auto serialize_struct(const sparrow::struct_array& records)
+        {
+            const auto& proxy = sparrow::detail::array_access::get_arrow_proxy(records);
+            return serialize_rows<BIG>(make_json_column(proxy), records.size());
+        }
+
+        template <bool BIG>
+        auto serialize_record_batch(const sparrow::record_batch& batch)
+        {
+            json_column records;
+            records.kind = json_value_kind::object;
+            for (const auto& name : batch.names())
+            {
+                records.keys.push_back(make_key(name));
+            }
+            for (const auto& column : batch.columns())
+            {
+                const auto& proxy = sparrow::detail::array_access::get_arrow_proxy(column);
+                records.children.push_back(make_json_column(proxy));
+            }
+            return serialize_rows<BIG>(records, batch.nb_rows());
+        }
+
+        // Sink appending the characters to a string
+        class json_string_writer
+        {
+        public:
+
+            explicit json_string_writer(std::string& out)
+                : m_out(out)
+            {
+            }
+
+            void append(char c)
+            {
+                m_out.push_back(c);
+            }
+
+            void append(std::string_view characters)
+            {
+                m_out.append(characters);
+            }
+
+        private:
+
+            std::string& m_out;
+        };
+
+        [[noreturn]] void
+        throw_invalid_document(std::string_view function, std::size_t row, simdjson::error_code error)
+        {
+            throw std::runtime_error(
+                std::string(function) + ": row " + std::to_string(row)
+                + " is not a valid JSON document: " + simdjson::error_message(error)
+            );
+        }
+
+        // Canonical form of a value: no whitespace, the fields of the objects sorted by the
+        // bytes of their keys, the strings with the minimal escape sequences and the numbers
+        // in their shortest round-trip form
+        template <class S>
+        void write_canonical(simdjson::dom::element element, S& sink)
+        {
+            switch (element.type())
+            {
+                case simdjson::dom::element_type::NULL_VALUE:
+                    sink.append("null");
+                    break;
+                case simdjson::dom::element_type::BOOL:
+                    sink.append(element.get_bool().value_unsafe() ? "true" : "false");
+                    break;
+                case simdjson::dom::element_type::INT64:
+                    write_number(element.get_int64().value_unsafe(), sink);
+                    break;
+                case simdjson::dom::element_type::UINT64:
+                    write_number(element.get_uint64().value_unsafe(), sink);
+                    break;
+                case simdjson::dom::element_type::DOUBLE:
+                {
+                    // Negative zero is written as zero
+                    const double value = element.get_double().value_unsafe();
+                    write_number(value == 0.0 ? 0.0 : value, sink);
+                    break;
+                }
+                case simdjson::dom::element_type::STRING:
+                    write_string(element.get_string().value_unsafe(), sink);
+                    break;
+                case simdjson::dom::element_type::ARRAY:
+                {
+                    sink.append('[');
+                    bool first = true;
+                    for (const simdjson::dom::element value : element.get_array().value_unsafe())
+                    {
+                        if (!std::exchange(first, false))
+                        {
+                            sink.append(',');
+                        }
+                        write_canonical(value, sink);
+                    }
+                    sink.append(']');
+                    break;
+                }
+                case simdjson::dom::element_type::OBJECT:
+                {
+                    using object_field = std::pair<std::string_view, simdjson::dom::element>;
+                    std::vector<object_field> fields;
+                    for (const auto [key, value] : element.get_object().value_unsafe())
+                    {
+                        fields.emplace_back(key, value);
+                    }
+                    std::ranges::stable_sort(fields, {}, &object_field::first);
+                    sink.append('{');
+                    for (std::size_t k = 0; k < fields.size(); ++k)
+                    {
+                        if (k > 0)
+                        {
+                            sink.append(',');
+                        }
+                        write_string(fields[k].first, sink);
+                        sink.append(':');
+                        write_canonical(fields[k].second, sink);
+                    }
+                    sink.append('}');
+                    break;
+                }
+            }
+        }
+
+        // Removes the whitespace outside of the strings with the simdjson minifier, which does
+        // not validate the values
+        class json_minifier
+        {
+        public:
+
+            static constexpr std::string_view function = "minify_json";
+
+            simdjson::error_code operator()(const json_row& row, std::string& out)
+            {
+                const auto& value = row.value;
+                const std::size_t begin = out.size();
+                out.resize(begin + value.size());
+                std::size_t size = 0;
+                const auto error = simdjson::minify(value.data(), value.size(), out.data() + begin, size);
+                out.resize(error == simdjson::SUCCESS ? begin + size : begin);
+                return error;
+            }
+        };
+
+        class json_canonicalizer
+        {
+        public:
+
+            static constexpr std::string_view function = "canonicalize_json";
+
+            simdjson::error_code operator()(const json_row& row, std::string& out)
+            {
+                simdjson::dom::element element;
+                if (const auto error = m_parser.parse(row).get(element); error != simdjson::SUCCESS)
+                {
+                    return error;
+                }
+                json_string_writer writer(out);
+                write_canonical(element, writer);
+                return simdjson::SUCCESS;
+            }
+
+        private:
+
+            dom_parser m_parser;
+        };
+
+        // Rewrites the non-null values with a rewriter R, which appends the new text of a row
+        // to a string and returns the error of an invalid document: each thread rewrites blocks
+        // of rows in a buffer of its own, then the offsets follow from the sizes of the blocks
+        // and the blocks are copied in parallel
+        template <bool BIG, class R>
+        auto rewrite_json_buffers(const json_buffers& buffers)
+        {
+            using offset_type = std::conditional_t<BIG, std::int64_t, std::int32_t>;
+            using result_type = std::conditional_t<BIG, big_json_array, json_array>;
+            const std::size_t row_count = buffers.size;
+            const std::size_t block_count = (row_count + json_parse_grain_size - 1) / json_parse_grain_size;
+            std::vector<string_block> blocks(block_count);
+            // Each thread stops past the first invalid row found so far, which is reported once
+            // all the threads are done
+            std::atomic<std::size_t> first_invalid_row = row_count;
+            detail::parallel_for(
+                block_count,
+                1,
+                [&](std::size_t first_block, std::size_t last_block)
+                {
+                    const auto already_found = [&first_invalid_row](std::size_t i)
+                    {
+                        return i >= first_invalid_row.load(std::memory_order_relaxed);
+                    };
+                    R rewriter;
+                    for (std::size_t block = first_block; block < last_block; ++block)
+                    {
+                        auto& strings = blocks[block];
+                        const std::size_t begin = block * json_parse_grain_size;
+                        const std::size_t end = std::min(begin + json_parse_grain_size, row_count);
+                        for (std::size_t i = begin; i < end && !already_found(i); ++i)
+                        {
+                            if (is_valid_row(buffers, i)
+                                && rewriter(get_row(buffers, i), strings.characters) != simdjson::SUCCESS)
+                            {
+                                auto current = first_invalid_row.load(std::memory_order_relaxed);
+                                while (i < current && !first_invalid_row.compare_exchange_weak(current, i))
+                                {
+                                }
+                                return;
+                            }
+                            strings.ends.push_back(static_cast<std::int64_t>(strings.characters.size()));
+                        }
+                    }
+                }
+            );
+
+            if (const std::size_t row = first_invalid_row.load(); row != row_count)
+            {
+                R rewriter;
+                std::string scratch;
+                throw_invalid_document(R::function, row, rewriter(get_row(buffers, row), scratch));
+            }
+
+            std::vector<std::size_t> block_offsets(block_count, 0);
+            std::size_t character_count = 0;
+            for (std::size_t block = 0; block < block_count; ++block)
+            {
+                block_offsets[block] = character_count;
+                character_count += blocks[block].characters.size();
+            }
+            constexpr auto max_size = static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max());
+            if (!BIG && character_count > max_size)
+            {
+                throw std::runtime_error(std::string(R::function) + ": the JSON values exceed 2^31-1 bytes");
+            }
+
+            sparrow::u8_buffer<offset_type> offsets(row_count + 1, offset_type{0});
+            sparrow::u8_buffer<char> characters(character_count, '\0');
+            offset_type* offsets_data = offsets.data();
+            char* characters_data = characters.data();
+            detail::parallel_for(
+                block_count,
+                1,
+                [&](std::size_t first_block, std::size_t last_block)
+                {
+                    for (std::size_t block = first_block; block < last_block; ++block)
+                    {
+                        const auto& strings = blocks[block];
+                        std::ranges::copy(strings.characters, characters_data + block_offsets[block]);
+                        std::size_t row = block * json_parse_grain_size;
+                        for (const auto end : strings.ends)
+                        {
+                            const auto offset = static_cast<std::int64_t>(block_offsets[block]) + end;
+                            offsets_data[++row] = static_cast<offset_type>(offset);
+                        }
+                    }
+                }
+            );
+
+            std::vector<bool> validity(row_count);
+            for (std::size_t i = 0; i < row_count; ++i)
+            {
+                validity[i] = is_valid_row(buffers, i);
+            }
+            return result_type(std::move(characters), std::move(offsets), std::move(validity));
+        }
+    }
+
+    std::optional<json_validation_error> validate_json(const json_array& json_values)
+    {
+        return validate_json_buffers(get_json_buffers(json_values));
+    }
+
+    std::optional<json_validation_error> validate_json(const big_json_array& json_values)
+    {
+        return validate_json_buffers(get_json_buffers(json_values));
+    }
+
+    std::optional<json_validation_error> validate_json(const json_view_array& json_values)
+    {
+        return validate_json_buffers(get_json_buffers(json_values));
+    }
+
+    bool8_array is_valid_json(const json_array& json_values)
+    {
+        return is_valid_json_buffers(get_json_buffers(json_values));
+    }
+
+    bool8_array is_valid_json(const big_json_array& json_values)
+    {
+        return is_valid_json_buffers(get_json_buffers(json_values));
+    }
+
+    bool8_array is_valid_json(const json_view_array& json_values)
+    {
+        return is_valid_json_buffers(get_json_buffers(json_values));
+    }
+
+    std::vector<sparrow::array>
+    extract_json_fields(const json_array& json_values, std::span<const json_field> fields)
+    {
+        return extract_json_buffers(get_json_buffers(json_values), fields);
+    }
+
+    std::vector<sparrow::array>
+    extract_json_fields(const big_json_array& json_values, std::span<const json_field> fields)
+    {
+        return extract_json_buffers(get_json_buffers(json_values), fields);
+    }
+
+    std::vector<sparrow::array>
+    extract_json_fields(const json_view_array& json_values, std::span<const json_field> fields)
+    {
+        return extract_json_buffers(get_json_buffers(json_values), fields);
+    }
+
+    json_schema infer_json_schema(const json_array& json_values, const json_schema_inference_options& options)
+    {
+        return infer_json_schema_buffers(get_json_buffers(json_values), options);
+    }
+
+    json_schema
+    infer_json_schema(const big_json_array& json_values, const json_schema_inference_options& options)
+    {
+        return infer_json_schema_buffers(get_json_buffers(json_values), options);
+    }
+
+    json_schema
+    infer_json_schema(const json_view_array& json_values, const json_schema_inference_options& options)
+    {
+        return infer_json_schema_buffers(get_json_buffers(json_values), options);
+    }
+
+    sparrow::struct_array shred_json(const json_array& json_values, const json_schema& schema)
+    {
+        return shred_json_buffers(get_json_buffers(json_values), schema);
+    }
+
+    sparrow::struct_array shred_json(const big_json_array& json_values, const json_schema& schema)
+    {
+        return shred_json_buffers(get_json_buffers(json_values), schema);
+    }
+
+    sparrow::struct_array shred_json(const json_view_array& json_values, const json_schema& schema)
+    {
+        return shred_json_buffers(get_json_buffers(json_values), schema);
+    }
+
+    json_array serialize_json(const sparrow::struct_array& records)
+    {
+        return serialize_struct<false>(records);
+    }
+
+    json_array serialize_json(const sparrow::record_batch& batch)
+    {
+        return serialize_record_batch<false>(batch);
+    }
+
+    big_json_array serialize_big_json(const sparrow::struct_array& records)
+    {
+        return serialize_struct<true>(records);
+    }
+
+    big_json_array serialize_big_json(const sparrow::record_batch& batch)
+    {
+        return serialize_record_batch<true>(batch);
+    }
+
+    json_index::json_index(const json_array& json_values)
+        : m_size(json_values.size())
+        , m_blocks(index_json_buffers(get_json_buffers(json_values)))
+    {
+    }
+
+    json_index::json_index(const big_json_array& json_values)
+        : m_size(json_values.size())
+        , m_blocks(index_json_buffers(get_json_buffers(json_values)))
+    {
+    }
+
+    json_index::json_index(const json_view_array& json_values)
+        : m_size(json_values.size())
+        , m_blocks(index_json_buffers(get_json_buffers(json_values)))
+    {
+    }
+
+    std::size_t json_index::size() const noexcept
+    {
+        return m_size;
+    }
+
+    bool json_index::has_document(std::size_t i) const
+    {
+        SPARROW_ASSERT_TRUE(i < size());
+        const auto& block = m_blocks[i / json_parse_grain_size];
+        return block.roots[i % json_parse_grain_size] != detail::json_tape_block::no_document;
+    }
+
+    std::size_t json_index::memory_size() const noexcept
+    {
+        std::size_t result = m_blocks.capacity() * sizeof(detail::json_tape_block);
+        for (const auto& block : m_blocks)
+        {
+            result += block.tape.capacity() * sizeof(detail::json_tape_entry) + block.characters.capacity()
+                      + block.roots.capacity() * sizeof(std::size_t);
+        }
+        return result;
+    }
+
+    std::vector<sparrow::array>
+    extract_json_fields(const json_index& index, std::span<const json_field> fields)
+    {
+        return extract_indexed_fields(index.m_blocks, index.m_size, fields);
+    }
+
+    bool8_array filter_json(const json_array& json_values, std::span<const json_predicate> predicates)
+    {
+        return filter_json_buffers(get_json_buffers(json_values), predicates);
+    }
+
+    bool8_array filter_json(const big_json_array& json_values, std::span<const json_predicate> predicates)
+    {
+        return filter_json_buffers(get_json_buffers(json_values), predicates);
+    }
+
+    bool8_array filter_json(const json_view_array& json_values, std::span<const json_predicate> predicates)
+    {
+        return filter_json_buffers(get_json_buffers(json_values), predicates);
+    }
+
+    json_array minify_json(const json_array& json_values)
+    {
+        return rewrite_json_buffers<false, json_minifier>(get_json_buffers(json_values));
+    }
+
+    big_json_array minify_json(const big_json_array& json_values)
+    {
+        return rewrite_json_buffers<true, json_minifier>(get_json_buffers(json_values));
+    }
+
+    json_array minify_json(const json_view_array& json_values)
+    {
+        return rewrite_json_buffers<false, json_minifier>(get_json_buffers(json_values));
+    }
+
+    json_array canonicalize_json(const json_array& json_values)
+    {
+        return rewrite_json_buffers<false, json_canonicalizer>(get_json_buffers(json_values));
+    }
+
+    big_json_array canonicalize_json(const big_json_array& json_values)
+    {
+        return rewrite_json_buffers<true, json_canonicalizer>(get_json_buffers(json_values));
+    }
+
+    json_array canonicalize_json(const json_view_array& json_values)
+    {
+        return rewrite_json_buffers<false, json_canonicalizer>(get_json_buffers(json_values));
+    }
+}
@@ -0,0 +1,46 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sparrow_extensions/json_parser_pool.hpp"
+
+#include <algorithm>
+#include <thread>
+
+namespace sparrow_extensions::detail
+{
+    namespace
+    {
+        // One idle parser per thread that parallel_for may run
+        std::size_t pooled_parser_count()
+        {
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+            return 1;
+#else
+            return std::max(1u, std::thread::hardware_concurrency());
+#endif
+        }
+    }
+
+    json_parser_pool<simdjson::dom::parser>& dom_parser_pool()
+    {
+        static json_parser_pool<simdjson::dom::parser> pool(pooled_parser_count());
+        return pool;
+    }
+
+    json_parser_pool<simdjson::ondemand::parser>& ondemand_parser_pool()
+    {
+        static json_parser_pool<simdjson::ondemand::parser> pool(pooled_parser_count());
+        return pool;
+    }
+}
@@ -0,0 +1,228 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sparrow_extensions/memory_footprint.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+
+#include "sparrow/arrow_interface/arrow_array/private_data.hpp"
+#include "sparrow/types/data_type.hpp"
+
+namespace sparrow_extensions
+{
+    namespace
+    {
+        std::string_view buffer_name(sparrow::data_type dt, std::size_t index, std::size_t buffer_count)
+        {
+            using sparrow::data_type;
+            switch (dt)
+            {
+                case data_type::NA:
+                case data_type::RUN_ENCODED:
+                    return "unknown";
+                case data_type::STRUCT:
+                case data_type::FIXED_SIZED_LIST:
+                    return index == 0 ? "validity" : "unknown";
+                case data_type::LIST:
+                case data_type::LARGE_LIST:
+                case data_type::MAP:
+                    return index == 0 ? "validity" : "offsets";
+                case data_type::LIST_VIEW:
+                case data_type::LARGE_LIST_VIEW:
+                    return index == 0 ? "validity" : (index == 1 ? "offsets" : "sizes");
+                case data_type::STRING:
+                case data_type::LARGE_STRING:
+                case data_type::BINARY:
+                case data_type::LARGE_BINARY:
+                    return index == 0 ? "validity" : (index == 1 ? "offsets" : "values");
+                case data_type::STRING_VIEW:
+                case data_type::BINARY_VIEW:
+                    if (index < 2)
+                    {
+                        return index == 0 ? "validity" : "views";
+                    }
+                    return index + 1 == buffer_count ? "variadic_sizes" : "variadic_data";
+                case data_type::SPARSE_UNION:
+                    return "type_ids";
+                case data_type::DENSE_UNION:
+                    return index == 0 ? "type_ids" : "offsets";
+                default:
+                    return index == 0 ? "validity" : "values";
+            }
+        }
+
+        template <class F>
+        void for_each_buffer(memory_footprint& footprint, F&& visit)
+        {
+            for (auto& buffer : footprint.buffers)
+            {
+                visit(buffer);
+            }
+            for (auto& child : footprint.children)
+            {
+                for_each_buffer(child, visit);
+            }
+            for (auto& dictionary : footprint.dictionary)
+            {
+                for_each_buffer(dictionary, visit);
+            }
+        }
+
+        // Footprint of the array held by proxy, whose buffers are owned when the proxy owns the
+        // array (or is a child of an owned array), sparrow released it, and the buffer is the
+        // one stored in its private data rather than a reference to another array's buffer
+        memory_footprint collect_footprint(const sparrow::arrow_proxy& proxy, bool owns_array)
+        {
+            memory_footprint result;
+            result.name = std::string(proxy.name().value_or(""));
+
+            // Buffers allocated by sparrow are stored in the private data of the ArrowArray,
+            // which is the only place where their capacity is known.
+            const bool created_with_sparrow = proxy.is_created_with_sparrow();
+            auto* private_data = created_with_sparrow ? static_cast<sparrow::arrow_array_private_data*>(
+                                                            proxy.array().private_data
+                                                        )
+                                                      : nullptr;
+
+            const auto& buffers = proxy.buffers();
+            result.buffers.reserve(buffers.size());
+            for (std::size_t i = 0; i < buffers.size(); ++i)
+            {
+                buffer_footprint buffer;
+                buffer.name = buffer_name(proxy.data_type(), i, buffers.size());
+                buffer.data = buffers[i].data();
+                buffer.size = buffers[i].size();
+                buffer.capacity = buffer.size;
+                if (private_data != nullptr && i < private_data->buffers().size())
+                {
+                    const auto& stored = private_data->buffers()[i];
+                    if (static_cast<const void*>(stored.data()) == buffer.data)
+                    {
+                        buffer.capacity = std::max(buffer.size, stored.capacity());
+                        buffer.owned = owns_array;
+                    }
+                }
+                result.buffers.push_back(buffer);
+            }
+
+            // The children and the dictionary are released with the array
+            const bool owns_descendants = owns_array && created_with_sparrow;
+            const auto& children = proxy.children();
+            result.children.reserve(children.size());
+            for (const auto& child : children)
+            {
+                result.children.push_back(collect_footprint(child, owns_descendants));
+            }
+            if (const auto& dictionary = proxy.dictionary(); dictionary.has_value())
+            {
+                result.dictionary.push_back(collect_footprint(*dictionary, owns_descendants));
+            }
+
+            return result;
+        }
+
+        template <class F>
+        std::size_t accumulate_buffers(const memory_footprint& footprint, F&& bytes_of)
+        {
+            std::size_t result = 0;
+            for (const auto& buffer : footprint.buffers)
+            {
+                result += bytes_of(buffer);
+            }
+            for (const auto& child : footprint.children)
+            {
+                result += accumulate_buffers(child, bytes_of);
+            }
+            for (const auto& dictionary : footprint.dictionary)
+            {
+                result += accumulate_buffers(dictionary, bytes_of);
+            }
+            return result;
+        }
+    }
+
+    std::size_t memory_footprint::total_bytes() const
+    {
+        return accumulate_buffers(
+            *this,
+            [](const buffer_footprint& buffer)
+            {
+                return buffer.size;
+            }
+        );
+    }
+
+    std::size_t memory_footprint::owned_bytes() const
+    {
+        return accumulate_buffers(
+            *this,
+            [](const buffer_footprint& buffer)
+            {
+                return buffer.owned ? buffer.size : std::size_t{0};
+            }
+        );
+    }
+
+    std::size_t memory_footprint::shared_bytes() const
+    {
+        return accumulate_buffers(
+            *this,
+            [](const buffer_footprint& buffer)
+            {
+                return buffer.owned ? std::size_t{0} : buffer.size;
+            }
+        );
+    }
+
+    std::size_t memory_footprint::slack_bytes() const
+    {
+        return accumulate_buffers(
+            *this,
+            [](const buffer_footprint& buffer)
+            {
+                return buffer.capacity - buffer.size;
+            }
+        );
+    }
+
+    memory_footprint get_memory_footprint(const sparrow::arrow_proxy& proxy)
+    {
+        memory_footprint result = collect_footprint(proxy, proxy.owns_array());
+
+        // A buffer referenced from several places of the tree is shared by all of them
+        std::unordered_map<const void*, std::size_t> reference_counts;
+        for_each_buffer(
+            result,
+            [&reference_counts](buffer_footprint& buffer)
+            {
+                if (buffer.data != nullptr && buffer.size != 0)
+                {
+                    ++reference_counts[buffer.data];
+                }
+            }
+        );
+        for_each_buffer(
+            result,
+            [&reference_counts](buffer_footprint& buffer)
+            {
+                if (buffer.owned && reference_counts[buffer.data] > 1)
+                {
+                    buffer.owned = false;
+                }
+            }
+        );
+        return result;
+    }
+}
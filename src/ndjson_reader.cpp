@@ -0,0 +1,390 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sparrow_extensions/ndjson_reader.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+#include "sparrow/buffer/u8_buffer.hpp"
+#include "sparrow/layout/array_access.hpp"
+
+#include "sparrow_extensions/json_kernels.hpp"
+#include "sparrow_extensions/parallel.hpp"
+
+namespace sparrow_extensions
+{
+    namespace
+    {
+        // Minimum number of bytes scanned by each thread for line terminators
+        constexpr std::size_t ndjson_scan_grain_size = std::size_t{1} << 20;
+
+        // Minimum number of lines copied by each thread
+        constexpr std::size_t ndjson_copy_grain_size = 4096;
+
+        [[noreturn]] void throw_file_error(const std::filesystem::path& path)
+        {
+            throw std::runtime_error("read_ndjson: cannot map the file '" + path.string() + "'");
+        }
+
+        // Read-only mapping of a whole file, unmapped on destruction
+        class file_mapping
+        {
+        public:
+
+            explicit file_mapping(const std::filesystem::path& path)
+            {
+#if defined(_WIN32)
+                m_file = ::CreateFileW(
+                    path.c_str(),
+                    GENERIC_READ,
+                    FILE_SHARE_READ,
+                    nullptr,
+                    OPEN_EXISTING,
+                    FILE_ATTRIBUTE_NORMAL,
+                    nullptr
+                );
+                LARGE_INTEGER size{};
+                if (m_file == INVALID_HANDLE_VALUE || ::GetFileSizeEx(m_file, &size) == 0)
+                {
+                    close();
+                    throw_file_error(path);
+                }
+                m_size = static_cast<std::size_t>(size.QuadPart);
+                if (m_size > 0)
+                {
+                    m_mapping = ::CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                    const void* view = m_mapping != nullptr
+                                           ? ::MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0)
+                                           : nullptr;
+                    if (view == nullptr)
+                    {
+                        close();
+                        throw_file_error(path);
+                    }
+                    m_data = static_cast<const char*>(view);
+                }
+#else
+                const int file = ::open(path.c_str(), O_RDONLY);
+                struct stat status{};
+                if (file < 0 || ::fstat(file, &status) != 0)
+                {
+                    if (file >= 0)
+                    {
+                        ::close(file);
+                    }
+                    throw_file_error(path);
+                }
+                m_size = static_cast<std::size_t>(status.st_size);
+                void* address = m_size > 0 ? ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file, 0)
+                                           : nullptr;
+                // The mapping keeps the file open
+                ::close(file);
+                if (address == MAP_FAILED)
+                {
+                    throw_file_error(path);
+                }
+                m_data = static_cast<const char*>(address);
+#endif
+            }
+
+            ~file_mapping()
+            {
+                close();
+            }
+
+            file_mapping(const file_mapping&) = delete;
+            file_mapping& operator=(const file_mapping&) = delete;
+
+            [[nodiscard]] std::string_view data() const
+            {
+                return {m_data, m_size};
+            }
+
+        private:
+
+            void close() noexcept
+            {
+#if defined(_WIN32)
+                if (m_data != nullptr)
+                {
+                    ::UnmapViewOfFile(m_data);
+                }
+                if (m_mapping != nullptr)
+                {
+                    ::CloseHandle(m_mapping);
+                }
+                if (m_file != INVALID_HANDLE_VALUE)
+                {
+                    ::CloseHandle(m_file);
+                }
+#else
+                if (m_data != nullptr)
+                {
+                    ::munmap(const_cast<char*>(m_data), m_size);
+                }
+#endif
+                m_data = nullptr;
+            }
+
+            const char* m_data = nullptr;
+            std::size_t m_size = 0;
+#if defined(_WIN32)
+            HANDLE m_file = INVALID_HANDLE_VALUE;
+            HANDLE m_mapping = nullptr;
+#endif
+        };
+
+        // Characters of a line, without its terminator
+        struct ndjson_line
+        {
+            std::size_t begin = 0;
+            std::size_t end = 0;
+        };
+
+        // Position past each line feed of the data; the chunks are scanned in parallel with
+        // memchr, which the C libraries vectorise
+        std::vector<std::size_t> find_line_feeds(std::string_view data)
+        {
+            const std::size_t chunk_count = (data.size() + ndjson_scan_grain_size - 1)
+                                            / ndjson_scan_grain_size;
+            std::vector<std::vector<std::size_t>> chunk_line_feeds(chunk_count);
+            detail::parallel_for(
+                chunk_count,
+                1,
+                [&](std::size_t first_chunk, std::size_t last_chunk)
+                {
+                    for (std::size_t c = first_chunk; c < last_chunk; ++c)
+                    {
+                        const std::size_t begin = c * ndjson_scan_grain_size;
+                        const std::size_t end = std::min(begin + ndjson_scan_grain_size, data.size());
+                        const char* const first = data.data();
+                        std::size_t position = begin;
+                        while (const void* line_feed = std::memchr(first + position, '\n', end - position))
+                        {
+                            const auto* character = static_cast<const char*>(line_feed);
+                            position = static_cast<std::size_t>(character - first) + 1;
+                            chunk_line_feeds[c].push_back(position);
+                        }
+                    }
+                }
+            );
+
+            std::size_t line_feed_count = 0;
+            for (const auto& line_feeds : chunk_line_feeds)
+            {
+                line_feed_count += line_feeds.size();
+            }
+            std::vector<std::size_t> result;
+            result.reserve(line_feed_count);
+            for (const auto& line_feeds : chunk_line_feeds)
+            {
+                result.insert(result.end(), line_feeds.begin(), line_feeds.end());
+            }
+            return result;
+        }
+
+        bool is_blank(std::string_view line)
+        {
+            return line.find_first_not_of(" \t\r\n") == std::string_view::npos;
+        }
+
+        // Lines of the data that are not blank
+        std::vector<ndjson_line> find_lines(std::string_view data)
+        {
+            auto line_feeds = find_line_feeds(data);
+            if (!data.empty() && data.back() != '\n')
+            {
+                line_feeds.push_back(data.size());
+            }
+            std::vector<ndjson_line> result;
+            result.reserve(line_feeds.size());
+            std::size_t begin = 0;
+            for (const auto line_feed : line_feeds)
+            {
+                const auto line = data.substr(begin, line_feed - begin);
+                if (!is_blank(line))
+                {
+                    const auto terminator_size = line.size() - line.find_last_not_of("\r\n") - 1;
+                    result.push_back({begin, line_feed - terminator_size});
+                }
+                begin = line_feed;
+            }
+            return result;
+        }
+
+        template <class A>
+        constexpr bool is_big_json_array = std::is_same_v<A, big_json_array>;
+
+        // Storage of an array whose data buffer is a file mapping, freed by the release
+        // callback of the array
+        template <class O>
+        struct mapped_json_storage
+        {
+            std::unique_ptr<file_mapping> mapping;
+            std::vector<O> offsets;
+            std::array<const void*, 3> buffers{};
+        };
+
+        template <class O>
+        void release_mapped_json(ArrowArray* array)
+        {
+            delete static_cast<mapped_json_storage<O>*>(array->private_data);
+            array->private_data = nullptr;
+            array->release = nullptr;
+        }
+
+        // Array of the lines whose data buffer is the mapping: each value starts at the
+        // beginning of a line and ends at the beginning of the next value
+        template <class A>
+        A make_mapped_json_array(std::unique_ptr<file_mapping> mapping, const std::vector<ndjson_line>& lines)
+        {
+            using offset_type = std::conditional_t<is_big_json_array<A>, std::int64_t, std::int32_t>;
+            const std::string_view data = mapping->data();
+            auto storage = std::make_unique<mapped_json_storage<offset_type>>();
+            storage->offsets.reserve(lines.size() + 1);
+            for (const auto& line : lines)
+            {
+                storage->offsets.push_back(static_cast<offset_type>(line.begin));
+            }
+            storage->offsets.push_back(static_cast<offset_type>(data.size()));
+            storage->buffers = {nullptr, storage->offsets.data(), data.data()};
+            storage->mapping = std::move(mapping);
+
+            // The schema, with the extension metadata, is the one of an empty array
+            A empty_array(std::vector<std::string>{});
+            ArrowSchema schema = sparrow::detail::array_access::get_arrow_proxy(empty_array).extract_schema();
+
+            ArrowArray array{};
+            array.length = static_cast<std::int64_t>(lines.size());
+            array.null_count = 0;
+            array.offset = 0;
+            array.n_buffers = 3;
+            array.n_children = 0;
+            array.buffers = storage->buffers.data();
+            array.children = nullptr;
+            array.dictionary = nullptr;
+            array.release = release_mapped_json<offset_type>;
+            array.private_data = storage.release();
+            return A(sparrow::arrow_proxy(std::move(array), std::move(schema)));
+        }
+
+        // Array of the lines copied without their terminator
+        template <class A>
+        A make_trimmed_json_array(std::string_view data, const std::vector<ndjson_line>& lines)
+        {
+            using offset_type = std::conditional_t<is_big_json_array<A>, std::int64_t, std::int32_t>;
+            sparrow::u8_buffer<offset_type> offsets(lines.size() + 1, offset_type{0});
+            offset_type* offsets_data = offsets.data();
+            std::size_t character_count = 0;
+            for (std::size_t i = 0; i < lines.size(); ++i)
+            {
+                character_count += lines[i].end - lines[i].begin;
+                offsets_data[i + 1] = static_cast<offset_type>(character_count);
+            }
+
+            sparrow::u8_buffer<char> characters(character_count, '\0');
+            char* characters_data = characters.data();
+            detail::parallel_for(
+                lines.size(),
+                ndjson_copy_grain_size,
+                [&](std::size_t begin, std::size_t end)
+                {
+                    for (std::size_t i = begin; i < end; ++i)
+                    {
+                        std::ranges::copy(
+                            data.substr(lines[i].begin, lines[i].end - lines[i].begin),
+                            characters_data + offsets_data[i]
+                        );
+                    }
+                }
+            );
+            return A(std::move(characters), std::move(offsets), std::vector<bool>(lines.size(), true));
+        }
+
+        template <class A>
+        A make_ndjson_array(
+            std::unique_ptr<file_mapping> mapping,
+            const std::vector<ndjson_line>& lines,
+            const ndjson_read_options& options
+        )
+        {
+            const std::string_view data = mapping->data();
+            A result = options.trim_line_endings ? make_trimmed_json_array<A>(data, lines)
+                                                 : make_mapped_json_array<A>(std::move(mapping), lines);
+            if (options.validate)
+            {
+                if (const auto error = validate_json(result); error.has_value())
+                {
+                    const auto line_begin = static_cast<std::ptrdiff_t>(lines[error->row].begin);
+                    const auto line_number = std::count(data.begin(), data.begin() + line_begin, '\n') + 1;
+                    throw std::runtime_error(
+                        "read_ndjson: line " + std::to_string(line_number)
+                        + " is not a valid JSON document: " + error->reason
+                    );
+                }
+            }
+            return result;
+        }
+    }
+
+    ndjson_array read_ndjson(const std::filesystem::path& path, const ndjson_read_options& options)
+    {
+        auto mapping = std::make_unique<file_mapping>(path);
+        const auto lines = find_lines(mapping->data());
+        if (lines.empty())
+        {
+            return json_array(std::vector<std::string>{});
+        }
+
+        // The offsets of a mapped array index the whole file, those of a trimmed one the
+        // characters of the lines
+        std::size_t data_size = mapping->data().size();
+        if (options.trim_line_endings)
+        {
+            data_size = 0;
+            for (const auto& line : lines)
+            {
+                data_size += line.end - line.begin;
+            }
+        }
+        if (data_size > static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max()))
+        {
+            return make_ndjson_array<big_json_array>(std::move(mapping), lines, options);
+        }
+        return make_ndjson_array<json_array>(std::move(mapping), lines, options);
+    }
+}
@@ -0,0 +1,95 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sparrow_extensions/parallel.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace sparrow_extensions::detail
+{
+    void parallel_for(
+        std::size_t count,
+        std::size_t grain_size,
+        const std::function<void(std::size_t, std::size_t)>& body
+    )
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+        const std::size_t hardware_threads = 1;
+#else
+        const std::size_t hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+#endif
+        const std::size_t max_chunks = std::max<std::size_t>(1, count / std::max<std::size_t>(1, grain_size));
+        const std::size_t chunk_count = std::min(hardware_threads, max_chunks);
+        if (chunk_count == 1)
+        {
+            body(0, count);
+            return;
+        }
+
+        const std::size_t chunk_size = (count + chunk_count - 1) / chunk_count;
+        std::exception_ptr first_error;
+        std::mutex error_mutex;
+        const auto run_chunk = [&](std::size_t begin, std::size_t end)
+        {
+            try
+            {
+                body(begin, end);
+            }
+            catch (...)
+            {
+                const std::lock_guard<std::mutex> lock(error_mutex);
+                if (!first_error)
+                {
+                    first_error = std::current_exception();
+                }
+            }
+        };
+
+        std::vector<std::thread> workers;
+        workers.reserve(chunk_count - 1);
+        for (std::size_t begin = chunk_size; begin < count; begin += chunk_size)
+        {
+            const std::size_t end = std::min(begin + chunk_size, count);
+            try
+            {
+                workers.emplace_back(run_chunk, begin, end);
+            }
+            catch (const std::system_error&)
+            {
+                // No more threads available, process the chunk on the calling thread
+                run_chunk(begin, end);
+            }
+        }
+        run_chunk(0, std::min(chunk_size, count));
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+
+        if (first_error)
+        {
+            std::rethrow_exception(first_error);
+        }
+    }
+}
@@ -0,0 +1,47 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sparrow_extensions/registration.hpp"
+
+namespace sparrow_extensions
+{
+    void register_extensions(extension_kind kinds)
+    {
+        const auto has_kind = [kinds](extension_kind kind)
+        {
+            return (kinds & kind) != extension_kind::none;
+        };
+
+        if (has_kind(extension_kind::bool8))
+        {
+            register_bool8_extension();
+        }
+        if (has_kind(extension_kind::uuid))
+        {
+            register_uuid_extension();
+        }
+        if (has_kind(extension_kind::json))
+        {
+            register_json_extension();
+        }
+        if (has_kind(extension_kind::fixed_shape_tensor))
+        {
+            register_fixed_shape_tensor_extension();
+        }
+        if (has_kind(extension_kind::variable_shape_tensor))
+        {
+            register_variable_shape_tensor_extension();
+        }
+    }
+}
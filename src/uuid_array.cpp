@@ -14,27 +14,50 @@
 
 #include "sparrow_extensions/uuid_array.hpp"
 
+#include <mutex>
+
 #include "sparrow/layout/array_registry.hpp"
 
+#include "sparrow_extensions/allocation_tracker.hpp"
 #include "sparrow_extensions/config/config.hpp"
+#include "sparrow_extensions/registration.hpp"
 
-namespace sparrow::detail
+namespace sparrow_extensions
 {
-    SPARROW_EXTENSIONS_API const bool uuid_array_registered = []()
+    void register_uuid_extension()
     {
-        auto& registry = array_registry::instance();
-
-        registry.register_extension(
-            data_type::FIXED_WIDTH_BINARY,
-            "arrow.uuid",
-            [](arrow_proxy proxy)
+        static std::once_flag registered;
+        std::call_once(
+            registered,
+            []()
             {
-                return cloning_ptr<array_wrapper>{new array_wrapper_impl<sparrow_extensions::uuid_array>(
-                    sparrow_extensions::uuid_array(std::move(proxy))
-                )};
+                auto& registry = sparrow::array_registry::instance();
+
+                registry.register_extension(
+                    sparrow::data_type::FIXED_WIDTH_BINARY,
+                    "arrow.uuid",
+                    [](sparrow::arrow_proxy proxy)
+                    {
+                        SPARROW_EXTENSIONS_ALLOCATION_SITE("uuid_array registry factory");
+                        return sparrow::cloning_ptr<sparrow::array_wrapper>{
+                            new sparrow::array_wrapper_impl<uuid_array>(uuid_array(std::move(proxy)))
+                        };
+                    }
+                );
             }
         );
+    }
+}
 
+namespace sparrow::detail
+{
+#if defined(SPARROW_EXTENSIONS_DISABLE_AUTO_REGISTRATION)
+    SPARROW_EXTENSIONS_API const bool uuid_array_registered = false;
+#else
+    SPARROW_EXTENSIONS_API const bool uuid_array_registered = []()
+    {
+        sparrow_extensions::register_uuid_extension();
         return true;
     }();
+#endif
 }
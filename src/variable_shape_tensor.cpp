@@ -15,8 +15,14 @@
 #include "sparrow_extensions/variable_shape_tensor.hpp"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <mutex>
 #include <ranges>
+#include <span>
 #include <stdexcept>
+#include <utility>
 
 #include <simdjson.h>
 
@@ -25,7 +31,11 @@
 #include "sparrow/layout/array_registry.hpp"
 #include "sparrow/utils/contracts.hpp"
 
+#include "sparrow_extensions/allocation_tracker.hpp"
 #include "sparrow_extensions/config/config.hpp"
+#include "sparrow_extensions/json_parser_pool.hpp"
+#include "sparrow_extensions/parallel.hpp"
+#include "sparrow_extensions/registration.hpp"
 
 namespace sparrow_extensions
 {
@@ -42,6 +52,348 @@ namespace sparrow_extensions
 
         // JSON parsing capacity hints
         constexpr std::size_t typical_tensor_dimensions = 8;  // Typical tensor rank (2-4 dims, reserve 8)
+
+        // Raw buffers of the data and shape children of a variable shape tensor storage
+        struct tensor_buffers
+        {
+            const std::uint8_t* validity = nullptr;
+            std::int64_t row_offset = 0;
+            std::int64_t data_row_offset = 0;
+            // List offsets of the data child, 64-bit if large_offsets is true, 32-bit otherwise
+            const void* data_offsets = nullptr;
+            // List sizes of the data child if it is a ListView, of the same width as the offsets
+            const void* data_sizes = nullptr;
+            bool large_offsets = false;
+            std::int64_t values_offset = 0;
+            const void* values = nullptr;
+            std::int64_t shape_row_offset = 0;
+            const std::int32_t* shapes = nullptr;
+            std::size_t ndim = 0;
+        };
+
+        std::size_t fixed_size_list_size(std::string_view format)
+        {
+            // The format of a FixedSizeList is "+w:<list_size>"
+            std::size_t result = 0;
+            const auto separator = format.find(':');
+            SPARROW_ASSERT_TRUE(separator != std::string_view::npos);
+            std::from_chars(format.data() + separator + 1, format.data() + format.size(), result);
+            return result;
+        }
+
+        tensor_buffers get_tensor_buffers(const sparrow::arrow_proxy& proxy)
+        {
+            const ArrowArray& storage = proxy.array();
+            SPARROW_ASSERT_TRUE(storage.n_children == 2);
+            const ArrowArray& data = *storage.children[0];
+            const ArrowArray& values = *data.children[0];
+            const ArrowArray& shape = *storage.children[1];
+            const ArrowArray& shape_values = *shape.children[0];
+
+            tensor_buffers result;
+            result.validity = static_cast<const std::uint8_t*>(storage.buffers[0]);
+            result.row_offset = storage.offset;
+            result.data_row_offset = storage.offset + data.offset;
+            const std::string_view data_format = proxy.schema().children[0]->format;
+            result.data_offsets = data.buffers[1];
+            result.data_sizes = data_format.starts_with("+v") ? data.buffers[2] : nullptr;
+            result.large_offsets = data_format == "+L" || data_format == "+vL";
+            result.values_offset = values.offset;
+            result.values = values.buffers[1];
+            result.shape_row_offset = storage.offset + shape.offset;
+            result.shapes = static_cast<const std::int32_t*>(shape_values.buffers[1]) + shape_values.offset;
+            result.ndim = fixed_size_list_size(proxy.schema().children[1]->format);
+            return result;
+        }
+
+        template <class O>
+        std::pair<std::int64_t, std::int64_t>
+        typed_list_range(const tensor_buffers& buffers, std::int64_t row)
+        {
+            const auto* offsets = static_cast<const O*>(buffers.data_offsets);
+            if (buffers.data_sizes != nullptr)
+            {
+                const auto* sizes = static_cast<const O*>(buffers.data_sizes);
+                return {offsets[row], static_cast<std::int64_t>(offsets[row]) + sizes[row]};
+            }
+            return {offsets[row], offsets[row + 1]};
+        }
+
+        // Positions of the first element and past the last element of list row of the data child
+        std::pair<std::int64_t, std::int64_t> list_range(const tensor_buffers& buffers, std::int64_t row)
+        {
+            return buffers.large_offsets ? typed_list_range<std::int64_t>(buffers, row)
+                                         : typed_list_range<std::int32_t>(buffers, row);
+        }
+
+        bool is_valid_row(const tensor_buffers& buffers, std::size_t i)
+        {
+            if (buffers.validity == nullptr)
+            {
+                return true;
+            }
+            const auto bit = static_cast<std::size_t>(buffers.row_offset) + i;
+            return ((buffers.validity[bit / 8] >> (bit % 8)) & 1) != 0;
+        }
+
+        // Extents of the uniform axes, 0 for the axes whose extent varies between tensors
+        std::vector<std::int32_t> uniform_extents(const variable_shape_tensor_extension::metadata& meta)
+        {
+            std::vector<std::int32_t> result;
+            if (meta.uniform_shape.has_value())
+            {
+                result.reserve(meta.uniform_shape->size());
+                for (const auto& dim : *meta.uniform_shape)
+                {
+                    result.push_back(dim.value_or(0));
+                }
+            }
+            return result;
+        }
+
+        detail::tensor_location locate_in_buffers(const tensor_buffers& buffers, std::size_t i)
+        {
+            const auto data_row = static_cast<std::int64_t>(i) + buffers.data_row_offset;
+            const auto shape_row = static_cast<std::int64_t>(i) + buffers.shape_row_offset;
+            const auto [begin, end] = list_range(buffers, data_row);
+
+            detail::tensor_location result;
+            result.values = buffers.values;
+            result.element_offset = buffers.values_offset + begin;
+            result.element_count = end - begin;
+            result.shape = {
+                buffers.shapes + static_cast<std::size_t>(shape_row) * buffers.ndim,
+                buffers.ndim
+            };
+            return result;
+        }
+
+        // Minimum number of rows checked by each thread during the full validation
+        constexpr std::size_t validation_grain_size = 16384;
+
+        // Checks that the product of positive extents is element_count, without overflowing:
+        // past element_count / dim, multiplying by dim would exceed element_count
+        bool shape_matches_element_count(std::span<const std::int32_t> shape, std::int64_t element_count)
+        {
+            std::int64_t shape_element_count = 1;
+            for (const auto dim : shape)
+            {
+                if (shape_element_count > element_count / dim)
+                {
+                    return false;
+                }
+                shape_element_count *= dim;
+            }
+            return shape_element_count == element_count;
+        }
+
+        // Reason why row i violates the layout constraints, empty if it is valid
+        std::string_view check_tensor_row(
+            const tensor_buffers& buffers,
+            const std::vector<std::int32_t>& uniform,
+            std::int64_t values_length,
+            std::size_t i
+        )
+        {
+            const auto data_row = static_cast<std::int64_t>(i) + buffers.data_row_offset;
+            const auto [begin, end] = list_range(buffers, data_row);
+            if (begin < 0 || end < begin || end > values_length)
+            {
+                return "the list offsets or sizes are out of the values";
+            }
+            if (!is_valid_row(buffers, i))
+            {
+                return {};
+            }
+
+            const auto shape = locate_in_buffers(buffers, i).shape;
+            if (std::ranges::any_of(shape, [](std::int32_t dim) { return dim <= 0; }))
+            {
+                return "the shape extents must be positive";
+            }
+            if (!shape_matches_element_count(shape, end - begin))
+            {
+                return "the number of elements does not match the shape";
+            }
+            for (std::size_t axis = 0; axis < uniform.size(); ++axis)
+            {
+                if (uniform[axis] != 0 && shape[axis] != uniform[axis])
+                {
+                    return "the shape does not match uniform_shape";
+                }
+            }
+            return {};
+        }
+
+        // Checks the list ranges of rows [begin, end) over the whole offsets (and sizes)
+        // buffers at once: the conditions are accumulated without branching, so that the
+        // loops vectorise
+        template <class O>
+        bool are_list_ranges_valid(
+            const tensor_buffers& buffers,
+            std::int64_t values_length,
+            std::size_t begin,
+            std::size_t end
+        )
+        {
+            const auto row_offset = static_cast<std::size_t>(buffers.data_row_offset);
+            const O* offsets = static_cast<const O*>(buffers.data_offsets) + row_offset;
+            bool valid = true;
+            if (buffers.data_sizes == nullptr)
+            {
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    const std::int64_t first = offsets[i];
+                    const std::int64_t last = offsets[i + 1];
+                    valid &= (first >= 0) & (last >= first) & (last <= values_length);
+                }
+                return valid;
+            }
+            const O* sizes = static_cast<const O*>(buffers.data_sizes) + row_offset;
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                const std::int64_t first = offsets[i];
+                const std::int64_t last = first + sizes[i];
+                valid &= (first >= 0) & (last >= first) & (last <= values_length);
+            }
+            return valid;
+        }
+
+        // Checks the extents of rows [begin, end) over the whole shape buffer at once: they
+        // must be positive and match the uniform extents. The extents of the null rows are
+        // checked too, so a failure only means that the rows must be checked one by one
+        bool are_extents_valid(
+            const tensor_buffers& buffers,
+            const std::vector<std::int32_t>& uniform,
+            std::size_t begin,
+            std::size_t end
+        )
+        {
+            const std::size_t ndim = buffers.ndim;
+            const auto first_row = static_cast<std::size_t>(buffers.shape_row_offset) + begin;
+            const std::int32_t* extents = buffers.shapes + first_row * ndim;
+            const std::size_t extent_count = (end - begin) * ndim;
+            bool valid = true;
+            for (std::size_t k = 0; k < extent_count; ++k)
+            {
+                valid &= extents[k] > 0;
+            }
+            for (std::size_t axis = 0; axis < uniform.size(); ++axis)
+            {
+                if (uniform[axis] != 0)
+                {
+                    for (std::size_t k = axis; k < extent_count; k += ndim)
+                    {
+                        valid &= extents[k] == uniform[axis];
+                    }
+                }
+            }
+            return valid;
+        }
+
+        // Checks rows [begin, end) with buffer-wide passes over the offsets and the shapes,
+        // which leave only the element counts to be checked row by row
+        bool are_rows_well_formed(
+            const tensor_buffers& buffers,
+            const std::vector<std::int32_t>& uniform,
+            std::int64_t values_length,
+            std::size_t begin,
+            std::size_t end
+        )
+        {
+            const bool valid_ranges =
+                buffers.large_offsets
+                    ? are_list_ranges_valid<std::int64_t>(buffers, values_length, begin, end)
+                    : are_list_ranges_valid<std::int32_t>(buffers, values_length, begin, end);
+            return valid_ranges && are_extents_valid(buffers, uniform, begin, end);
+        }
+
+        std::shared_ptr<const variable_shape_tensor_index> make_index(
+            const tensor_buffers& buffers,
+            const variable_shape_tensor_extension::metadata& meta,
+            std::size_t tensor_count
+        )
+        {
+            const auto uniform = uniform_extents(meta);
+            SPARROW_ASSERT_TRUE(uniform.empty() || uniform.size() == buffers.ndim);
+            const bool fully_uniform = !uniform.empty() && std::ranges::find(uniform, 0) == uniform.end();
+
+            auto tensor_index = std::make_shared<variable_shape_tensor_index>();
+            tensor_index->ndim = buffers.ndim;
+            tensor_index->uniform = fully_uniform;
+            for (std::size_t axis = 0; axis < buffers.ndim; ++axis)
+            {
+                if (uniform.empty() || uniform[axis] == 0)
+                {
+                    tensor_index->varying_axes.push_back(axis);
+                }
+            }
+            // Walks the axes backwards while they are uniform, the strides stay constant
+            tensor_index->constant_strides.assign(buffers.ndim, 0);
+            std::int64_t constant_stride = 1;
+            for (std::size_t axis = buffers.ndim; axis-- > 0;)
+            {
+                tensor_index->constant_strides[axis] = constant_stride;
+                if (uniform.empty() || uniform[axis] == 0)
+                {
+                    break;
+                }
+                constant_stride *= uniform[axis];
+            }
+            tensor_index->element_offsets.resize(tensor_count);
+            tensor_index->element_counts.resize(tensor_count);
+            if (buffers.validity != nullptr)
+            {
+                tensor_index->validity.resize(tensor_count);
+                for (std::size_t i = 0; i < tensor_count; ++i)
+                {
+                    tensor_index->validity[i] = is_valid_row(buffers, i);
+                }
+            }
+
+            if (fully_uniform)
+            {
+                // All the tensors share the shape from the metadata, the shape child is not read
+                tensor_index->shapes = uniform;
+                for (std::size_t i = 0; i < tensor_count; ++i)
+                {
+                    const auto location = locate_in_buffers(buffers, i);
+                    tensor_index->element_offsets[i] = location.element_offset;
+                    tensor_index->element_counts[i] = location.element_count;
+                }
+            }
+            else
+            {
+                // The shapes start as copies of uniform_shape, only the varying axes are
+                // read from the shape child
+                const std::size_t ndim = buffers.ndim;
+                auto& shapes = tensor_index->shapes;
+                if (uniform.empty())
+                {
+                    shapes.resize(tensor_count * ndim);
+                }
+                else
+                {
+                    shapes.reserve(tensor_count * ndim);
+                    for (std::size_t i = 0; i < tensor_count; ++i)
+                    {
+                        shapes.insert(shapes.end(), uniform.begin(), uniform.end());
+                    }
+                }
+                for (std::size_t i = 0; i < tensor_count; ++i)
+                {
+                    const auto location = locate_in_buffers(buffers, i);
+                    tensor_index->element_offsets[i] = location.element_offset;
+                    tensor_index->element_counts[i] = location.element_count;
+                    std::int32_t* shape = shapes.data() + i * ndim;
+                    for (const auto axis : tensor_index->varying_axes)
+                    {
+                        shape[axis] = location.shape[axis];
+                    }
+                }
+            }
+            return tensor_index;
+        }
     }
 
     // Metadata implementation
@@ -124,6 +476,8 @@ namespace sparrow_extensions
 
     std::string variable_shape_tensor_extension::metadata::to_json() const
     {
+        SPARROW_EXTENSIONS_ALLOCATION_SITE("variable_shape_tensor_extension::metadata::to_json");
+
         // Check if metadata is empty
         if (!dim_names.has_value() && !permutation.has_value() && !uniform_shape.has_value())
         {
@@ -248,6 +602,8 @@ namespace sparrow_extensions
     variable_shape_tensor_extension::metadata
     variable_shape_tensor_extension::metadata::from_json(std::string_view json)
     {
+        SPARROW_EXTENSIONS_ALLOCATION_SITE("variable_shape_tensor_extension::metadata::from_json");
+
         // Handle empty or minimal JSON
         if (json.empty() || json == "{}")
         {
@@ -258,8 +614,8 @@ namespace sparrow_extensions
         {
             metadata result;
 
-            simdjson::dom::parser parser;
-            simdjson::dom::element doc = parser.parse(json);
+            auto parser = detail::dom_parser_pool().acquire();
+            simdjson::dom::element doc = parser->parse(json);
 
             // Parse optional fields
             if (doc["dim_names"].error() == simdjson::SUCCESS)
@@ -311,6 +667,7 @@ namespace sparrow_extensions
 
     void variable_shape_tensor_extension::init(sparrow::arrow_proxy& proxy, const metadata& tensor_metadata)
     {
+        SPARROW_EXTENSIONS_ALLOCATION_SITE("variable_shape_tensor_extension::init");
         SPARROW_ASSERT_TRUE(tensor_metadata.is_valid());
 
         // Get existing metadata
@@ -350,6 +707,8 @@ namespace sparrow_extensions
     variable_shape_tensor_extension::metadata
     variable_shape_tensor_extension::extract_metadata(const sparrow::arrow_proxy& proxy)
     {
+        SPARROW_EXTENSIONS_ALLOCATION_SITE("variable_shape_tensor_extension::extract_metadata");
+
         const auto metadata_opt = proxy.metadata();
         if (!metadata_opt.has_value())
         {
@@ -372,9 +731,20 @@ namespace sparrow_extensions
 
     variable_shape_tensor_array::variable_shape_tensor_array(sparrow::arrow_proxy proxy)
         : m_storage(proxy)
-        , m_metadata(variable_shape_tensor_extension::extract_metadata(proxy))
+        , m_metadata(
+              std::make_shared<const metadata_type>(variable_shape_tensor_extension::extract_metadata(proxy))
+          )
+    {
+        SPARROW_ASSERT_TRUE(m_metadata->is_valid());
+    }
+
+    variable_shape_tensor_array::variable_shape_tensor_array(
+        sparrow::struct_array&& storage,
+        std::shared_ptr<const metadata_type> tensor_metadata
+    )
+        : m_storage(std::move(storage))
+        , m_metadata(std::move(tensor_metadata))
     {
-        SPARROW_ASSERT_TRUE(m_metadata.is_valid());
     }
 
     variable_shape_tensor_array::variable_shape_tensor_array(
@@ -384,7 +754,7 @@ namespace sparrow_extensions
         const metadata_type& tensor_metadata
     )
         : m_storage(detail::make_tensor_struct(std::move(tensor_data), std::move(tensor_shapes)))
-        , m_metadata(tensor_metadata)
+        , m_metadata(std::make_shared<const metadata_type>(tensor_metadata))
     {
         validate_and_init(ndim);
     }
@@ -398,7 +768,7 @@ namespace sparrow_extensions
         std::optional<std::vector<sparrow::metadata_pair>> arrow_metadata
     )
         : m_storage(detail::make_tensor_struct(std::move(tensor_data), std::move(tensor_shapes)))
-        , m_metadata(tensor_metadata)
+        , m_metadata(std::make_shared<const metadata_type>(tensor_metadata))
     {
         validate_and_init(ndim, name, arrow_metadata.has_value() ? &arrow_metadata : nullptr);
     }
@@ -410,12 +780,12 @@ namespace sparrow_extensions
 
     auto variable_shape_tensor_array::get_metadata() const -> const metadata_type&
     {
-        return m_metadata;
+        return *m_metadata;
     }
 
     std::optional<std::size_t> variable_shape_tensor_array::ndim() const
     {
-        return m_metadata.get_ndim();
+        return m_metadata->get_ndim();
     }
 
     const sparrow::struct_array& variable_shape_tensor_array::storage() const
@@ -425,6 +795,7 @@ namespace sparrow_extensions
 
     sparrow::struct_array& variable_shape_tensor_array::storage()
     {
+        m_index.reset();
         return m_storage;
     }
 
@@ -435,6 +806,7 @@ namespace sparrow_extensions
 
     auto variable_shape_tensor_array::get_arrow_proxy() -> sparrow::arrow_proxy&
     {
+        m_index.reset();
         return sparrow::detail::array_access::get_arrow_proxy(m_storage);
     }
 
@@ -444,14 +816,18 @@ namespace sparrow_extensions
         std::optional<std::vector<sparrow::metadata_pair>>* arrow_metadata
     )
     {
-        SPARROW_ASSERT_TRUE(m_metadata.is_valid());
+        SPARROW_ASSERT_TRUE(m_metadata->is_valid());
 
         // Validate ndim if metadata provides it
-        if (const auto metadata_ndim = m_metadata.get_ndim(); metadata_ndim.has_value())
+        if (const auto metadata_ndim = m_metadata->get_ndim(); metadata_ndim.has_value())
         {
             SPARROW_ASSERT_TRUE(ndim == *metadata_ndim);
         }
 
+        // Validate the shape child against ndim and the uniform dimensions
+        SPARROW_ASSERT_TRUE(get_tensor_buffers(get_arrow_proxy()).ndim == ndim);
+        SPARROW_ASSERT_TRUE(conforms_to_uniform_shape());
+
         auto& proxy = sparrow::detail::array_access::get_arrow_proxy(m_storage);
 
         if (name.has_value())
@@ -464,7 +840,7 @@ namespace sparrow_extensions
             proxy.set_metadata(std::make_optional(**arrow_metadata));
         }
 
-        variable_shape_tensor_extension::init(proxy, m_metadata);
+        variable_shape_tensor_extension::init(proxy, *m_metadata);
     }
 
     const sparrow::array_wrapper* variable_shape_tensor_array::data_child() const
@@ -487,6 +863,122 @@ namespace sparrow_extensions
         return m_storage.raw_child(1);
     }
 
+    const variable_shape_tensor_index& variable_shape_tensor_array::build_index()
+    {
+        if (m_index == nullptr)
+        {
+            // The const overload of get_arrow_proxy does not drop the index
+            const auto buffers = get_tensor_buffers(std::as_const(*this).get_arrow_proxy());
+            m_index = make_index(buffers, *m_metadata, size());
+        }
+        return *m_index;
+    }
+
+    std::shared_ptr<const variable_shape_tensor_index> variable_shape_tensor_array::layout() const
+    {
+        if (m_index != nullptr)
+        {
+            return m_index;
+        }
+        return make_index(get_tensor_buffers(get_arrow_proxy()), *m_metadata, size());
+    }
+
+    bool variable_shape_tensor_array::has_index() const
+    {
+        return m_index != nullptr;
+    }
+
+    const variable_shape_tensor_index& variable_shape_tensor_array::index() const
+    {
+        SPARROW_ASSERT_TRUE(has_index());
+        return *m_index;
+    }
+
+    bool variable_shape_tensor_array::conforms_to_uniform_shape() const
+    {
+        const auto uniform = uniform_extents(*m_metadata);
+        if (uniform.empty() || empty())
+        {
+            return true;
+        }
+
+        const auto buffers = get_tensor_buffers(get_arrow_proxy());
+        if (uniform.size() != buffers.ndim)
+        {
+            return false;
+        }
+
+        std::vector<std::size_t> uniform_axes;
+        for (std::size_t axis = 0; axis < uniform.size(); ++axis)
+        {
+            if (uniform[axis] != 0)
+            {
+                uniform_axes.push_back(axis);
+            }
+        }
+
+        for (size_type i = 0; i < size(); ++i)
+        {
+            if (!is_valid_row(buffers, i))
+            {
+                continue;
+            }
+            const auto shape = locate_in_buffers(buffers, i).shape;
+            for (const auto axis : uniform_axes)
+            {
+                if (shape[axis] != uniform[axis])
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    std::span<const std::int32_t> variable_shape_tensor_array::tensor_shape(size_type i) const
+    {
+        SPARROW_ASSERT_TRUE(i < size());
+        if (m_index != nullptr)
+        {
+            return m_index->shape(i);
+        }
+        return locate_in_buffers(get_tensor_buffers(get_arrow_proxy()), i).shape;
+    }
+
+    detail::tensor_location variable_shape_tensor_array::locate_tensor(size_type i) const
+    {
+        SPARROW_ASSERT_TRUE(i < size());
+        const auto& proxy = get_arrow_proxy();
+        detail::tensor_location result;
+        if (m_index != nullptr)
+        {
+            result.values = proxy.array().children[0]->children[0]->buffers[1];
+            result.element_offset = m_index->element_offsets[i];
+            result.element_count = m_index->element_counts[i];
+            result.shape = m_index->shape(i);
+            result.is_valid = m_index->is_valid(i);
+        }
+        else
+        {
+            const auto buffers = get_tensor_buffers(proxy);
+            result = locate_in_buffers(buffers, i);
+            result.is_valid = is_valid_row(buffers, i);
+        }
+        result.value_type = value_type();
+        return result;
+    }
+
+    sparrow::data_type variable_shape_tensor_array::value_type() const
+    {
+        return get_arrow_proxy().children()[0].children()[0].data_type();
+    }
+
+    std::pair<const void*, std::size_t> variable_shape_tensor_array::values_buffer() const
+    {
+        const ArrowArray& values = *get_arrow_proxy().array().children[0]->children[0];
+        return {values.buffers[1], static_cast<std::size_t>(values.offset + values.length)};
+    }
+
     auto variable_shape_tensor_array::at(size_type i) const -> const_reference
     {
         if (i >= size())
@@ -498,7 +990,121 @@ namespace sparrow_extensions
 
     bool variable_shape_tensor_array::is_valid() const
     {
-        return m_storage.children_count() == 2 && m_metadata.is_valid();
+        return m_storage.children_count() == 2 && m_metadata->is_valid();
+    }
+
+    std::optional<tensor_validation_error> variable_shape_tensor_array::validate() const
+    {
+        const auto array_error = [](std::string reason)
+        {
+            return std::make_optional(tensor_validation_error{std::nullopt, std::move(reason)});
+        };
+
+        if (!is_valid())
+        {
+            return array_error("the storage must have 2 children and valid metadata");
+        }
+
+        const auto& proxy = get_arrow_proxy();
+        const ArrowSchema& schema = proxy.schema();
+        const ArrowArray& storage = proxy.array();
+        const ArrowArray& data = *storage.children[0];
+        const ArrowArray& shape = *storage.children[1];
+        const std::string_view data_format = schema.children[0]->format;
+        constexpr std::array<std::string_view, 4> list_formats = {"+l", "+L", "+vl", "+vL"};
+        if (std::ranges::find(list_formats, data_format) == list_formats.end() || data.n_children != 1)
+        {
+            return array_error("the data child must be a List, a LargeList or a ListView");
+        }
+        if (!std::string_view(schema.children[1]->format).starts_with("+w:") || shape.n_children != 1
+            || std::string_view(schema.children[1]->children[0]->format) != "i")
+        {
+            return array_error("the shape child must be a FixedSizeList of int32");
+        }
+
+        const auto buffers = get_tensor_buffers(proxy);
+        if (const auto metadata_ndim = m_metadata->get_ndim();
+            metadata_ndim.has_value() && *metadata_ndim != buffers.ndim)
+        {
+            return array_error("the list size of the shape child does not match the metadata");
+        }
+
+        const ArrowArray& values = *data.children[0];
+        const ArrowArray& shape_values = *shape.children[0];
+        const std::int64_t row_count = storage.offset + storage.length;
+        if (data.length < row_count || shape.length < row_count)
+        {
+            return array_error("the children are shorter than the storage");
+        }
+        if (shape_values.length < (shape.offset + row_count) * static_cast<std::int64_t>(buffers.ndim))
+        {
+            return array_error("the shape values are shorter than the shape child");
+        }
+        if (empty())
+        {
+            return std::nullopt;
+        }
+        const bool missing_sizes = data_format.starts_with("+v") && buffers.data_sizes == nullptr;
+        if (buffers.data_offsets == nullptr || missing_sizes
+            || (buffers.ndim != 0 && shape_values.buffers[1] == nullptr)
+            || (values.length != 0 && buffers.values == nullptr))
+        {
+            return array_error("missing buffer");
+        }
+
+        // Rows are checked in parallel, each thread stops past the first invalid row found so far
+        const auto uniform = uniform_extents(*m_metadata);
+        const std::size_t tensor_count = size();
+        std::atomic<std::size_t> first_invalid_row = tensor_count;
+        detail::parallel_for(
+            tensor_count,
+            validation_grain_size,
+            [&](std::size_t begin, std::size_t end)
+            {
+                const auto already_found = [&first_invalid_row](std::size_t i)
+                {
+                    return i >= first_invalid_row.load(std::memory_order_relaxed);
+                };
+                // Each block is first checked with buffer-wide passes; the rows of a block
+                // that fails them are checked one by one to find the invalid one
+                for (std::size_t block = begin; block < end && !already_found(block);
+                     block += validation_grain_size)
+                {
+                    const std::size_t block_end = std::min(block + validation_grain_size, end);
+                    const bool well_formed =
+                        are_rows_well_formed(buffers, uniform, values.length, block, block_end);
+                    for (std::size_t i = block; i < block_end; ++i)
+                    {
+                        bool invalid = false;
+                        if (!well_formed)
+                        {
+                            invalid = !check_tensor_row(buffers, uniform, values.length, i).empty();
+                        }
+                        else if (is_valid_row(buffers, i))
+                        {
+                            const auto location = locate_in_buffers(buffers, i);
+                            invalid = !shape_matches_element_count(location.shape, location.element_count);
+                        }
+                        if (invalid)
+                        {
+                            auto current = first_invalid_row.load(std::memory_order_relaxed);
+                            while (i < current && !first_invalid_row.compare_exchange_weak(current, i))
+                            {
+                            }
+                            return;
+                        }
+                    }
+                }
+            }
+        );
+
+        const std::size_t row = first_invalid_row.load();
+        if (row == tensor_count)
+        {
+            return std::nullopt;
+        }
+        const auto reason = check_tensor_row(buffers, uniform, values.length, row);
+        return tensor_validation_error{row, std::string(reason)};
     }
 
     auto variable_shape_tensor_array::begin() const -> const_iterator
@@ -541,27 +1147,58 @@ namespace sparrow_extensions
         return m_storage.crend();
     }
 
+    variable_shape_tensor_array variable_shape_tensor_array::slice(size_type start, size_type end) const
+    {
+        SPARROW_ASSERT_TRUE(start <= end && end <= size());
+        return {m_storage.slice(start, end), m_metadata};
+    }
+
+    variable_shape_tensor_array variable_shape_tensor_array::slice_view(size_type start, size_type end) const
+    {
+        SPARROW_ASSERT_TRUE(start <= end && end <= size());
+        return {m_storage.slice_view(start, end), m_metadata};
+    }
+
 }  // namespace sparrow_extensions
 
-namespace sparrow::detail
+namespace sparrow_extensions
 {
-    SPARROW_EXTENSIONS_API const bool variable_shape_tensor_array_registered = []()
+    void register_variable_shape_tensor_extension()
     {
-        auto& registry = array_registry::instance();
-
-        registry.register_extension(
-            data_type::STRUCT,
-            "arrow.variable_shape_tensor",
-            [](arrow_proxy proxy)
+        static std::once_flag registered;
+        std::call_once(
+            registered,
+            []()
             {
-                return cloning_ptr<array_wrapper>{
-                    new array_wrapper_impl<sparrow_extensions::variable_shape_tensor_array>(
-                        sparrow_extensions::variable_shape_tensor_array(std::move(proxy))
-                    )
-                };
+                auto& registry = sparrow::array_registry::instance();
+
+                registry.register_extension(
+                    sparrow::data_type::STRUCT,
+                    "arrow.variable_shape_tensor",
+                    [](sparrow::arrow_proxy proxy)
+                    {
+                        SPARROW_EXTENSIONS_ALLOCATION_SITE("variable_shape_tensor_array registry factory");
+                        return sparrow::cloning_ptr<sparrow::array_wrapper>{
+                            new sparrow::array_wrapper_impl<sparrow_extensions::variable_shape_tensor_array>(
+                                sparrow_extensions::variable_shape_tensor_array(std::move(proxy))
+                            )
+                        };
+                    }
+                );
             }
         );
+    }
+}
 
+namespace sparrow::detail
+{
+#if defined(SPARROW_EXTENSIONS_DISABLE_AUTO_REGISTRATION)
+    SPARROW_EXTENSIONS_API const bool variable_shape_tensor_array_registered = false;
+#else
+    SPARROW_EXTENSIONS_API const bool variable_shape_tensor_array_registered = []()
+    {
+        sparrow_extensions::register_variable_shape_tensor_extension();
         return true;
     }();
+#endif
 }
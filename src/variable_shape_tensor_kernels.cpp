@@ -0,0 +1,1295 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sparrow_extensions/variable_shape_tensor_kernels.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+#include "sparrow/array.hpp"
+#include "sparrow/buffer/u8_buffer.hpp"
+#include "sparrow/list_array.hpp"
+#include "sparrow/primitive_array.hpp"
+#include "sparrow/utils/contracts.hpp"
+
+#include "sparrow_extensions/parallel.hpp"
+#include "sparrow_extensions/variable_shape_tensor_builder.hpp"
+
+namespace sparrow_extensions
+{
+    namespace
+    {
+        // Minimum number of tensors copied by each thread
+        constexpr std::size_t tensor_copy_grain_size = 256;
+
+        // Calls func with std::type_identity<T>, T being the C++ type of the tensor elements
+        template <class F>
+        decltype(auto) visit_value_type(sparrow::data_type value_type, F&& func)
+        {
+            using sparrow::data_type;
+            switch (value_type)
+            {
+                case data_type::INT8:
+                    return func(std::type_identity<std::int8_t>{});
+                case data_type::UINT8:
+                    return func(std::type_identity<std::uint8_t>{});
+                case data_type::INT16:
+                    return func(std::type_identity<std::int16_t>{});
+                case data_type::UINT16:
+                    return func(std::type_identity<std::uint16_t>{});
+                case data_type::INT32:
+                    return func(std::type_identity<std::int32_t>{});
+                case data_type::UINT32:
+                    return func(std::type_identity<std::uint32_t>{});
+                case data_type::INT64:
+                    return func(std::type_identity<std::int64_t>{});
+                case data_type::UINT64:
+                    return func(std::type_identity<std::uint64_t>{});
+                case data_type::FLOAT:
+                    return func(std::type_identity<float>{});
+                case data_type::DOUBLE:
+                    return func(std::type_identity<double>{});
+                default:
+                    throw std::runtime_error("variable_shape_tensor kernels: unsupported tensor value type");
+            }
+        }
+
+        struct shape_hash
+        {
+            std::size_t operator()(const std::vector<std::int64_t>& shape) const noexcept
+            {
+                std::size_t seed = shape.size();
+                for (const auto dim : shape)
+                {
+                    seed ^= std::hash<std::int64_t>{}(dim) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+                }
+                return seed;
+            }
+        };
+
+        std::int64_t element_count(std::span<const std::int64_t> shape)
+        {
+            std::int64_t result = 1;
+            for (const auto dim : shape)
+            {
+                result *= dim;
+            }
+            return result;
+        }
+
+        // Calls func(source_offset, destination_offset, length) for each contiguous run of the
+        // overlap of a row-major source tensor and a row-major destination tensor of the same
+        // rank: a single run if the shapes match, one run per innermost row otherwise
+        template <class F>
+        void for_each_overlapping_row(
+            std::span<const std::int32_t> source_shape,
+            std::span<const std::int64_t> destination_shape,
+            F&& func
+        )
+        {
+            const std::size_t rank = source_shape.size();
+            SPARROW_ASSERT_TRUE(rank == destination_shape.size());
+            if (std::ranges::equal(source_shape, destination_shape))
+            {
+                func(std::int64_t{0}, std::int64_t{0}, element_count(destination_shape));
+                return;
+            }
+
+            std::vector<std::int64_t> extents(rank);
+            std::vector<std::int64_t> source_strides(rank, 1);
+            std::vector<std::int64_t> destination_strides(rank, 1);
+            for (std::size_t axis = rank; axis-- > 0;)
+            {
+                extents[axis] = std::min<std::int64_t>(source_shape[axis], destination_shape[axis]);
+                if (extents[axis] <= 0)
+                {
+                    return;
+                }
+                if (axis + 1 < rank)
+                {
+                    source_strides[axis] = source_strides[axis + 1] * source_shape[axis + 1];
+                    destination_strides[axis] = destination_strides[axis + 1] * destination_shape[axis + 1];
+                }
+            }
+
+            const std::int64_t row_length = extents[rank - 1];
+            std::vector<std::int64_t> row_index(rank, 0);
+            std::int64_t source_offset = 0;
+            std::int64_t destination_offset = 0;
+            for (;;)
+            {
+                func(source_offset, destination_offset, row_length);
+
+                // Move to the next innermost row, carrying over the outer axes
+                std::size_t axis = rank - 1;
+                for (;;)
+                {
+                    if (axis == 0)
+                    {
+                        return;
+                    }
+                    --axis;
+                    if (++row_index[axis] < extents[axis])
+                    {
+                        source_offset += source_strides[axis];
+                        destination_offset += destination_strides[axis];
+                        break;
+                    }
+                    source_offset -= (extents[axis] - 1) * source_strides[axis];
+                    destination_offset -= (extents[axis] - 1) * destination_strides[axis];
+                    row_index[axis] = 0;
+                }
+            }
+        }
+
+        // Copies the overlap of a row-major source tensor into a row-major destination tensor
+        template <class T>
+        void copy_region(
+            const T* source,
+            std::span<const std::int32_t> source_shape,
+            T* destination,
+            std::span<const std::int64_t> destination_shape
+        )
+        {
+            for_each_overlapping_row(
+                source_shape,
+                destination_shape,
+                [source, destination](
+                    std::int64_t source_offset,
+                    std::int64_t destination_offset,
+                    std::int64_t length
+                )
+                {
+                    std::copy_n(source + source_offset, length, destination + destination_offset);
+                }
+            );
+        }
+
+        template <class T>
+        fixed_shape_tensor_array make_fixed_shape_tensors(
+            sparrow::u8_buffer<T>&& values,
+            std::size_t value_count,
+            std::vector<std::int64_t> shape,
+            const variable_shape_tensor_extension::metadata& source_metadata,
+            const std::vector<bool>& validity = {}
+        )
+        {
+            const fixed_shape_tensor_extension::metadata tensor_metadata{
+                std::move(shape),
+                source_metadata.dim_names,
+                source_metadata.permutation
+            };
+            const auto list_size = static_cast<std::uint64_t>(tensor_metadata.compute_size());
+            sparrow::array flat_values(sparrow::primitive_array<T>(std::move(values), value_count));
+            if (validity.empty())
+            {
+                return fixed_shape_tensor_array(list_size, std::move(flat_values), tensor_metadata);
+            }
+            return fixed_shape_tensor_array(list_size, std::move(flat_values), tensor_metadata, validity);
+        }
+
+        // Minimum number of tensors reduced by each thread
+        constexpr std::size_t tensor_reduction_grain_size = 1024;
+
+        // Reduces n contiguous elements, nullopt if the reduction is undefined
+        template <class T>
+        std::optional<double> reduce_contiguous(const T* values, std::int64_t n, tensor_reduction reduction)
+        {
+            switch (reduction)
+            {
+                case tensor_reduction::sum:
+                case tensor_reduction::mean:
+                {
+                    if (reduction == tensor_reduction::mean && n == 0)
+                    {
+                        return std::nullopt;
+                    }
+                    double sum = 0;
+                    for (std::int64_t k = 0; k < n; ++k)
+                    {
+                        sum += static_cast<double>(values[k]);
+                    }
+                    return reduction == tensor_reduction::mean ? sum / static_cast<double>(n) : sum;
+                }
+                case tensor_reduction::min:
+                case tensor_reduction::max:
+                {
+                    if (n == 0)
+                    {
+                        return std::nullopt;
+                    }
+                    const auto [min_it, max_it] = std::minmax_element(values, values + n);
+                    return static_cast<double>(reduction == tensor_reduction::min ? *min_it : *max_it);
+                }
+                case tensor_reduction::norm:
+                {
+                    double sum_of_squares = 0;
+                    for (std::int64_t k = 0; k < n; ++k)
+                    {
+                        const auto value = static_cast<double>(values[k]);
+                        sum_of_squares += value * value;
+                    }
+                    return std::sqrt(sum_of_squares);
+                }
+                case tensor_reduction::count:
+                    return static_cast<double>(n);
+            }
+            return std::nullopt;
+        }
+
+        // Reduces the middle axis of a row-major [outer, length, inner] tensor into [outer, inner]:
+        // the innermost loop runs over contiguous elements of the inner axes
+        template <class T>
+        void reduce_axis(
+            const T* values,
+            std::int64_t outer,
+            std::int64_t length,
+            std::int64_t inner,
+            tensor_reduction reduction,
+            double* result
+        )
+        {
+            for (std::int64_t o = 0; o < outer; ++o)
+            {
+                double* accumulators = result + o * inner;
+                if (reduction == tensor_reduction::count)
+                {
+                    std::fill_n(accumulators, inner, static_cast<double>(length));
+                    continue;
+                }
+                if (length == 0)
+                {
+                    // The sum and the norm of nothing are 0, the mean, min and max are undefined
+                    const bool is_sum = reduction == tensor_reduction::sum
+                                        || reduction == tensor_reduction::norm;
+                    const double empty_value = is_sum ? 0. : std::numeric_limits<double>::quiet_NaN();
+                    std::fill_n(accumulators, inner, empty_value);
+                    continue;
+                }
+
+                const T* slice = values + o * length * inner;
+                for (std::int64_t j = 0; j < inner; ++j)
+                {
+                    const auto value = static_cast<double>(slice[j]);
+                    accumulators[j] = reduction == tensor_reduction::norm ? value * value : value;
+                }
+                // The reduction is resolved outside of the loops so that the inner loop vectorizes
+                const auto accumulate = [&](auto combine)
+                {
+                    for (std::int64_t k = 1; k < length; ++k)
+                    {
+                        const T* row = slice + k * inner;
+                        for (std::int64_t j = 0; j < inner; ++j)
+                        {
+                            accumulators[j] = combine(accumulators[j], static_cast<double>(row[j]));
+                        }
+                    }
+                };
+                switch (reduction)
+                {
+                    case tensor_reduction::min:
+                        accumulate(
+                            [](double accumulator, double value)
+                            {
+                                return std::min(accumulator, value);
+                            }
+                        );
+                        break;
+                    case tensor_reduction::max:
+                        accumulate(
+                            [](double accumulator, double value)
+                            {
+                                return std::max(accumulator, value);
+                            }
+                        );
+                        break;
+                    case tensor_reduction::norm:
+                        accumulate(
+                            [](double accumulator, double value)
+                            {
+                                return accumulator + value * value;
+                            }
+                        );
+                        break;
+                    default:
+                        accumulate(
+                            [](double accumulator, double value)
+                            {
+                                return accumulator + value;
+                            }
+                        );
+                        break;
+                }
+                for (std::int64_t j = 0; j < inner; ++j)
+                {
+                    if (reduction == tensor_reduction::mean)
+                    {
+                        accumulators[j] /= static_cast<double>(length);
+                    }
+                    else if (reduction == tensor_reduction::norm)
+                    {
+                        accumulators[j] = std::sqrt(accumulators[j]);
+                    }
+                }
+            }
+        }
+
+        template <class V>
+        std::optional<std::vector<V>>
+        erase_axis(const std::optional<std::vector<V>>& values, std::size_t axis)
+        {
+            if (!values.has_value())
+            {
+                return std::nullopt;
+            }
+            std::vector<V> result = *values;
+            result.erase(result.begin() + static_cast<std::ptrdiff_t>(axis));
+            return result;
+        }
+
+        std::optional<std::string> array_name(const sparrow::arrow_proxy& proxy)
+        {
+            const auto name = proxy.name();
+            return name.has_value() ? std::make_optional<std::string>(*name) : std::nullopt;
+        }
+
+        // Moves the descendant of the storage reached through path out of it, as the C data
+        // interface allows, then releases the rest of the storage
+        std::pair<ArrowArray, ArrowSchema>
+        extract_descendant(sparrow::arrow_proxy& proxy, std::initializer_list<std::size_t> path)
+        {
+            ArrowArray storage_array = proxy.extract_array();
+            ArrowSchema storage_schema = proxy.extract_schema();
+            ArrowArray* array = &storage_array;
+            ArrowSchema* schema = &storage_schema;
+            for (const auto child : path)
+            {
+                array = array->children[child];
+                schema = schema->children[child];
+            }
+            std::pair<ArrowArray, ArrowSchema> result{*array, *schema};
+            array->release = nullptr;
+            schema->release = nullptr;
+            storage_array.release(&storage_array);
+            storage_schema.release(&storage_schema);
+            return result;
+        }
+
+        // Checks if tensors i and j have the same shape, the uniform axes are equal already
+        bool has_same_varying_extents(const variable_shape_tensor_index& layout, std::size_t i, std::size_t j)
+        {
+            const auto shape_i = layout.shape(i);
+            const auto shape_j = layout.shape(j);
+            return std::ranges::all_of(
+                layout.varying_axes,
+                [&](std::size_t axis)
+                {
+                    return shape_i[axis] == shape_j[axis];
+                }
+            );
+        }
+
+        // Shape shared by all the non-null tensors, from uniform_shape if it is fully specified
+        std::vector<std::int64_t> common_shape(
+            const variable_shape_tensor_array& tensors,
+            const variable_shape_tensor_index& layout
+        )
+        {
+            std::optional<std::size_t> first_row;
+            if (layout.uniform)
+            {
+                first_row = 0;
+            }
+            else
+            {
+                for (std::size_t i = 0; i < tensors.size(); ++i)
+                {
+                    if (!layout.is_valid(i))
+                    {
+                        continue;
+                    }
+                    if (!first_row.has_value())
+                    {
+                        first_row = i;
+                    }
+                    else if (!has_same_varying_extents(layout, i, *first_row))
+                    {
+                        throw std::runtime_error(
+                            "to_fixed_shape_tensor: tensor " + std::to_string(i)
+                            + " does not have the shape of tensor " + std::to_string(*first_row)
+                        );
+                    }
+                }
+            }
+            if (!first_row.has_value())
+            {
+                throw std::runtime_error(
+                    "to_fixed_shape_tensor: the shape of the tensors cannot be determined"
+                );
+            }
+
+            const auto shape = layout.shape(*first_row);
+            if (std::ranges::find_if(
+                    shape,
+                    [](std::int32_t dim)
+                    {
+                        return dim <= 0;
+                    }
+                )
+                != shape.end())
+            {
+                throw std::runtime_error(
+                    "to_fixed_shape_tensor: fixed shape tensors must have positive extents"
+                );
+            }
+            return std::vector<std::int64_t>(shape.begin(), shape.end());
+        }
+
+        // Checks if tensor i starts list_size elements after tensor i - 1 and holds list_size elements
+        bool has_contiguous_values(const variable_shape_tensor_index& layout, std::int64_t list_size)
+        {
+            const auto& offsets = layout.element_offsets;
+            const auto& counts = layout.element_counts;
+            if (offsets.empty())
+            {
+                return false;
+            }
+            bool contiguous = true;
+            for (std::size_t i = 0; i < offsets.size(); ++i)
+            {
+                contiguous &= offsets[i] == offsets[0] + static_cast<std::int64_t>(i) * list_size;
+                contiguous &= counts[i] == list_size;
+            }
+            return contiguous;
+        }
+
+        // List array of values whose offsets are the arithmetic sequence first_element,
+        // first_element + list_size, ..., written by a plain loop the compiler vectorizes
+        template <bool BIG>
+        sparrow::array make_regular_list_array(
+            sparrow::array&& values,
+            std::size_t list_count,
+            std::int64_t first_element,
+            std::int64_t list_size
+        )
+        {
+            using offset_type = std::conditional_t<BIG, std::int64_t, std::int32_t>;
+            using list_type = std::conditional_t<BIG, sparrow::big_list_array, sparrow::list_array>;
+            sparrow::u8_buffer<offset_type> offsets(list_count + 1, offset_type{0});
+            offset_type* offsets_data = offsets.data();
+            for (std::size_t i = 0; i <= list_count; ++i)
+            {
+                const auto offset = first_element + static_cast<std::int64_t>(i) * list_size;
+                offsets_data[i] = static_cast<offset_type>(offset);
+            }
+            return sparrow::array(list_type(std::move(values), std::move(offsets)));
+        }
+
+        // List array of values delimited by offsets
+        template <bool BIG>
+        sparrow::array make_list_array(sparrow::array&& values, std::span<const std::int64_t> offsets)
+        {
+            using offset_type = std::conditional_t<BIG, std::int64_t, std::int32_t>;
+            using list_type = std::conditional_t<BIG, sparrow::big_list_array, sparrow::list_array>;
+            sparrow::u8_buffer<offset_type> list_offsets(offsets.size(), offset_type{0});
+            std::ranges::transform(
+                offsets,
+                list_offsets.data(),
+                [](std::int64_t offset)
+                {
+                    return static_cast<offset_type>(offset);
+                }
+            );
+            return sparrow::array(list_type(std::move(values), std::move(list_offsets)));
+        }
+
+        // ListView array of values whose lists are the elements of the tensors of layout at
+        // indices, the values starting at position values_offset of the values buffer
+        template <bool BIG>
+        sparrow::array make_list_view_array(
+            sparrow::array&& values,
+            const variable_shape_tensor_index& layout,
+            std::span<const std::size_t> indices,
+            std::int64_t values_offset
+        )
+        {
+            using list_type = std::conditional_t<BIG, sparrow::big_list_view_array, sparrow::list_view_array>;
+            using offset_buffer_type = typename list_type::offset_buffer_type;
+            using size_buffer_type = typename list_type::size_buffer_type;
+            using offset_type = typename offset_buffer_type::value_type;
+            using list_size_type = typename size_buffer_type::value_type;
+            offset_buffer_type offsets(indices.size(), offset_type{0});
+            size_buffer_type sizes(indices.size(), list_size_type{0});
+            offset_type* offsets_data = offsets.data();
+            list_size_type* sizes_data = sizes.data();
+            for (std::size_t k = 0; k < indices.size(); ++k)
+            {
+                const auto offset = layout.element_offsets[indices[k]] - values_offset;
+                offsets_data[k] = static_cast<offset_type>(offset);
+                sizes_data[k] = static_cast<list_size_type>(layout.element_counts[indices[k]]);
+            }
+            return sparrow::array(list_type(std::move(values), std::move(offsets), std::move(sizes)));
+        }
+
+        fixed_shape_tensor_array
+        with_name(fixed_shape_tensor_array&& tensors, const std::optional<std::string>& name)
+        {
+            if (name.has_value())
+            {
+                tensors.get_arrow_proxy().set_name(*name);
+            }
+            return std::move(tensors);
+        }
+    }
+
+    shape_buckets
+    bucket_by_shape(const variable_shape_tensor_array& tensors, const shape_bucketing_options& options)
+    {
+        const auto layout = tensors.layout();
+        const auto& granularity = options.granularity;
+        SPARROW_ASSERT_TRUE(granularity.empty() || granularity.size() == layout->ndim);
+        SPARROW_ASSERT_TRUE(std::ranges::all_of(
+            granularity,
+            [](std::int32_t step)
+            {
+                return step > 0;
+            }
+        ));
+
+        // Grouping pass: bucket shapes in the order of their first tensor
+        shape_buckets result;
+        std::vector<std::vector<std::int64_t>> bucket_shapes;
+        std::vector<std::vector<std::size_t>> bucket_rows;
+        std::unordered_map<std::vector<std::int64_t>, std::size_t, shape_hash> bucket_ids;
+        std::vector<std::int64_t> key(layout->ndim);
+        for (std::size_t i = 0; i < tensors.size(); ++i)
+        {
+            const auto shape = layout->shape(i);
+            const bool has_zero_extent = std::ranges::any_of(
+                shape,
+                [](std::int32_t dim)
+                {
+                    return dim <= 0;
+                }
+            );
+            // Fixed shape tensors have at least one dimension, the scalars of a 0-dim array
+            // have no bucket
+            if (!layout->is_valid(i) || shape.empty() || has_zero_extent)
+            {
+                result.unbucketed_rows.push_back(i);
+                continue;
+            }
+
+            for (std::size_t axis = 0; axis < shape.size(); ++axis)
+            {
+                const std::int64_t step = granularity.empty() ? 1 : granularity[axis];
+                key[axis] = (shape[axis] + step - 1) / step * step;
+            }
+            const auto [it, inserted] = bucket_ids.try_emplace(key, bucket_shapes.size());
+            if (inserted)
+            {
+                bucket_shapes.push_back(key);
+                bucket_rows.emplace_back();
+            }
+            bucket_rows[it->second].push_back(i);
+        }
+
+        // Copy pass: each bucket is filled in parallel over its tensors
+        result.buckets.reserve(bucket_shapes.size());
+        visit_value_type(
+            tensors.value_type(),
+            [&]<class T>(std::type_identity<T>)
+            {
+                const auto values = tensors.values<T>();
+                const auto pad_value = static_cast<T>(options.pad_value);
+                for (std::size_t b = 0; b < bucket_shapes.size(); ++b)
+                {
+                    const auto& rows = bucket_rows[b];
+                    const auto& shape = bucket_shapes[b];
+                    const auto list_size = static_cast<std::size_t>(element_count(shape));
+                    const std::size_t value_count = rows.size() * list_size;
+                    sparrow::u8_buffer<T> bucket_values(value_count, pad_value);
+                    T* destination = bucket_values.data();
+                    detail::parallel_for(
+                        rows.size(),
+                        tensor_copy_grain_size,
+                        [&](std::size_t begin, std::size_t end)
+                        {
+                            for (std::size_t j = begin; j < end; ++j)
+                            {
+                                const auto row = rows[j];
+                                copy_region(
+                                    values.data() + layout->element_offsets[row],
+                                    layout->shape(row),
+                                    destination + j * list_size,
+                                    std::span<const std::int64_t>(shape)
+                                );
+                            }
+                        }
+                    );
+                    result.buckets.push_back(shape_bucket{
+                        shape,
+                        std::move(bucket_rows[b]),
+                        make_fixed_shape_tensors<T>(
+                            std::move(bucket_values),
+                            value_count,
+                            shape,
+                            tensors.get_metadata()
+                        )
+                    });
+                }
+            }
+        );
+        return result;
+    }
+
+    padded_tensors pad_to_dense(const variable_shape_tensor_array& tensors, const padding_options& options)
+    {
+        const auto layout = tensors.layout();
+        const std::size_t ndim = layout->ndim;
+        const std::size_t tensor_count = tensors.size();
+
+        std::vector<std::int64_t> shape = options.shape;
+        if (shape.empty())
+        {
+            // The uniform axes take their extent from the index, only the varying ones are scanned
+            shape.assign(ndim, 1);
+            if (tensor_count != 0)
+            {
+                std::ranges::copy(layout->shape(0), shape.begin());
+                for (const auto axis : layout->varying_axes)
+                {
+                    shape[axis] = 1;
+                }
+            }
+            for (std::size_t i = 0; i < tensor_count; ++i)
+            {
+                if (layout->is_valid(i))
+                {
+                    const auto tensor_shape = layout->shape(i);
+                    for (const auto axis : layout->varying_axes)
+                    {
+                        shape[axis] = std::max<std::int64_t>(shape[axis], tensor_shape[axis]);
+                    }
+                }
+            }
+        }
+        else
+        {
+            SPARROW_ASSERT_TRUE(shape.size() == ndim);
+            SPARROW_ASSERT_TRUE(std::ranges::all_of(
+                shape,
+                [](std::int64_t dim)
+                {
+                    return dim > 0;
+                }
+            ));
+            if (!options.truncate)
+            {
+                for (std::size_t i = 0; i < tensor_count; ++i)
+                {
+                    if (!layout->is_valid(i))
+                    {
+                        continue;
+                    }
+                    const auto tensor_shape = layout->shape(i);
+                    for (std::size_t axis = 0; axis < ndim; ++axis)
+                    {
+                        if (tensor_shape[axis] > shape[axis])
+                        {
+                            throw std::runtime_error(
+                                "pad_to_dense: tensor " + std::to_string(i)
+                                + " is larger than the padded shape"
+                            );
+                        }
+                    }
+                }
+            }
+        }
+
+        const auto list_size = static_cast<std::size_t>(element_count(shape));
+        const std::size_t value_count = tensor_count * list_size;
+        sparrow::u8_buffer<bool> mask_values(value_count, false);
+        bool* mask = mask_values.data();
+
+        return visit_value_type(
+            tensors.value_type(),
+            [&]<class T>(std::type_identity<T>)
+            {
+                const auto values = tensors.values<T>();
+                sparrow::u8_buffer<T> dense_values(value_count, static_cast<T>(options.pad_value));
+                T* destination = dense_values.data();
+                detail::parallel_for(
+                    tensor_count,
+                    tensor_copy_grain_size,
+                    [&](std::size_t begin, std::size_t end)
+                    {
+                        for (std::size_t i = begin; i < end; ++i)
+                        {
+                            if (!layout->is_valid(i))
+                            {
+                                continue;
+                            }
+                            const T* source = values.data() + layout->element_offsets[i];
+                            T* tensor_destination = destination + i * list_size;
+                            bool* tensor_mask = mask + i * list_size;
+                            for_each_overlapping_row(
+                                layout->shape(i),
+                                std::span<const std::int64_t>(shape),
+                                [&](
+                                    std::int64_t source_offset,
+                                    std::int64_t destination_offset,
+                                    std::int64_t length
+                                )
+                                {
+                                    T* row_destination = tensor_destination + destination_offset;
+                                    std::copy_n(source + source_offset, length, row_destination);
+                                    std::fill_n(tensor_mask + destination_offset, length, true);
+                                }
+                            );
+                        }
+                    }
+                );
+
+                return padded_tensors{
+                    make_fixed_shape_tensors<T>(
+                        std::move(dense_values),
+                        value_count,
+                        shape,
+                        tensors.get_metadata(),
+                        layout->validity
+                    ),
+                    bool8_array(std::move(mask_values), value_count)
+                };
+            }
+        );
+    }
+
+    sparrow::primitive_array<double>
+    reduce_tensors(const variable_shape_tensor_array& tensors, tensor_reduction reduction)
+    {
+        const auto layout = tensors.layout();
+        const std::size_t tensor_count = tensors.size();
+        sparrow::u8_buffer<double> results(tensor_count, 0.);
+        std::vector<bool> validity(tensor_count, true);
+
+        visit_value_type(
+            tensors.value_type(),
+            [&]<class T>(std::type_identity<T>)
+            {
+                const auto values = tensors.values<T>();
+                double* result_data = results.data();
+                // std::vector<bool> packs bits, so each thread records its nulls in its own byte vector
+                std::vector<std::uint8_t> defined(tensor_count, 1);
+                detail::parallel_for(
+                    tensor_count,
+                    tensor_reduction_grain_size,
+                    [&](std::size_t begin, std::size_t end)
+                    {
+                        for (std::size_t i = begin; i < end; ++i)
+                        {
+                            const auto result = layout->is_valid(i)
+                                                    ? reduce_contiguous(
+                                                          values.data() + layout->element_offsets[i],
+                                                          layout->element_counts[i],
+                                                          reduction
+                                                      )
+                                                    : std::nullopt;
+                            result_data[i] = result.value_or(0.);
+                            defined[i] = result.has_value() ? 1 : 0;
+                        }
+                    }
+                );
+                std::ranges::transform(
+                    defined,
+                    validity.begin(),
+                    [](std::uint8_t flag)
+                    {
+                        return flag != 0;
+                    }
+                );
+            }
+        );
+        return sparrow::primitive_array<double>(std::move(results), tensor_count, std::move(validity));
+    }
+
+    variable_shape_tensor_array
+    reduce_tensors(const variable_shape_tensor_array& tensors, tensor_reduction reduction, std::size_t axis)
+    {
+        const auto layout = tensors.layout();
+        const std::size_t ndim = layout->ndim;
+        SPARROW_ASSERT_TRUE(axis < ndim);
+        const std::size_t tensor_count = tensors.size();
+
+        // Shapes and offsets of the reduced tensors
+        using entry_type = std::pair<std::vector<std::int32_t>, std::vector<double>>;
+        std::vector<std::optional<entry_type>> entries(tensor_count);
+        visit_value_type(
+            tensors.value_type(),
+            [&]<class T>(std::type_identity<T>)
+            {
+                const auto values = tensors.values<T>();
+                detail::parallel_for(
+                    tensor_count,
+                    tensor_reduction_grain_size,
+                    [&](std::size_t begin, std::size_t end)
+                    {
+                        for (std::size_t i = begin; i < end; ++i)
+                        {
+                            if (!layout->is_valid(i))
+                            {
+                                continue;
+                            }
+                            const auto shape = layout->shape(i);
+                            std::int64_t outer = 1;
+                            std::int64_t inner = 1;
+                            for (std::size_t d = 0; d < axis; ++d)
+                            {
+                                outer *= shape[d];
+                            }
+                            for (std::size_t d = axis + 1; d < ndim; ++d)
+                            {
+                                inner *= shape[d];
+                            }
+
+                            auto& entry = entries[i].emplace();
+                            entry.first.assign(shape.begin(), shape.end());
+                            entry.first.erase(entry.first.begin() + static_cast<std::ptrdiff_t>(axis));
+                            entry.second.resize(static_cast<std::size_t>(outer * inner));
+                            reduce_axis(
+                                values.data() + layout->element_offsets[i],
+                                outer,
+                                shape[axis],
+                                inner,
+                                reduction,
+                                entry.second.data()
+                            );
+                        }
+                    }
+                );
+            }
+        );
+
+        const auto& source_metadata = tensors.get_metadata();
+        variable_shape_tensor_extension::metadata result_metadata{
+            erase_axis(source_metadata.dim_names, axis),
+            std::nullopt,
+            erase_axis(source_metadata.uniform_shape, axis)
+        };
+        std::size_t result_element_count = 0;
+        for (const auto& entry : entries)
+        {
+            result_element_count += entry.has_value() ? entry->second.size() : 0;
+        }
+        if (std::cmp_greater(result_element_count, std::numeric_limits<std::int32_t>::max()))
+        {
+            return make_variable_shape_tensor_array<double, true>(ndim - 1, entries, result_metadata);
+        }
+        return make_variable_shape_tensor_array<double>(ndim - 1, entries, result_metadata);
+    }
+
+    variable_shape_tensor_array reduce_tensors(
+        const variable_shape_tensor_array& tensors,
+        tensor_reduction reduction,
+        std::string_view axis_name
+    )
+    {
+        const auto& dim_names = tensors.get_metadata().dim_names;
+        if (dim_names.has_value())
+        {
+            const auto it = std::ranges::find(*dim_names, axis_name);
+            if (it != dim_names->end())
+            {
+                const auto axis = static_cast<std::size_t>(std::distance(dim_names->begin(), it));
+                return reduce_tensors(tensors, reduction, axis);
+            }
+        }
+        throw std::runtime_error("reduce_tensors: no dimension named '" + std::string(axis_name) + "'");
+    }
+
+    variable_shape_tensor_array to_variable_shape_tensor(fixed_shape_tensor_array&& tensors)
+    {
+        auto& proxy = tensors.get_arrow_proxy();
+        if (!proxy.owns_array() || !proxy.owns_schema())
+        {
+            return to_variable_shape_tensor(fixed_shape_tensor_array(tensors));
+        }
+
+        const auto& source_metadata = tensors.get_metadata();
+        const std::size_t ndim = source_metadata.shape.size();
+        const std::size_t tensor_count = tensors.size();
+        const std::int64_t list_size = source_metadata.compute_size();
+        const auto first_element = static_cast<std::int64_t>(proxy.offset()) * list_size;
+        const auto last_element = first_element + static_cast<std::int64_t>(tensor_count) * list_size;
+        const bool large_offsets = last_element > std::numeric_limits<std::int32_t>::max();
+
+        std::vector<std::int32_t> extents;
+        std::vector<std::optional<std::int32_t>> uniform_shape;
+        extents.reserve(ndim);
+        uniform_shape.reserve(ndim);
+        for (const auto dim : source_metadata.shape)
+        {
+            extents.push_back(static_cast<std::int32_t>(dim));
+            uniform_shape.emplace_back(static_cast<std::int32_t>(dim));
+        }
+        const variable_shape_tensor_extension::metadata tensor_metadata{
+            source_metadata.dim_names,
+            source_metadata.permutation,
+            std::move(uniform_shape)
+        };
+
+        std::vector<bool> validity;
+        if (proxy.null_count() != 0)
+        {
+            const auto bitmap = tensors.bitmap();
+            validity.assign(bitmap.begin(), bitmap.end());
+        }
+        const auto name = array_name(proxy);
+
+        // The shapes are a broadcast of the fixed shape
+        const std::size_t shapes_size = tensor_count * ndim;
+        sparrow::u8_buffer<std::int32_t> shapes(shapes_size, std::int32_t{0});
+        std::int32_t* shapes_data = shapes.data();
+        for (std::size_t i = 0; i < tensor_count; ++i)
+        {
+            std::ranges::copy(extents, shapes_data + i * ndim);
+        }
+
+        auto [values_array, values_schema] = extract_descendant(proxy, {0});
+        sparrow::array flat_values(std::move(values_array), std::move(values_schema));
+        sparrow::array tensor_data = large_offsets
+                                         ? make_regular_list_array<true>(
+                                               std::move(flat_values),
+                                               tensor_count,
+                                               first_element,
+                                               list_size
+                                           )
+                                         : make_regular_list_array<false>(
+                                               std::move(flat_values),
+                                               tensor_count,
+                                               first_element,
+                                               list_size
+                                           );
+        sparrow::fixed_sized_list_array tensor_shapes(
+            ndim,
+            sparrow::array(sparrow::primitive_array<std::int32_t>(std::move(shapes), shapes_size))
+        );
+        return variable_shape_tensor_array(
+            ndim,
+            std::move(tensor_data),
+            sparrow::array(std::move(tensor_shapes)),
+            tensor_metadata,
+            std::move(validity),
+            name.has_value() ? std::make_optional<std::string_view>(*name) : std::nullopt
+        );
+    }
+
+    variable_shape_tensor_array to_variable_shape_tensor(const fixed_shape_tensor_array& tensors)
+    {
+        return to_variable_shape_tensor(fixed_shape_tensor_array(tensors));
+    }
+
+    fixed_shape_tensor_array to_fixed_shape_tensor(variable_shape_tensor_array&& tensors)
+    {
+        const auto layout = tensors.layout();
+        std::vector<std::int64_t> shape = common_shape(tensors, *layout);
+        const std::int64_t list_size = element_count(shape);
+
+        const auto& const_proxy = std::as_const(tensors).get_arrow_proxy();
+        const ArrowArray& values = *const_proxy.array().children[0]->children[0];
+        if (!has_contiguous_values(*layout, list_size) || values.null_count != 0 || !const_proxy.owns_array()
+            || !const_proxy.owns_schema())
+        {
+            return to_fixed_shape_tensor(std::as_const(tensors));
+        }
+
+        const auto& source_metadata = tensors.get_metadata();
+        const fixed_shape_tensor_extension::metadata tensor_metadata{
+            std::move(shape),
+            source_metadata.dim_names,
+            source_metadata.permutation
+        };
+        const auto name = array_name(const_proxy);
+
+        // The values of the tensors are a contiguous range of the values of the data child
+        auto [values_array, values_schema] = extract_descendant(tensors.get_arrow_proxy(), {0, 0});
+        values_array.offset = layout->element_offsets.front();
+        values_array.length = static_cast<std::int64_t>(tensors.size()) * list_size;
+        return with_name(
+            fixed_shape_tensor_array(
+                static_cast<std::uint64_t>(list_size),
+                sparrow::array(std::move(values_array), std::move(values_schema)),
+                tensor_metadata,
+                layout->validity
+            ),
+            name
+        );
+    }
+
+    fixed_shape_tensor_array to_fixed_shape_tensor(const variable_shape_tensor_array& tensors)
+    {
+        const auto layout = tensors.layout();
+        std::vector<std::int64_t> shape = common_shape(tensors, *layout);
+        const auto list_size = static_cast<std::size_t>(element_count(shape));
+        const bool contiguous = has_contiguous_values(*layout, static_cast<std::int64_t>(list_size));
+        const std::size_t tensor_count = tensors.size();
+        const std::size_t value_count = tensor_count * list_size;
+
+        return visit_value_type(
+            tensors.value_type(),
+            [&]<class T>(std::type_identity<T>)
+            {
+                const auto values = tensors.values<T>();
+                sparrow::u8_buffer<T> fixed_values(value_count, T{});
+                T* destination = fixed_values.data();
+                if (contiguous)
+                {
+                    std::copy_n(values.data() + layout->element_offsets.front(), value_count, destination);
+                }
+                else
+                {
+                    detail::parallel_for(
+                        tensor_count,
+                        tensor_copy_grain_size,
+                        [&](std::size_t begin, std::size_t end)
+                        {
+                            for (std::size_t i = begin; i < end; ++i)
+                            {
+                                if (layout->is_valid(i))
+                                {
+                                    const T* source = values.data() + layout->element_offsets[i];
+                                    std::copy_n(source, list_size, destination + i * list_size);
+                                }
+                            }
+                        }
+                    );
+                }
+                return with_name(
+                    make_fixed_shape_tensors<T>(
+                        std::move(fixed_values),
+                        value_count,
+                        std::move(shape),
+                        tensors.get_metadata(),
+                        layout->validity
+                    ),
+                    array_name(tensors.get_arrow_proxy())
+                );
+            }
+        );
+    }
+
+    variable_shape_tensor_array
+    reorder_tensors(variable_shape_tensor_array&& tensors, std::span<const std::size_t> indices)
+    {
+        const auto& const_proxy = std::as_const(tensors).get_arrow_proxy();
+        if (!const_proxy.owns_array() || !const_proxy.owns_schema())
+        {
+            return reorder_tensors(variable_shape_tensor_array(std::as_const(tensors)), indices);
+        }
+
+        const auto layout = tensors.layout();
+        const std::size_t ndim = layout->ndim;
+        const std::size_t tensor_count = indices.size();
+        const std::int64_t values_offset = const_proxy.array().children[0]->children[0]->offset;
+        std::int64_t last_element = 0;
+        for (const auto i : indices)
+        {
+            SPARROW_ASSERT_TRUE(i < tensors.size());
+            last_element = std::max(
+                last_element,
+                layout->element_offsets[i] + layout->element_counts[i] - values_offset
+            );
+        }
+        const bool large_offsets = last_element > std::numeric_limits<std::int32_t>::max();
+
+        // The shapes and the validity are gathered, the elements stay where they are
+        const std::size_t shapes_size = tensor_count * ndim;
+        sparrow::u8_buffer<std::int32_t> shapes(shapes_size, std::int32_t{0});
+        std::int32_t* shapes_data = shapes.data();
+        std::vector<bool> validity;
+        if (!layout->validity.empty())
+        {
+            validity.resize(tensor_count);
+        }
+        for (std::size_t k = 0; k < tensor_count; ++k)
+        {
+            std::ranges::copy(layout->shape(indices[k]), shapes_data + k * ndim);
+            if (!validity.empty())
+            {
+                validity[k] = layout->validity[indices[k]];
+            }
+        }
+        const auto tensor_metadata = tensors.get_metadata();
+        const auto name = array_name(const_proxy);
+
+        auto [values_array, values_schema] = extract_descendant(tensors.get_arrow_proxy(), {0, 0});
+        sparrow::array flat_values(std::move(values_array), std::move(values_schema));
+        sparrow::array tensor_data = large_offsets
+                                         ? make_list_view_array<true>(
+                                               std::move(flat_values),
+                                               *layout,
+                                               indices,
+                                               values_offset
+                                           )
+                                         : make_list_view_array<false>(
+                                               std::move(flat_values),
+                                               *layout,
+                                               indices,
+                                               values_offset
+                                           );
+        sparrow::fixed_sized_list_array tensor_shapes(
+            ndim,
+            sparrow::array(sparrow::primitive_array<std::int32_t>(std::move(shapes), shapes_size))
+        );
+        return variable_shape_tensor_array(
+            ndim,
+            std::move(tensor_data),
+            sparrow::array(std::move(tensor_shapes)),
+            tensor_metadata,
+            std::move(validity),
+            name.has_value() ? std::make_optional<std::string_view>(*name) : std::nullopt
+        );
+    }
+
+    variable_shape_tensor_array
+    reorder_tensors(const variable_shape_tensor_array& tensors, std::span<const std::size_t> indices)
+    {
+        return reorder_tensors(variable_shape_tensor_array(tensors), indices);
+    }
+
+    variable_shape_tensor_array
+    take_tensors(const variable_shape_tensor_array& tensors, std::span<const std::size_t> indices)
+    {
+        const auto layout = tensors.layout();
+        const std::size_t ndim = layout->ndim;
+        const std::size_t tensor_count = indices.size();
+
+        // Offsets, shapes and validity in a single pass, null tensors get no element
+        std::vector<std::int64_t> offsets(tensor_count + 1, 0);
+        const std::size_t shapes_size = tensor_count * ndim;
+        sparrow::u8_buffer<std::int32_t> shapes(shapes_size, std::int32_t{0});
+        std::int32_t* shapes_data = shapes.data();
+        std::vector<bool> validity;
+        if (!layout->validity.empty())
+        {
+            validity.resize(tensor_count);
+        }
+        for (std::size_t k = 0; k < tensor_count; ++k)
+        {
+            const std::size_t i = indices[k];
+            SPARROW_ASSERT_TRUE(i < tensors.size());
+            const bool valid = layout->is_valid(i);
+            offsets[k + 1] = offsets[k] + (valid ? layout->element_counts[i] : 0);
+            std::ranges::copy(layout->shape(i), shapes_data + k * ndim);
+            if (!validity.empty())
+            {
+                validity[k] = valid;
+            }
+        }
+        const auto value_count = static_cast<std::size_t>(offsets.back());
+        const bool large_offsets = offsets.back() > std::numeric_limits<std::int32_t>::max();
+        const auto name = array_name(tensors.get_arrow_proxy());
+
+        return visit_value_type(
+            tensors.value_type(),
+            [&]<class T>(std::type_identity<T>)
+            {
+                const auto values = tensors.values<T>();
+                sparrow::u8_buffer<T> taken_values(value_count, T{});
+                T* destination = taken_values.data();
+                detail::parallel_for(
+                    tensor_count,
+                    tensor_copy_grain_size,
+                    [&](std::size_t begin, std::size_t end)
+                    {
+                        for (std::size_t k = begin; k < end; ++k)
+                        {
+                            const T* source = values.data() + layout->element_offsets[indices[k]];
+                            const auto count = static_cast<std::size_t>(offsets[k + 1] - offsets[k]);
+                            std::copy_n(source, count, destination + offsets[k]);
+                        }
+                    }
+                );
+
+                sparrow::array flat_values(sparrow::primitive_array<T>(std::move(taken_values), value_count));
+                sparrow::array tensor_data = large_offsets
+                                                 ? make_list_array<true>(std::move(flat_values), offsets)
+                                                 : make_list_array<false>(std::move(flat_values), offsets);
+                sparrow::fixed_sized_list_array tensor_shapes(
+                    ndim,
+                    sparrow::array(sparrow::primitive_array<std::int32_t>(std::move(shapes), shapes_size))
+                );
+                return variable_shape_tensor_array(
+                    ndim,
+                    std::move(tensor_data),
+                    sparrow::array(std::move(tensor_shapes)),
+                    tensors.get_metadata(),
+                    std::move(validity),
+                    name.has_value() ? std::make_optional<std::string_view>(*name) : std::nullopt
+                );
+            }
+        );
+    }
+
+    variable_shape_tensor_array
+    filter_tensors(const variable_shape_tensor_array& tensors, const bool8_array& mask)
+    {
+        SPARROW_ASSERT_TRUE(mask.size() == tensors.size());
+        std::vector<std::size_t> indices;
+        indices.reserve(tensors.size());
+        for (std::size_t i = 0; i < mask.size(); ++i)
+        {
+            const auto flag = mask[i];
+            if (flag.has_value() && static_cast<bool>(flag.value()))
+            {
+                indices.push_back(i);
+            }
+        }
+        return take_tensors(tensors, indices);
+    }
+
+    std::vector<std::size_t>
+    argsort_by_element_count(const variable_shape_tensor_array& tensors, bool descending)
+    {
+        const auto layout = tensors.layout();
+        std::vector<std::int64_t> counts(tensors.size());
+        for (std::size_t i = 0; i < counts.size(); ++i)
+        {
+            counts[i] = layout->is_valid(i) ? layout->element_counts[i] : 0;
+        }
+
+        std::vector<std::size_t> result(counts.size());
+        std::iota(result.begin(), result.end(), std::size_t{0});
+        std::ranges::stable_sort(
+            result,
+            [&counts, descending](std::size_t lhs, std::size_t rhs)
+            {
+                return descending ? counts[lhs] > counts[rhs] : counts[lhs] < counts[rhs];
+            }
+        );
+        return result;
+    }
+}
@@ -18,11 +18,21 @@
 #include <string>
 
 #include <sparrow_extensions/config/sparrow_extensions_version.hpp>
+#include <sparrow_extensions/registration.hpp>
 
 #ifdef HAS_BETTER_JUNIT_REPORTER
 #include "better_junit_reporter.hpp"
 #endif
 
+#if defined(SPARROW_EXTENSIONS_DISABLE_AUTO_REGISTRATION)
+// The test suite relies on the extension types being registered in the sparrow array registry.
+[[maybe_unused]] static const bool extensions_registered = []()
+{
+    sparrow_extensions::register_extensions();
+    return true;
+}();
+#endif
+
 TEST_CASE("versions are readable")
 {
     // TODO: once available on OSX, use `<format>` facility instead.
@@ -0,0 +1,200 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include <doctest/doctest.h>
+
+#include "sparrow_extensions/allocation_tracker.hpp"
+#include "sparrow_extensions/fixed_shape_tensor.hpp"
+#include "sparrow_extensions/variable_shape_tensor_builder.hpp"
+
+namespace sparrow_extensions
+{
+    namespace
+    {
+        allocation_counters find_site(std::string_view name)
+        {
+            const auto counters = allocation_tracker::snapshot();
+            const auto it = std::ranges::find(counters, name, &allocation_counters::site);
+            return it != counters.end() ? *it : allocation_counters{name, 0, 0};
+        }
+    }
+
+    TEST_SUITE("allocation_tracker")
+    {
+        TEST_CASE("allocation_site")
+        {
+            // Sites stay registered until the end of the program
+            static allocation_site site("test_allocation_tracker::manual_site");
+            site.reset();
+            CHECK_EQ(site.name(), "test_allocation_tracker::manual_site");
+
+            site.record(16);
+            site.record(48);
+            auto counters = site.counters();
+            CHECK_EQ(counters.site, "test_allocation_tracker::manual_site");
+            CHECK_EQ(counters.allocation_count, 2);
+            CHECK_EQ(counters.allocated_bytes, 64);
+
+            site.reset();
+            counters = site.counters();
+            CHECK_EQ(counters.allocation_count, 0);
+            CHECK_EQ(counters.allocated_bytes, 0);
+        }
+
+        TEST_CASE("allocation_scope")
+        {
+            static allocation_site outer("test_allocation_tracker::outer");
+            static allocation_site inner("test_allocation_tracker::inner");
+            allocation_tracker::reset();
+
+            SUBCASE("nested scopes")
+            {
+                {
+                    const allocation_scope outer_scope(outer);
+                    allocation_tracker::record_allocation(100);
+                    {
+                        const allocation_scope inner_scope(inner);
+                        allocation_tracker::record_allocation(10);
+                    }
+                    allocation_tracker::record_allocation(1);
+                }
+                allocation_tracker::record_allocation(1000);
+
+                CHECK_EQ(outer.counters().allocation_count, 3);
+                CHECK_EQ(outer.counters().allocated_bytes, 111);
+                CHECK_EQ(inner.counters().allocation_count, 1);
+                CHECK_EQ(inner.counters().allocated_bytes, 10);
+            }
+
+            SUBCASE("snapshot and dump")
+            {
+                {
+                    const allocation_scope outer_scope(outer);
+                    allocation_tracker::record_allocation(32);
+                }
+                const auto counters = find_site("test_allocation_tracker::outer");
+                CHECK_EQ(counters.allocation_count, 1);
+                CHECK_EQ(counters.allocated_bytes, 32);
+
+                const auto snapshot = allocation_tracker::snapshot();
+                CHECK(std::ranges::is_sorted(
+                    snapshot,
+                    std::ranges::greater{},
+                    &allocation_counters::allocated_bytes
+                ));
+
+                std::ostringstream oss;
+                allocation_tracker::dump(oss);
+                const std::string dumped = oss.str();
+                CHECK_NE(dumped.find("test_allocation_tracker::outer: 1 allocations, 32 bytes"), dumped.npos);
+            }
+
+            SUBCASE("reset")
+            {
+                {
+                    const allocation_scope outer_scope(outer);
+                    allocation_tracker::record_allocation(32);
+                }
+                allocation_tracker::reset();
+                CHECK_EQ(outer.counters().allocation_count, 0);
+                CHECK_EQ(outer.counters().allocated_bytes, 0);
+            }
+        }
+
+        TEST_CASE("sites sharing a name")
+        {
+            // Models a site declared in a template, which exists once per instantiation
+            static allocation_site first("test_allocation_tracker::shared_name");
+            static allocation_site second("test_allocation_tracker::shared_name");
+            allocation_tracker::reset();
+
+            first.record(8);
+            second.record(24);
+
+            const auto snapshot = allocation_tracker::snapshot();
+            const auto named = std::ranges::count(
+                snapshot,
+                std::string_view("test_allocation_tracker::shared_name"),
+                &allocation_counters::site
+            );
+            CHECK_EQ(named, 1);
+            const auto counters = find_site("test_allocation_tracker::shared_name");
+            CHECK_EQ(counters.allocation_count, 2);
+            CHECK_EQ(counters.allocated_bytes, 32);
+        }
+
+        TEST_CASE("instrumented code paths")
+        {
+            allocation_tracker::reset();
+            const auto tensor_metadata = fixed_shape_tensor_extension::metadata::from_json(
+                R"({"shape":[2,3],"dim_names":["rows","cols"]})"
+            );
+            const auto counters = find_site("fixed_shape_tensor_extension::metadata::from_json");
+
+            if (allocation_tracker::enabled())
+            {
+                CHECK_GT(counters.allocation_count, 0);
+                CHECK_GT(counters.allocated_bytes, 0);
+
+                SUBCASE("allocations outside of any site are not attributed")
+                {
+                    allocation_tracker::reset();
+                    const auto buffer = std::make_unique<char[]>(256);
+                    const auto after = find_site("fixed_shape_tensor_extension::metadata::from_json");
+                    CHECK_EQ(after.allocation_count, 0);
+                }
+            }
+            else
+            {
+                CHECK_EQ(counters.allocation_count, 0);
+                CHECK_EQ(counters.allocated_bytes, 0);
+            }
+            CHECK_EQ(tensor_metadata.shape.size(), 2);
+        }
+
+        TEST_CASE("variable_shape_tensor_builder")
+        {
+            allocation_tracker::reset();
+            variable_shape_tensor_builder<float> builder(1);
+            builder.reserve(2, 3);
+            const std::array<std::int32_t, 1> shape = {3};
+            const std::array<float, 3> values = {1.0f, 2.0f, 3.0f};
+            builder.append(shape, values);
+            builder.append_null();
+            const auto tensor_array = builder.finish();
+
+            const auto reserve = find_site("variable_shape_tensor_builder::reserve");
+            const auto finish = find_site("variable_shape_tensor_builder::finish");
+            if (allocation_tracker::enabled())
+            {
+                CHECK_GT(reserve.allocation_count, 0);
+                CHECK_GT(finish.allocation_count, 0);
+            }
+            else
+            {
+                CHECK_EQ(reserve.allocation_count, 0);
+                CHECK_EQ(finish.allocation_count, 0);
+            }
+            CHECK_EQ(tensor_array.size(), 2);
+        }
+    }
+}
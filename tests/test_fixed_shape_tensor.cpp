@@ -1,4 +1,5 @@
 #include <cstdint>
+#include <string>
 #include <vector>
 
 #include <doctest/doctest.h>
@@ -916,6 +917,56 @@ namespace sparrow_extensions
             }
         }
 
+        TEST_CASE("fixed_shape_tensor_array::slice")
+        {
+            std::vector<float> flat_data(24);
+            std::iota(flat_data.begin(), flat_data.end(), 0.0f);
+
+            sparrow::primitive_array<float> values_array(flat_data);
+            const std::vector<std::int64_t> shape{2, 3};
+            metadata tensor_meta{shape, std::vector<std::string>{"H", "W"}, std::nullopt};
+            const std::uint64_t list_size = static_cast<std::uint64_t>(tensor_meta.compute_size());
+
+            const std::vector<bool> validity{true, false, true, true};
+            const fixed_shape_tensor_array tensor_array(
+                list_size,
+                sparrow::array(std::move(values_array)),
+                tensor_meta,
+                validity
+            );
+
+            const auto check_slice = [&](const fixed_shape_tensor_array& sliced)
+            {
+                REQUIRE_EQ(sliced.size(), 2);
+                CHECK_EQ(sliced.get_arrow_proxy().offset(), 1);
+                CHECK_FALSE(sliced[0].has_value());
+                CHECK(sliced[1].has_value());
+                CHECK_EQ(sliced.shape(), shape);
+                CHECK_EQ(&sliced.get_metadata(), &tensor_array.get_metadata());
+                CHECK(sliced.is_valid());
+            };
+
+            SUBCASE("slice_view shares the buffers")
+            {
+                const auto sliced = tensor_array.slice_view(1, 3);
+                check_slice(sliced);
+                CHECK_EQ(
+                    sliced.get_arrow_proxy().array().children[0]->buffers[1],
+                    tensor_array.get_arrow_proxy().array().children[0]->buffers[1]
+                );
+            }
+
+            SUBCASE("slice")
+            {
+                check_slice(tensor_array.slice(1, 3));
+            }
+
+            SUBCASE("empty slice")
+            {
+                CHECK(tensor_array.slice_view(2, 2).empty());
+            }
+        }
+
         TEST_CASE("fixed_shape_tensor_array::iterators")
         {
             SUBCASE("begin and end")
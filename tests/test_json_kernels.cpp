@@ -0,0 +1,801 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include <sparrow/record_batch.hpp>
+#include <sparrow/utils/nullable.hpp>
+
+#include "sparrow_extensions/fixed_shape_tensor.hpp"
+
+#include "sparrow_extensions/json_kernels.hpp"
+
+using namespace sparrow;
+
+namespace sparrow_extensions
+{
+    namespace
+    {
+        // Valid, invalid, null, valid stored out of line in a view array, invalid
+        std::vector<nullable<std::string>> make_documents()
+        {
+            return {
+                nullable<std::string>(R"({"a": 1})"),
+                nullable<std::string>(R"([1, 2)"),
+                nullable<std::string>(),
+                nullable<std::string>(R"({"message": "stored out of line in view arrays"})"),
+                nullable<std::string>("tru")
+            };
+        }
+
+        std::vector<std::string> make_valid_documents(std::size_t count)
+        {
+            std::vector<std::string> result;
+            result.reserve(count);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                result.push_back(R"({"id": )" + std::to_string(i) + R"(, "tags": ["x", "y"]})");
+            }
+            return result;
+        }
+
+        // Runs check for each JSON array type, in a subcase of its own
+        template <class F>
+        void for_each_json_layout(F&& check)
+        {
+            SUBCASE("json_array")
+            {
+                check(std::type_identity<json_array>{});
+            }
+
+            SUBCASE("big_json_array")
+            {
+                check(std::type_identity<big_json_array>{});
+            }
+
+            SUBCASE("json_view_array")
+            {
+                check(std::type_identity<json_view_array>{});
+            }
+        }
+
+        // Values of a column extracted by extract_json_fields, empty where it is null
+        template <class T>
+        std::vector<std::optional<T>> column_values(const sparrow::array& column)
+        {
+            return column.visit(
+                [](const auto& typed_array)
+                {
+                    std::vector<std::optional<T>> result;
+                    if constexpr (requires { T(typed_array[0].value()); })
+                    {
+                        for (std::size_t i = 0; i < typed_array.size(); ++i)
+                        {
+                            const auto value = typed_array[i];
+                            result.push_back(
+                                value.has_value() ? std::make_optional(T(value.value())) : std::nullopt
+                            );
+                        }
+                    }
+                    return result;
+                }
+            );
+        }
+
+        const std::vector<json_field> event_fields = {
+            {"/id", json_field_type::int64},
+            {"/score", json_field_type::float64},
+            {"/active", json_field_type::boolean},
+            {"/user/name", json_field_type::string},
+            {"/tags/1", json_field_type::string},
+            {"/a~1b", json_field_type::int64}
+        };
+
+        std::vector<nullable<std::string>> make_events()
+        {
+            return {
+                nullable<std::string>(
+                    R"({"id": 1, "score": 0.5, "active": true, "user": {"name": "ada"}, )"
+                    R"("tags": ["x", "y"], "a/b": 7})"
+                ),
+                nullable<std::string>(R"({"id": "2", "score": 3, "active": null, "user": {}, "tags": []})"),
+                nullable<std::string>(),
+                nullable<std::string>(R"(not json)"),
+                nullable<std::string>(R"({"user": {"name": "a name long enough to be stored out of line"}})")
+            };
+        }
+
+        // Checks the columns of event_fields extracted from make_events()
+        void check_event_columns(const std::vector<sparrow::array>& columns)
+        {
+            REQUIRE_EQ(columns.size(), event_fields.size());
+            for (const auto& column : columns)
+            {
+                CHECK_EQ(column.size(), 5);
+            }
+
+            // The second row has an id of the wrong type, an integral score, a null flag and
+            // missing fields, the third one is null and the fourth one is not JSON
+            constexpr auto missing = std::nullopt;
+            using integers = std::vector<std::optional<std::int64_t>>;
+            using strings = std::vector<std::optional<std::string>>;
+            CHECK_EQ(
+                column_values<std::int64_t>(columns[0]),
+                integers{1, missing, missing, missing, missing}
+            );
+            CHECK_EQ(
+                column_values<double>(columns[1]),
+                std::vector<std::optional<double>>{0.5, 3.0, missing, missing, missing}
+            );
+            CHECK_EQ(
+                column_values<bool>(columns[2]),
+                std::vector<std::optional<bool>>{true, missing, missing, missing, missing}
+            );
+            CHECK_EQ(
+                column_values<std::string>(columns[3]),
+                strings{"ada", missing, missing, missing, "a name long enough to be stored out of line"}
+            );
+            CHECK_EQ(
+                column_values<std::string>(columns[4]),
+                strings{"y", missing, missing, missing, missing}
+            );
+            CHECK_EQ(
+                column_values<std::int64_t>(columns[5]),
+                integers{7, missing, missing, missing, missing}
+            );
+        }
+
+        std::vector<std::optional<bool>> flag_values(const bool8_array& flags)
+        {
+            std::vector<std::optional<bool>> result;
+            for (std::size_t i = 0; i < flags.size(); ++i)
+            {
+                const auto flag = flags[i];
+                result.push_back(flag.has_value() ? std::make_optional(bool(flag.value())) : std::nullopt);
+            }
+            return result;
+        }
+
+        // Objects with conflicting, missing and null fields, a null value and an array
+        std::vector<nullable<std::string>> make_records()
+        {
+            return {
+                nullable<std::string>(
+                    R"({"id": 1, "score": 2, "name": "ada", "user": {"age": 30}, "tags": ["x"]})"
+                ),
+                nullable<std::string>(
+                    R"({"id": 2, "score": 0.5, "user": {"age": 31, "admin": true}, "tags": [], )"
+                    R"("extra": null})"
+                ),
+                nullable<std::string>(),
+                nullable<std::string>(R"([1, 2])"),
+                nullable<std::string>(
+                    R"({"id": "3", "score": 1, "name": null, "user": {"age": 32}, "tags": ["y", 1]})"
+                )
+            };
+        }
+
+        json_schema make_records_schema()
+        {
+            return json_schema{{
+                {"id", json_schema_type::json, false, {}},
+                {"score", json_schema_type::float64, false, {}},
+                {"name", json_schema_type::string, true, {}},
+                {"user",
+                 json_schema_type::object,
+                 false,
+                 {{"age", json_schema_type::int64, false, {}},
+                  {"admin", json_schema_type::boolean, true, {}}}},
+                {"tags", json_schema_type::list, false, {{"item", json_schema_type::json, false, {}}}},
+                {"extra", json_schema_type::null, true, {}}
+            }};
+        }
+
+        // Values of a field of shredded records, empty where it is null
+        template <class T>
+        std::vector<std::optional<T>> field_values(const sparrow::struct_array& records, std::size_t field)
+        {
+            std::vector<std::optional<T>> result;
+            for (std::size_t i = 0; i < records.size(); ++i)
+            {
+                std::visit(
+                    [&result](const auto& value)
+                    {
+                        if constexpr (requires { T(value.value()); })
+                        {
+                            result.push_back(
+                                value.has_value() ? std::make_optional(T(value.value())) : std::nullopt
+                            );
+                        }
+                    },
+                    records[i].get()[field]
+                );
+            }
+            return result;
+        }
+
+        // Records with nulls, escaped characters, a non-finite number and a JSON field
+        sparrow::struct_array make_struct_records()
+        {
+            std::vector<sparrow::array> children;
+            children.emplace_back(primitive_array<std::int64_t>(
+                std::vector<nullable<std::int64_t>>{1, -2, nullval, 4},
+                "id"
+            ));
+            children.emplace_back(primitive_array<double>(
+                std::vector<nullable<double>>{0.5, std::numeric_limits<double>::quiet_NaN(), 2, 1e21},
+                "score"
+            ));
+            children.emplace_back(string_array(
+                std::vector<nullable<std::string>>{
+                    nullable<std::string>("ada"),
+                    nullable<std::string>("a \"quoted\"\nline"),
+                    nullable<std::string>(),
+                    nullable<std::string>("a tab\tafter more than eight characters\x01")
+                },
+                "name"
+            ));
+            children.emplace_back(
+                bool8_array(std::vector<nullable<bool>>{true, false, true, nullval}, "flag")
+            );
+            children.emplace_back(json_array(
+                std::vector<nullable<std::string>>{
+                    nullable<std::string>(R"({"a": [1, 2]})"),
+                    nullable<std::string>("7"),
+                    nullable<std::string>(),
+                    nullable<std::string>()
+                },
+                "payload"
+            ));
+            return sparrow::struct_array(std::move(children), std::vector<bool>{true, true, false, true});
+        }
+
+        const std::vector<std::string> serialized_records = {
+            R"({"id":1,"score":0.5,"name":"ada","flag":true,"payload":{"a": [1, 2]}})",
+            R"({"id":-2,"score":null,"name":"a \"quoted\"\nline","flag":false,"payload":7})",
+            "",
+            R"({"id":4,"score":1e+21,"name":"a tab\tafter more than eight characters\u0001","flag":null,)"
+            R"("payload":null})"
+        };
+
+        template <class A>
+        void check_serialized_records(const A& json_values)
+        {
+            REQUIRE_EQ(json_values.size(), serialized_records.size());
+            for (std::size_t i = 0; i < serialized_records.size(); ++i)
+            {
+                if (serialized_records[i].empty())
+                {
+                    CHECK_FALSE(json_values[i].has_value());
+                }
+                else
+                {
+                    REQUIRE(json_values[i].has_value());
+                    CHECK_EQ(std::string(json_values[i].value()), serialized_records[i]);
+                }
+            }
+            CHECK_FALSE(validate_json(json_values).has_value());
+        }
+
+        // Pretty-printed documents, with a null value
+        std::vector<nullable<std::string>> make_pretty_documents()
+        {
+            return {
+                nullable<std::string>("{\n  \"b\": [1, 2.50, -0.0],\n  \"a\": \"x  y\"\n}"),
+                nullable<std::string>(),
+                nullable<std::string>(
+                    R"( { "z": {"d": "\u00e9\n", "c": 1e2}, "a": 12345678901234567890, "m": [true, null] } )"
+                )
+            };
+        }
+
+        template <class A>
+        std::vector<std::optional<std::string>> text_values(const A& json_values)
+        {
+            std::vector<std::optional<std::string>> result;
+            for (std::size_t i = 0; i < json_values.size(); ++i)
+            {
+                const auto value = json_values[i];
+                result.push_back(
+                    value.has_value() ? std::make_optional(std::string(value.value())) : std::nullopt
+                );
+            }
+            return result;
+        }
+
+    }
+
+    TEST_SUITE("json_kernels")
+    {
+        TEST_CASE("array layouts")
+        {
+            // Every kernel reads the three JSON array types through the same buffers
+            for_each_json_layout(
+                []<class A>(std::type_identity<A>)
+                {
+                    const A documents(make_documents());
+                    const auto error = validate_json(documents);
+                    REQUIRE(error.has_value());
+                    CHECK_EQ(error->row, 1);
+                    CHECK_FALSE(error->reason.empty());
+
+                    using flags = std::vector<std::optional<bool>>;
+                    constexpr auto null = std::nullopt;
+                    CHECK_EQ(flag_values(is_valid_json(documents)), flags{true, false, null, true, false});
+
+                    const A events(make_events());
+                    check_event_columns(extract_json_fields(events, event_fields));
+                    const json_index index(events);
+                    check_event_columns(extract_json_fields(index, event_fields));
+
+                    const std::vector<json_predicate> predicates = {
+                        {"/user/name", json_predicate_type::prefix, {"a name"}}
+                    };
+                    CHECK_EQ(
+                        flag_values(filter_json(events, predicates)),
+                        flags{false, false, null, false, true}
+                    );
+
+                    const A records(make_records());
+                    CHECK_EQ(infer_json_schema(records), make_records_schema());
+                    const auto shredded = shred_json(records, make_records_schema());
+                    using texts = std::vector<std::optional<std::string>>;
+                    CHECK_EQ(field_values<std::string>(shredded, 2), texts{"ada", null, null, null, null});
+
+                    const A pretty_documents(make_pretty_documents());
+                    CHECK_EQ(
+                        text_values(minify_json(pretty_documents)),
+                        texts{
+                            R"({"b":[1,2.50,-0.0],"a":"x  y"})",
+                            null,
+                            R"({"z":{"d":"\u00e9\n","c":1e2},"a":12345678901234567890,"m":[true,null]})"
+                        }
+                    );
+                    // Sorted keys, shortest numbers and unescaped strings
+                    CHECK_EQ(
+                        text_values(canonicalize_json(pretty_documents)),
+                        texts{
+                            R"({"a":"x  y","b":[1,2.5,0]})",
+                            null,
+                            "{\"a\":12345678901234567890,\"m\":[true,null],"
+                            "\"z\":{\"c\":100,\"d\":\"\xc3\xa9\\n\"}}"
+                        }
+                    );
+                }
+            );
+        }
+
+        TEST_CASE("many rows")
+        {
+            // Enough rows for the kernels to split them in blocks processed in parallel
+            const json_array json_values(make_valid_documents(5000));
+
+            CHECK_FALSE(validate_json(json_values).has_value());
+
+            const std::vector<json_field> fields = {
+                {"/id", json_field_type::int64},
+                {"/tags/1", json_field_type::string}
+            };
+            const auto columns = extract_json_fields(json_values, fields);
+            const auto ids = column_values<std::int64_t>(columns[0]);
+            REQUIRE_EQ(ids.size(), 5000);
+            CHECK_EQ(ids[4999], 4999);
+            const auto indexed_columns = extract_json_fields(json_index(json_values), fields);
+            CHECK_EQ(column_values<std::string>(indexed_columns[1])[2500], "y");
+
+            const std::vector<json_predicate> predicates = {
+                {"/id", json_predicate_type::range, {}, 100.0, 199.0},
+                {"/tags/1", json_predicate_type::equals, {"y"}}
+            };
+            const auto flags = flag_values(filter_json(json_values, predicates));
+            REQUIRE_EQ(flags.size(), 5000);
+            CHECK_EQ(std::ranges::count(flags, std::optional<bool>(true)), 100);
+            CHECK(flags[150].value());
+            CHECK_FALSE(flags[200].value());
+
+            const json_schema expected_schema{{
+                {"id", json_schema_type::int64, false, {}},
+                {"tags", json_schema_type::list, false, {{"item", json_schema_type::string, false, {}}}}
+            }};
+            CHECK_EQ(infer_json_schema(json_values), expected_schema);
+            const auto serialized = serialize_json(shred_json(json_values, expected_schema));
+            REQUIRE_EQ(serialized.size(), 5000);
+            CHECK_EQ(std::string(serialized[4999].value()), R"({"id":4999,"tags":["x","y"]})");
+
+            auto documents = make_valid_documents(5000);
+            for (auto& document : documents)
+            {
+                document.insert(1, "\n  ");
+            }
+            const auto minified = minify_json(json_array(documents));
+            REQUIRE_EQ(minified.size(), 5000);
+            CHECK_EQ(std::string(minified[0].value()), R"({"id":0,"tags":["x","y"]})");
+            CHECK_EQ(std::string(minified[4999].value()), R"({"id":4999,"tags":["x","y"]})");
+        }
+
+        TEST_CASE("validate_json")
+        {
+            SUBCASE("first invalid row")
+            {
+                // The invalid rows are in different blocks, the first one is reported
+                auto documents = make_valid_documents(5000);
+                documents[4321] = R"({"id": })";
+                documents[4900] = "[";
+                const auto error = validate_json(json_array(documents));
+                REQUIRE(error.has_value());
+                CHECK_EQ(error->row, 4321);
+            }
+
+            SUBCASE("null rows")
+            {
+                const json_array json_values(std::vector<nullable<std::string>>(3));
+                CHECK_FALSE(validate_json(json_values).has_value());
+            }
+
+            SUBCASE("empty array")
+            {
+                CHECK_FALSE(validate_json(json_array(std::vector<std::string>{})).has_value());
+            }
+        }
+
+        TEST_CASE("is_valid_json")
+        {
+            // Scalars and surrounding whitespace are valid, an empty value is not
+            const json_array json_values(std::vector<std::string>{" 1 ", "", "{}", "[1,]"});
+            CHECK_EQ(
+                flag_values(is_valid_json(json_values)),
+                std::vector<std::optional<bool>>{true, false, true, false}
+            );
+        }
+
+        TEST_CASE("extract_json_fields")
+        {
+            SUBCASE("escaped keys")
+            {
+                const json_array json_values(std::vector<std::string>{R"({"a/b": 7, "m~n": 8, "": 9})"});
+                const std::vector<json_field> fields = {
+                    {"/a~1b", json_field_type::int64},
+                    {"/m~0n", json_field_type::int64},
+                    {"/", json_field_type::int64}
+                };
+                const auto columns = extract_json_fields(json_values, fields);
+                using integers = std::vector<std::optional<std::int64_t>>;
+                CHECK_EQ(column_values<std::int64_t>(columns[0]), integers{7});
+                CHECK_EQ(column_values<std::int64_t>(columns[1]), integers{8});
+                CHECK_EQ(column_values<std::int64_t>(columns[2]), integers{9});
+            }
+
+            SUBCASE("invalid pointer")
+            {
+                const json_array events(make_valid_documents(1));
+                const std::vector<json_field> fields = {{"id", json_field_type::int64}};
+                CHECK_THROWS_AS((void) extract_json_fields(events, fields), std::runtime_error);
+            }
+        }
+
+        TEST_CASE("json_index")
+        {
+            SUBCASE("documents")
+            {
+                const json_index index(json_array(make_events()));
+                REQUIRE_EQ(index.size(), 5);
+                CHECK(index.has_document(0));
+                CHECK(index.has_document(1));
+                CHECK_FALSE(index.has_document(2));
+                CHECK_FALSE(index.has_document(3));
+                CHECK(index.has_document(4));
+                CHECK_GT(index.memory_size(), 0);
+
+                // The index answers several queries
+                check_event_columns(extract_json_fields(index, event_fields));
+                check_event_columns(extract_json_fields(index, event_fields));
+            }
+
+            SUBCASE("array indices")
+            {
+                // Array indices with a leading zero or out of the array are missing
+                const json_index index(json_array(make_valid_documents(2)));
+                const std::vector<json_field> fields = {
+                    {"/tags/1", json_field_type::string},
+                    {"/tags/01", json_field_type::string},
+                    {"/tags/2", json_field_type::string}
+                };
+                const auto columns = extract_json_fields(index, fields);
+                using strings = std::vector<std::optional<std::string>>;
+                CHECK_EQ(column_values<std::string>(columns[0]), strings{"y", "y"});
+                CHECK_EQ(column_values<std::string>(columns[1]), strings(2));
+                CHECK_EQ(column_values<std::string>(columns[2]), strings(2));
+            }
+
+            SUBCASE("invalid pointer")
+            {
+                const json_index index(json_array(make_valid_documents(1)));
+                const std::vector<json_field> fields = {{"id~", json_field_type::int64}};
+                CHECK_THROWS_AS((void) extract_json_fields(index, fields), std::runtime_error);
+            }
+        }
+
+        TEST_CASE("filter_json")
+        {
+            const json_array events(make_events());
+            const auto filter = [&events](std::vector<json_predicate> predicates)
+            {
+                return flag_values(filter_json(events, predicates));
+            };
+
+            // The third row is null and the fourth one is not JSON
+            constexpr auto null = std::nullopt;
+            using flags = std::vector<std::optional<bool>>;
+            using type = json_predicate_type;
+            const flags first{true, false, null, false, false};
+            const flags second{false, true, null, false, false};
+            const flags none{false, false, null, false, false};
+
+            SUBCASE("predicates")
+            {
+                CHECK_EQ(filter({{"/user/name", type::exists}}), flags{true, false, null, false, true});
+                CHECK_EQ(filter({{"/tags/1", type::exists}}), first);
+                CHECK_EQ(filter({{"/id", type::equals, {std::int64_t{1}}}}), first);
+                CHECK_EQ(filter({{"/id", type::equals, {"2"}}}), second);
+                CHECK_EQ(filter({{"/score", type::equals, {3.0}}}), second);
+                CHECK_EQ(filter({{"/active", type::equals, {nullptr}}}), second);
+                CHECK_EQ(filter({{"/active", type::equals, {true}}}), first);
+                CHECK_EQ(filter({{"/score", type::range, {}, 1.0, 5.0}}), second);
+                CHECK_EQ(filter({{"/score", type::range, {}, 0.0}}), flags{true, true, null, false, false});
+                CHECK_EQ(filter({{"/user/name", type::in_set, {"bob", "ada"}}}), first);
+                CHECK_EQ(filter({{"/a~1b", type::in_set, {std::int64_t{7}, 8.5}}}), first);
+
+                // A row matches all the predicates
+                CHECK_EQ(
+                    filter({{"/user/name", type::prefix, {"a"}}, {"/id", type::range, {}, 0.0, 10.0}}),
+                    first
+                );
+            }
+
+            SUBCASE("predicate misses")
+            {
+                // Missing fields, and fields of another type than the values of the predicate
+                CHECK_EQ(filter({{"/missing", type::exists}}), none);
+                CHECK_EQ(filter({{"/user", type::equals, {"ada"}}}), none);
+                CHECK_EQ(filter({{"/id", type::equals, {"1"}}}), none);
+                CHECK_EQ(filter({{"/id", type::range, {}, 2.0, 2.0}}), none);
+                CHECK_EQ(filter({{"/score", type::prefix, {"0"}}}), none);
+                CHECK_EQ(filter({{"/user/name", type::in_set, {}}}), none);
+                CHECK_EQ(filter({{"/tags/1", type::exists}, {"/id", type::equals, {std::int64_t{2}}}}), none);
+            }
+
+            SUBCASE("escaped text")
+            {
+                // Rows spelling the text of a predicate with escape sequences are parsed
+                const json_array json_values(std::vector<std::string>{
+                    R"({"name": "\u0061da"})",
+                    R"({"name": "bob"})"
+                });
+                const std::vector<json_predicate> predicates = {{"/name", type::equals, {"ada"}}};
+                CHECK_EQ(flag_values(filter_json(json_values, predicates)), flags{true, false});
+            }
+
+            SUBCASE("escaped keys")
+            {
+                const json_array json_values(std::vector<std::string>{
+                    R"({"m~n": {"a/b": "x"}})",
+                    R"({"m~n": {"ab": "x"}})"
+                });
+                const std::vector<json_predicate> predicates = {{"/m~0n/a~1b", type::equals, {"x"}}};
+                CHECK_EQ(flag_values(filter_json(json_values, predicates)), flags{true, false});
+            }
+
+            SUBCASE("invalid rows")
+            {
+                // Rows that are not JSON never match, even when they contain the needles
+                const json_array json_values(std::vector<std::string>{
+                    R"({"active": true})",
+                    R"({"active": tru})",
+                    R"("active": true)"
+                });
+                const std::vector<json_predicate> predicates = {{"/active", type::equals, {true}}};
+                CHECK_EQ(flag_values(filter_json(json_values, predicates)), flags{true, false, false});
+            }
+
+            SUBCASE("invalid predicates")
+            {
+                const auto check_invalid = [&events](const json_predicate& predicate)
+                {
+                    const std::vector<json_predicate> predicates = {predicate};
+                    CHECK_THROWS_AS((void) filter_json(events, predicates), std::runtime_error);
+                };
+                check_invalid({"id", type::exists});
+                check_invalid({"/id", type::equals, {std::int64_t{1}, std::int64_t{2}}});
+                check_invalid({"/id", type::prefix, {std::int64_t{1}}});
+            }
+        }
+
+        TEST_CASE("infer_json_schema")
+        {
+            SUBCASE("sample")
+            {
+                const auto schema = infer_json_schema(json_array(make_records()), {.sample_size = 1});
+                const json_schema expected{{
+                    {"id", json_schema_type::int64, false, {}},
+                    {"score", json_schema_type::int64, false, {}},
+                    {"name", json_schema_type::string, false, {}},
+                    {"user", json_schema_type::object, false, {{"age", json_schema_type::int64, false, {}}}},
+                    {"tags", json_schema_type::list, false, {{"item", json_schema_type::string, false, {}}}}
+                }};
+                CHECK_EQ(schema, expected);
+            }
+
+            SUBCASE("invalid rows")
+            {
+                // Invalid documents and the values that are not objects are ignored
+                const json_array json_values(
+                    std::vector<std::string>{R"({"id": 1})", "not json", "[1]", "2"}
+                );
+                const json_schema expected{{{"id", json_schema_type::int64, false, {}}}};
+                CHECK_EQ(infer_json_schema(json_values), expected);
+            }
+
+            SUBCASE("empty array")
+            {
+                CHECK(infer_json_schema(json_array(std::vector<std::string>{})).fields.empty());
+            }
+        }
+
+        TEST_CASE("shred_json")
+        {
+            SUBCASE("rows")
+            {
+                // The null value, the array and the invalid document give null rows
+                auto records = make_records();
+                records.push_back(nullable<std::string>("not json"));
+                const auto shredded = shred_json(json_array(records), make_records_schema());
+                REQUIRE_EQ(shredded.size(), 6);
+                CHECK(shredded[0].has_value());
+                CHECK(shredded[1].has_value());
+                CHECK_FALSE(shredded[2].has_value());
+                CHECK_FALSE(shredded[3].has_value());
+                CHECK(shredded[4].has_value());
+                CHECK_FALSE(shredded[5].has_value());
+
+                constexpr auto missing = std::nullopt;
+                CHECK_EQ(
+                    field_values<double>(shredded, 1),
+                    std::vector<std::optional<double>>{2.0, 0.5, missing, missing, 1.0, missing}
+                );
+            }
+
+            SUBCASE("fields out of the schema")
+            {
+                // The ids are not strings and the missing field is not in the values
+                const json_schema schema{{
+                    {"id", json_schema_type::string, true, {}},
+                    {"missing", json_schema_type::int64, true, {}}
+                }};
+                const auto shredded = shred_json(json_array(make_valid_documents(3)), schema);
+                REQUIRE_EQ(shredded.size(), 3);
+                using strings = std::vector<std::optional<std::string>>;
+                using integers = std::vector<std::optional<std::int64_t>>;
+                CHECK_EQ(field_values<std::string>(shredded, 0), strings(3));
+                CHECK_EQ(field_values<std::int64_t>(shredded, 1), integers(3));
+            }
+        }
+
+        TEST_CASE("serialize_json")
+        {
+            SUBCASE("struct_array")
+            {
+                check_serialized_records(serialize_json(make_struct_records()));
+            }
+
+            SUBCASE("big_json_array")
+            {
+                check_serialized_records(serialize_big_json(make_struct_records()));
+            }
+
+            SUBCASE("record_batch")
+            {
+                fixed_shape_tensor_array tensors(
+                    2,
+                    sparrow::array(primitive_array<float>(std::vector<float>{1.5f, 2, 3, 4})),
+                    fixed_shape_tensor_extension::metadata{{2}, std::nullopt, std::nullopt}
+                );
+                std::vector<sparrow::array> columns;
+                columns.emplace_back(primitive_array<std::int32_t>(std::vector<std::int32_t>{7, 8}));
+                columns.emplace_back(std::move(tensors));
+                std::vector<std::string> names{"id", "tensor"};
+                const sparrow::record_batch batch(std::move(names), std::move(columns));
+
+                const auto json_values = serialize_json(batch);
+                REQUIRE_EQ(json_values.size(), 2);
+                CHECK_EQ(std::string(json_values[0].value()), R"({"id":7,"tensor":[1.5,2]})");
+                CHECK_EQ(std::string(json_values[1].value()), R"({"id":8,"tensor":[3,4]})");
+            }
+        }
+
+        TEST_CASE("minify_json")
+        {
+            SUBCASE("invalid rows")
+            {
+                // The values are not validated, only the whitespace is removed
+                const json_array json_values(std::vector<std::string>{"[1, 2", "{ } }"});
+                CHECK_EQ(
+                    text_values(minify_json(json_values)),
+                    std::vector<std::optional<std::string>>{"[1,2", "{}}"}
+                );
+            }
+
+            SUBCASE("unterminated string")
+            {
+                const json_array json_values(std::vector<std::string>{R"({"a": "x })"});
+                CHECK_THROWS_AS((void) minify_json(json_values), std::runtime_error);
+            }
+        }
+
+        TEST_CASE("rewriting kernels report the first invalid row")
+        {
+            // The invalid rows are in different blocks, the first one is reported
+            auto documents = make_valid_documents(5000);
+            documents[1500] = R"({"id": "x })";
+            documents[4800] = R"({"id": "y })";
+            const json_array json_values(documents);
+            const auto error_message = [](auto&& rewrite)
+            {
+                try
+                {
+                    (void) rewrite();
+                }
+                catch (const std::runtime_error& error)
+                {
+                    return std::string(error.what());
+                }
+                return std::string();
+            };
+
+            const auto minify_error = error_message([&]() { return minify_json(json_values); });
+            CHECK(minify_error.starts_with("minify_json: row 1500 "));
+            const auto canonicalize_error = error_message([&]() { return canonicalize_json(json_values); });
+            CHECK(canonicalize_error.starts_with("canonicalize_json: row 1500 "));
+        }
+
+        TEST_CASE("canonicalize_json")
+        {
+            SUBCASE("equal documents")
+            {
+                const json_array json_values(std::vector<std::string>{
+                    R"({"id": 1, "tags": ["x"], "score": 1.0})",
+                    R"({ "score": 1, "tags": [ "\u0078" ], "id": 1 })"
+                });
+                const auto canonical = canonicalize_json(json_values);
+                CHECK_EQ(std::string(canonical[0].value()), std::string(canonical[1].value()));
+            }
+
+            SUBCASE("invalid document")
+            {
+                const json_array json_values(make_documents());
+                CHECK_THROWS_AS((void) canonicalize_json(json_values), std::runtime_error);
+            }
+        }
+    }
+}
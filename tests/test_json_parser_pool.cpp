@@ -0,0 +1,103 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <doctest/doctest.h>
+
+#include "sparrow_extensions/json_parser_pool.hpp"
+#include "sparrow_extensions/parallel.hpp"
+
+namespace sparrow_extensions
+{
+    TEST_SUITE("json_parser_pool")
+    {
+        TEST_CASE("json_parser_pool")
+        {
+            SUBCASE("parsers are reused")
+            {
+                detail::json_parser_pool<simdjson::dom::parser> pool(2);
+                const simdjson::dom::parser* first = nullptr;
+                {
+                    const auto parser = pool.acquire();
+                    first = &*parser;
+                    CHECK_EQ(pool.idle_count(), 0);
+                }
+                CHECK_EQ(pool.idle_count(), 1);
+                const auto parser = pool.acquire();
+                CHECK_EQ(&*parser, first);
+                CHECK_EQ(pool.idle_count(), 0);
+            }
+
+            SUBCASE("idle parsers are bounded")
+            {
+                detail::json_parser_pool<simdjson::ondemand::parser> pool(1);
+                {
+                    const auto first = pool.acquire();
+                    const auto second = pool.acquire();
+                    CHECK_NE(&*first, &*second);
+                }
+                CHECK_EQ(pool.idle_count(), 1);
+                CHECK_EQ(pool.max_idle_count(), 1);
+            }
+
+            SUBCASE("parsers keep their capacity")
+            {
+                detail::json_parser_pool<simdjson::dom::parser> pool(1);
+                const std::string document = "[" + std::string(100000, ' ') + "1]";
+                {
+                    const auto parser = pool.acquire();
+                    CHECK_EQ(parser->parse(document).error(), simdjson::SUCCESS);
+                }
+                const auto parser = pool.acquire();
+                CHECK_GE(parser->capacity(), document.size());
+            }
+
+            SUBCASE("concurrent leases")
+            {
+                detail::json_parser_pool<simdjson::ondemand::parser> pool(4);
+                std::atomic<std::size_t> sum = 0;
+                detail::parallel_for(
+                    1000,
+                    10,
+                    [&](std::size_t begin, std::size_t end)
+                    {
+                        auto parser = pool.acquire();
+                        for (std::size_t i = begin; i < end; ++i)
+                        {
+                            const simdjson::padded_string json(R"({"value": )" + std::to_string(i) + "}");
+                            simdjson::ondemand::document document = parser->iterate(json);
+                            const std::int64_t value = document["value"].get_int64();
+                            sum += static_cast<std::size_t>(value);
+                        }
+                    }
+                );
+                CHECK_EQ(sum.load(), 999 * 1000 / 2);
+                CHECK_LE(pool.idle_count(), 4);
+            }
+
+            SUBCASE("library pools")
+            {
+                CHECK_GE(detail::dom_parser_pool().max_idle_count(), 1);
+                CHECK_GE(detail::ondemand_parser_pool().max_idle_count(), 1);
+                const std::string document = R"({"a": 1})";
+                const auto parser = detail::dom_parser_pool().acquire();
+                CHECK_EQ(parser->parse(document).error(), simdjson::SUCCESS);
+            }
+        }
+    }
+}
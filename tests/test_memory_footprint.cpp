@@ -0,0 +1,280 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include <sparrow/array.hpp>
+#include <sparrow/dictionary_encoded_array.hpp>
+#include <sparrow/list_array.hpp>
+#include <sparrow/primitive_array.hpp>
+
+#include "sparrow_extensions/bool8_array.hpp"
+#include "sparrow_extensions/fixed_shape_tensor.hpp"
+#include "sparrow_extensions/json_array.hpp"
+#include "sparrow_extensions/memory_footprint.hpp"
+#include "sparrow_extensions/uuid_array.hpp"
+#include "sparrow_extensions/variable_shape_tensor.hpp"
+
+namespace sparrow_extensions
+{
+    namespace
+    {
+        const buffer_footprint* find_buffer(const memory_footprint& footprint, std::string_view name)
+        {
+            for (const auto& buffer : footprint.buffers)
+            {
+                if (buffer.name == name)
+                {
+                    return &buffer;
+                }
+            }
+            return nullptr;
+        }
+
+        void check_consistency(const memory_footprint& footprint)
+        {
+            CHECK_EQ(footprint.total_bytes(), footprint.owned_bytes() + footprint.shared_bytes());
+            for (const auto& buffer : footprint.buffers)
+            {
+                CHECK_GE(buffer.capacity, buffer.size);
+            }
+        }
+    }
+
+    TEST_SUITE("memory_footprint")
+    {
+        TEST_CASE("bool8_array")
+        {
+            const bool8_array arr(std::vector<bool>(100, true));
+            const auto footprint = get_memory_footprint(arr);
+            check_consistency(footprint);
+
+            const auto* values = find_buffer(footprint, "values");
+            REQUIRE(values != nullptr);
+            CHECK_GE(values->size, 100);
+            CHECK(values->owned);
+            CHECK(footprint.children.empty());
+            CHECK_EQ(footprint.shared_bytes(), 0);
+        }
+
+        TEST_CASE("uuid_array")
+        {
+            std::vector<std::array<sparrow::byte_t, 16>> uuids(8);
+            const uuid_array arr(uuids);
+            const auto footprint = get_memory_footprint(arr);
+            check_consistency(footprint);
+
+            const auto* values = find_buffer(footprint, "values");
+            REQUIRE(values != nullptr);
+            CHECK_GE(values->size, 8 * uuid_extension::UUID_SIZE);
+        }
+
+        TEST_CASE("json arrays")
+        {
+            const std::vector<std::string> json_values = {R"({"a": 1})", R"({"b": 2})", R"([1, 2, 3])"};
+            std::size_t payload_size = 0;
+            for (const auto& value : json_values)
+            {
+                payload_size += value.size();
+            }
+
+            SUBCASE("json_array")
+            {
+                const json_array arr(json_values);
+                const auto footprint = get_memory_footprint(arr);
+                check_consistency(footprint);
+
+                const auto* offsets = find_buffer(footprint, "offsets");
+                const auto* values = find_buffer(footprint, "values");
+                REQUIRE(offsets != nullptr);
+                REQUIRE(values != nullptr);
+                CHECK_GE(offsets->size, (json_values.size() + 1) * sizeof(std::int32_t));
+                CHECK_GE(values->size, payload_size);
+            }
+
+            SUBCASE("big_json_array")
+            {
+                const big_json_array arr(json_values);
+                const auto footprint = get_memory_footprint(arr);
+                check_consistency(footprint);
+
+                const auto* offsets = find_buffer(footprint, "offsets");
+                REQUIRE(offsets != nullptr);
+                CHECK_GE(offsets->size, (json_values.size() + 1) * sizeof(std::int64_t));
+            }
+
+            SUBCASE("json_view_array")
+            {
+                const json_view_array arr(json_values);
+                const auto footprint = get_memory_footprint(arr);
+                check_consistency(footprint);
+
+                const auto* views = find_buffer(footprint, "views");
+                REQUIRE(views != nullptr);
+                CHECK_GE(views->size, json_values.size() * 16);
+            }
+        }
+
+        TEST_CASE("fixed_shape_tensor_array")
+        {
+            std::vector<float> flat_data(12, 1.0f);
+            fixed_shape_tensor_extension::metadata tensor_meta{{2, 3}, std::nullopt, std::nullopt};
+            const fixed_shape_tensor_array arr(
+                static_cast<std::uint64_t>(tensor_meta.compute_size()),
+                sparrow::array(sparrow::primitive_array<float>(flat_data)),
+                tensor_meta
+            );
+            const auto footprint = get_memory_footprint(arr);
+            check_consistency(footprint);
+
+            REQUIRE_EQ(footprint.children.size(), 1);
+            const auto* values = find_buffer(footprint.children[0], "values");
+            REQUIRE(values != nullptr);
+            CHECK_GE(values->size, flat_data.size() * sizeof(float));
+            CHECK_GE(footprint.total_bytes(), flat_data.size() * sizeof(float));
+        }
+
+        TEST_CASE("variable_shape_tensor_array")
+        {
+            sparrow::primitive_array<float> flat_data(
+                {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f, 10.0f}
+            );
+            std::vector<std::size_t> offsets = {0, 6, 10};
+            sparrow::list_array tensor_data(sparrow::array(std::move(flat_data)), std::move(offsets));
+            sparrow::primitive_array<std::int32_t> flat_shapes({2, 3, 1, 4});
+            sparrow::fixed_sized_list_array tensor_shapes(2, sparrow::array(std::move(flat_shapes)));
+
+            const variable_shape_tensor_array arr(
+                2,
+                sparrow::array(std::move(tensor_data)),
+                sparrow::array(std::move(tensor_shapes)),
+                variable_shape_tensor_extension::metadata{std::nullopt, std::nullopt, std::nullopt}
+            );
+            const auto footprint = get_memory_footprint(arr);
+            check_consistency(footprint);
+
+            REQUIRE_EQ(footprint.children.size(), 2);
+            CHECK_EQ(footprint.children[0].name, "data");
+            CHECK_EQ(footprint.children[1].name, "shape");
+            CHECK(find_buffer(footprint.children[0], "offsets") != nullptr);
+            CHECK_GE(footprint.total_bytes(), 10 * sizeof(float) + 4 * sizeof(std::int32_t));
+        }
+
+        TEST_CASE("sparrow::array")
+        {
+            sparrow::array arr(sparrow::primitive_array<std::int32_t>({1, 2, 3, 4}));
+            const auto footprint = get_memory_footprint(arr);
+            check_consistency(footprint);
+
+            const auto* validity = find_buffer(footprint, "validity");
+            const auto* values = find_buffer(footprint, "values");
+            REQUIRE(validity != nullptr);
+            REQUIRE(values != nullptr);
+            CHECK_EQ(values->size, 4 * sizeof(std::int32_t));
+            CHECK_EQ(footprint.total_bytes(), validity->size + values->size);
+            CHECK_EQ(footprint.owned_bytes(), footprint.total_bytes());
+            CHECK_EQ(footprint.shared_bytes(), 0);
+
+            SUBCASE("imported")
+            {
+                // A proxy over the ArrowArray of another array references its buffers
+                auto& proxy = sparrow::detail::array_access::get_arrow_proxy(arr);
+                const sparrow::arrow_proxy imported(&proxy.array(), &proxy.schema());
+                const auto imported_footprint = get_memory_footprint(imported);
+                check_consistency(imported_footprint);
+
+                const auto* imported_values = find_buffer(imported_footprint, "values");
+                REQUIRE(imported_values != nullptr);
+                CHECK_EQ(imported_values->data, values->data);
+                CHECK_FALSE(imported_values->owned);
+                CHECK_EQ(imported_footprint.total_bytes(), footprint.total_bytes());
+                CHECK_EQ(imported_footprint.owned_bytes(), 0);
+                CHECK_EQ(imported_footprint.shared_bytes(), footprint.total_bytes());
+            }
+        }
+
+        TEST_CASE("dictionary_encoded_array")
+        {
+            using dictionary_array = sparrow::dictionary_encoded_array<std::uint32_t>;
+            dictionary_array::keys_buffer_type keys(std::vector<std::uint32_t>{0, 1, 0, 1});
+            sparrow::array dictionary_values(sparrow::primitive_array<std::int64_t>({10, 20}));
+            const dictionary_array arr(
+                std::move(keys),
+                std::move(dictionary_values),
+                std::vector<bool>(4, true)
+            );
+            const auto footprint = get_memory_footprint(arr);
+            check_consistency(footprint);
+
+            CHECK(footprint.children.empty());
+            REQUIRE_EQ(footprint.dictionary.size(), 1);
+            const auto* keys_values = find_buffer(footprint, "values");
+            const auto* dictionary_buffer = find_buffer(footprint.dictionary[0], "values");
+            REQUIRE(keys_values != nullptr);
+            REQUIRE(dictionary_buffer != nullptr);
+            CHECK_EQ(dictionary_buffer->size, 2 * sizeof(std::int64_t));
+            CHECK(dictionary_buffer->owned);
+            CHECK_GE(footprint.total_bytes(), keys_values->size + dictionary_buffer->size);
+            CHECK_EQ(footprint.owned_bytes(), footprint.total_bytes());
+        }
+
+        TEST_CASE("slice_view")
+        {
+            sparrow::primitive_array<float> flat_data({1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f});
+            std::vector<std::size_t> offsets = {0, 2, 6};
+            sparrow::list_array tensor_data(sparrow::array(std::move(flat_data)), std::move(offsets));
+            sparrow::primitive_array<std::int32_t> flat_shapes({1, 2, 2, 2});
+            sparrow::fixed_sized_list_array tensor_shapes(2, sparrow::array(std::move(flat_shapes)));
+            const variable_shape_tensor_array arr(
+                2,
+                sparrow::array(std::move(tensor_data)),
+                sparrow::array(std::move(tensor_shapes)),
+                variable_shape_tensor_extension::metadata{std::nullopt, std::nullopt, std::nullopt}
+            );
+            const auto footprint = get_memory_footprint(arr);
+            CHECK_EQ(footprint.owned_bytes(), footprint.total_bytes());
+
+            // The view references the buffers of arr, none of them is owned
+            const auto view = arr.slice_view(1, 2);
+            const auto view_footprint = get_memory_footprint(view);
+            check_consistency(view_footprint);
+            REQUIRE_EQ(view_footprint.children.size(), 2);
+            const auto* values = find_buffer(footprint.children[0].children[0], "values");
+            const auto* view_values = find_buffer(view_footprint.children[0].children[0], "values");
+            REQUIRE(values != nullptr);
+            REQUIRE(view_values != nullptr);
+            CHECK_EQ(view_values->data, values->data);
+            CHECK_EQ(view_values->size, 6 * sizeof(float));
+            CHECK_EQ(view_footprint.owned_bytes(), 0);
+            CHECK_EQ(view_footprint.shared_bytes(), view_footprint.total_bytes());
+        }
+
+        TEST_CASE("empty footprint")
+        {
+            const memory_footprint footprint;
+            CHECK_EQ(footprint.total_bytes(), 0);
+            CHECK_EQ(footprint.owned_bytes(), 0);
+            CHECK_EQ(footprint.shared_bytes(), 0);
+            CHECK_EQ(footprint.slack_bytes(), 0);
+        }
+    }
+}
@@ -0,0 +1,151 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include "sparrow_extensions/json_kernels.hpp"
+#include "sparrow_extensions/ndjson_reader.hpp"
+
+namespace sparrow_extensions
+{
+    namespace
+    {
+        // Temporary file removed on destruction
+        class temporary_file
+        {
+        public:
+
+            temporary_file(std::string_view name, std::string_view content)
+                : m_path(std::filesystem::temp_directory_path() / name)
+            {
+                std::ofstream stream(m_path, std::ios::binary);
+                stream.write(content.data(), static_cast<std::streamsize>(content.size()));
+            }
+
+            ~temporary_file()
+            {
+                std::error_code error;
+                std::filesystem::remove(m_path, error);
+            }
+
+            temporary_file(const temporary_file&) = delete;
+            temporary_file& operator=(const temporary_file&) = delete;
+
+            [[nodiscard]] const std::filesystem::path& path() const
+            {
+                return m_path;
+            }
+
+        private:
+
+            std::filesystem::path m_path;
+        };
+
+        // Blank lines, a CRLF terminator and no terminator after the last line
+        constexpr std::string_view ndjson_content = "\n{\"a\": 1}\n\n{\"b\": [1, 2]}\r\n  \n{\"c\": \"x\"}";
+
+        std::vector<std::string> array_values(const json_array& json_values)
+        {
+            std::vector<std::string> result;
+            for (std::size_t i = 0; i < json_values.size(); ++i)
+            {
+                result.emplace_back(json_values[i].value());
+            }
+            return result;
+        }
+    }
+
+    TEST_SUITE("ndjson_reader")
+    {
+        TEST_CASE("read_ndjson")
+        {
+            const temporary_file file("sparrow_extensions_read_ndjson.ndjson", ndjson_content);
+
+            SUBCASE("mapped")
+            {
+                const auto result = read_ndjson(file.path());
+                REQUIRE(std::holds_alternative<json_array>(result));
+                const auto& json_values = std::get<json_array>(result);
+                CHECK_EQ(
+                    array_values(json_values),
+                    std::vector<std::string>{"{\"a\": 1}\n\n", "{\"b\": [1, 2]}\r\n  \n", "{\"c\": \"x\"}"}
+                );
+                CHECK_FALSE(validate_json(json_values).has_value());
+            }
+
+            SUBCASE("trimmed")
+            {
+                const auto result = read_ndjson(file.path(), {.trim_line_endings = true});
+                REQUIRE(std::holds_alternative<json_array>(result));
+                CHECK_EQ(
+                    array_values(std::get<json_array>(result)),
+                    std::vector<std::string>{"{\"a\": 1}", "{\"b\": [1, 2]}", "{\"c\": \"x\"}"}
+                );
+            }
+
+            SUBCASE("validated")
+            {
+                const auto result = read_ndjson(file.path(), {.validate = true});
+                CHECK_EQ(std::get<json_array>(result).size(), 3);
+            }
+
+            SUBCASE("invalid line")
+            {
+                const temporary_file invalid_file(
+                    "sparrow_extensions_read_ndjson_invalid.ndjson",
+                    "{\"a\": 1}\n\n{\"b\": \n"
+                );
+                CHECK_EQ(std::get<json_array>(read_ndjson(invalid_file.path())).size(), 2);
+                const ndjson_read_options options{.validate = true};
+                CHECK_THROWS_AS((void) read_ndjson(invalid_file.path(), options), std::runtime_error);
+            }
+
+            SUBCASE("many lines")
+            {
+                std::string content;
+                for (std::size_t i = 0; i < 100000; ++i)
+                {
+                    content += "{\"id\": " + std::to_string(i) + "}\n";
+                }
+                const temporary_file large_file("sparrow_extensions_read_ndjson_large.ndjson", content);
+                const ndjson_read_options options{.validate = true, .trim_line_endings = true};
+                const auto result = read_ndjson(large_file.path(), options);
+                const auto& json_values = std::get<json_array>(result);
+                REQUIRE_EQ(json_values.size(), 100000);
+                CHECK_EQ(std::string(json_values[99999].value()), "{\"id\": 99999}");
+            }
+
+            SUBCASE("empty file")
+            {
+                const temporary_file empty_file("sparrow_extensions_read_ndjson_empty.ndjson", "");
+                CHECK_EQ(std::get<json_array>(read_ndjson(empty_file.path())).size(), 0);
+            }
+
+            SUBCASE("missing file")
+            {
+                const auto missing_path = std::filesystem::temp_directory_path() / "sparrow_extensions.none";
+                CHECK_THROWS_AS((void) read_ndjson(missing_path), std::runtime_error);
+            }
+        }
+    }
+}
@@ -0,0 +1,96 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include "sparrow_extensions/parallel.hpp"
+
+namespace sparrow_extensions
+{
+    TEST_SUITE("parallel")
+    {
+        TEST_CASE("parallel_for")
+        {
+            SUBCASE("visits every index once")
+            {
+                constexpr std::size_t count = 10000;
+                std::vector<int> visits(count, 0);
+                detail::parallel_for(
+                    count,
+                    16,
+                    [&visits](std::size_t begin, std::size_t end)
+                    {
+                        for (std::size_t i = begin; i < end; ++i)
+                        {
+                            ++visits[i];
+                        }
+                    }
+                );
+                CHECK_EQ(visits, std::vector<int>(count, 1));
+            }
+
+            SUBCASE("small range runs as a single chunk")
+            {
+                std::size_t chunk_count = 0;
+                detail::parallel_for(
+                    10,
+                    100,
+                    [&chunk_count](std::size_t begin, std::size_t end)
+                    {
+                        CHECK_EQ(begin, 0);
+                        CHECK_EQ(end, 10);
+                        ++chunk_count;
+                    }
+                );
+                CHECK_EQ(chunk_count, 1);
+            }
+
+            SUBCASE("empty range")
+            {
+                bool called = false;
+                detail::parallel_for(
+                    0,
+                    1,
+                    [&called](std::size_t, std::size_t)
+                    {
+                        called = true;
+                    }
+                );
+                CHECK_FALSE(called);
+            }
+
+            SUBCASE("exceptions are propagated")
+            {
+                CHECK_THROWS_AS(
+                    detail::parallel_for(
+                        1000,
+                        1,
+                        [](std::size_t begin, std::size_t end)
+                        {
+                            if (begin == 0 && end > 0)
+                            {
+                                throw std::runtime_error("first chunk");
+                            }
+                        }
+                    ),
+                    std::runtime_error
+                );
+            }
+        }
+    }
+}
@@ -0,0 +1,117 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <concepts>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include <sparrow/array.hpp>
+
+#include "sparrow_extensions/bool8_array.hpp"
+#include "sparrow_extensions/json_array.hpp"
+#include "sparrow_extensions/registration.hpp"
+#include "sparrow_extensions/uuid_array.hpp"
+
+namespace sparrow_extensions
+{
+    TEST_SUITE("registration")
+    {
+        TEST_CASE("extension_kind")
+        {
+            CHECK_EQ(extension_kind::bool8 & extension_kind::all, extension_kind::bool8);
+            CHECK_EQ(extension_kind::json & extension_kind::uuid, extension_kind::none);
+
+            const auto tensors = extension_kind::fixed_shape_tensor | extension_kind::variable_shape_tensor;
+            CHECK_EQ(tensors & extension_kind::fixed_shape_tensor, extension_kind::fixed_shape_tensor);
+            CHECK_EQ(tensors & extension_kind::bool8, extension_kind::none);
+        }
+
+        TEST_CASE("register_extensions")
+        {
+            // Round-trips through the C data interface so that the array is rebuilt by the sparrow
+            // registry from the extension metadata, rather than wrapped from the typed array.
+            const auto round_trip = [](sparrow::array source)
+            {
+                auto [arrow_array, arrow_schema] = sparrow::extract_arrow_structures(std::move(source));
+                return sparrow::array(std::move(arrow_array), std::move(arrow_schema));
+            };
+
+            register_extensions(extension_kind::bool8 | extension_kind::json);
+
+            SUBCASE("resolves bool8_array")
+            {
+                const std::vector<bool> values = {true, false, true};
+                const sparrow::array arr = round_trip(sparrow::array(bool8_array{values}));
+                arr.visit(
+                    [](auto&& typed_array)
+                    {
+                        CHECK(std::same_as<std::remove_cvref_t<decltype(typed_array)>, bool8_array>);
+                        CHECK_EQ(typed_array.size(), 3);
+                    }
+                );
+            }
+
+            SUBCASE("resolves json_array")
+            {
+                const std::vector<std::string> json_values = {R"({"a": 1})", R"([1, 2])"};
+                const sparrow::array arr = round_trip(sparrow::array(json_array{json_values}));
+                arr.visit(
+                    [](auto&& typed_array)
+                    {
+                        CHECK(std::same_as<std::remove_cvref_t<decltype(typed_array)>, json_array>);
+                        CHECK_EQ(typed_array.size(), 2);
+                    }
+                );
+            }
+
+            SUBCASE("is idempotent")
+            {
+                register_extensions(extension_kind::bool8 | extension_kind::json);
+                register_bool8_extension();
+
+                const std::vector<bool> values = {true, false};
+                const sparrow::array arr = round_trip(sparrow::array(bool8_array{values}));
+                arr.visit(
+                    [](auto&& typed_array)
+                    {
+                        CHECK(std::same_as<std::remove_cvref_t<decltype(typed_array)>, bool8_array>);
+                    }
+                );
+            }
+
+#if defined(SPARROW_EXTENSIONS_DISABLE_AUTO_REGISTRATION)
+            // With auto-registration, every type registers itself when the library is loaded.
+            SUBCASE("leaves types outside the mask unresolved")
+            {
+                register_extensions(extension_kind::none);
+
+                const std::vector<std::array<sparrow::byte_t, 16>> uuids(2);
+                const sparrow::array arr = round_trip(sparrow::array(uuid_array{uuids}));
+                arr.visit(
+                    [](auto&& typed_array)
+                    {
+                        CHECK_FALSE(std::same_as<std::remove_cvref_t<decltype(typed_array)>, uuid_array>);
+                        CHECK_EQ(typed_array.size(), 2);
+                    }
+                );
+            }
+#endif
+        }
+    }
+}
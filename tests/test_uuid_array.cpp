@@ -186,6 +186,22 @@ namespace sparrow_extensions
             }
         }
 
+        TEST_CASE("slice_view")
+        {
+            const auto [ar, input_values] = make_array(5);
+            const auto sliced = ar.slice_view(1, 4);
+
+            REQUIRE_EQ(sliced.size(), 3);
+            CHECK_EQ(sliced.offset(), 1);
+            CHECK(std::ranges::equal(sliced[0].get(), input_values[1]));
+            CHECK_FALSE(sliced[1].has_value());
+
+            // The slice shares the buffers and the schema, extension metadata included
+            const auto& proxy = sliced.get_arrow_proxy();
+            CHECK_EQ(proxy.array().buffers[1], ar.get_arrow_proxy().array().buffers[1]);
+            CHECK_EQ(proxy.schema().metadata, ar.get_arrow_proxy().schema().metadata);
+        }
+
         TEST_CASE("iterators")
         {
             SUBCASE("forward iteration")
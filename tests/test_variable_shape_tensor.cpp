@@ -12,13 +12,18 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
+#include <numeric>
+#include <optional>
 #include <type_traits>
 #include <vector>
 
 #include <doctest/doctest.h>
 
 #include "sparrow/array.hpp"
+#include "sparrow/layout/array_access.hpp"
 #include "sparrow/list_array.hpp"
 #include "sparrow/primitive_array.hpp"
 #include "sparrow/record_batch.hpp"
@@ -751,6 +756,332 @@ namespace sparrow_extensions
             }
         }
 
+        TEST_CASE("variable_shape_tensor_array::tensor_view")
+        {
+            // Two 2D tensors with shapes [2, 3] and [1, 4]
+            sparrow::primitive_array<float> flat_data({0.f, 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f});
+            std::vector<std::size_t> offsets = {0, 6, 10};
+            sparrow::list_array tensor_data(sparrow::array(std::move(flat_data)), std::move(offsets));
+
+            sparrow::primitive_array<std::int32_t> flat_shapes({2, 3, 1, 4});
+            sparrow::fixed_sized_list_array tensor_shapes(2, sparrow::array(std::move(flat_shapes)));
+
+            variable_shape_tensor_array tensor_array(
+                2,
+                sparrow::array(std::move(tensor_data)),
+                sparrow::array(std::move(tensor_shapes)),
+                metadata{std::nullopt, std::nullopt, std::nullopt}
+            );
+
+            const auto check_views = [](const variable_shape_tensor_array& arr)
+            {
+                const auto first = arr.tensor_view<float>(0);
+                REQUIRE_EQ(first.rank(), 2);
+                CHECK_EQ(first.extent(0), 2);
+                CHECK_EQ(first.extent(1), 3);
+                CHECK_EQ(first.size(), 6);
+                CHECK_EQ(first.stride(0), 3);
+                CHECK_EQ(first(0, 0), 0.f);
+                CHECK_EQ(first(1, 2), 5.f);
+
+                const auto second = arr.tensor_view<float>(1);
+                REQUIRE_EQ(second.rank(), 2);
+                CHECK_EQ(second.extent(0), 1);
+                CHECK_EQ(second.extent(1), 4);
+                CHECK_EQ(second(0, 0), 6.f);
+                CHECK_EQ(second(0, 3), 9.f);
+
+                const std::vector<std::int64_t> indices = {0, 2};
+                CHECK_EQ(second[indices], 8.f);
+                CHECK_EQ(second.flat().size(), 4);
+
+                CHECK(std::ranges::equal(arr.tensor_shape(0), std::vector<std::int32_t>{2, 3}));
+                CHECK(std::ranges::equal(arr.tensor_shape(1), std::vector<std::int32_t>{1, 4}));
+            };
+
+            SUBCASE("without index")
+            {
+                CHECK_FALSE(tensor_array.has_index());
+                check_views(tensor_array);
+            }
+
+            SUBCASE("with index")
+            {
+                const auto& tensor_index = tensor_array.build_index();
+                REQUIRE(tensor_array.has_index());
+                CHECK_EQ(tensor_index.ndim, 2);
+                CHECK_EQ(tensor_index.element_offsets, std::vector<std::int64_t>{0, 6});
+                CHECK_EQ(tensor_index.element_counts, std::vector<std::int64_t>{6, 4});
+                CHECK_EQ(tensor_index.shapes, std::vector<std::int32_t>{2, 3, 1, 4});
+                CHECK_EQ(&tensor_array.build_index(), &tensor_index);
+                check_views(tensor_array);
+            }
+
+            SUBCASE("index is shared by copies and dropped on mutable access")
+            {
+                tensor_array.build_index();
+                const variable_shape_tensor_array copy(tensor_array);
+                CHECK(copy.has_index());
+                check_views(copy);
+
+                [[maybe_unused]] auto& storage = tensor_array.storage();
+                CHECK_FALSE(tensor_array.has_index());
+                CHECK(copy.has_index());
+            }
+        }
+
+        TEST_CASE("variable_shape_tensor_array::slice")
+        {
+            // Three 2D tensors with shapes [2, 3], [1, 4] and [1, 1], the first one null
+            sparrow::primitive_array<float> flat_data(
+                {0.f, 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f, 10.f}
+            );
+            std::vector<std::size_t> offsets = {0, 6, 10, 11};
+            sparrow::list_array tensor_data(sparrow::array(std::move(flat_data)), std::move(offsets));
+
+            sparrow::primitive_array<std::int32_t> flat_shapes({2, 3, 1, 4, 1, 1});
+            sparrow::fixed_sized_list_array tensor_shapes(2, sparrow::array(std::move(flat_shapes)));
+
+            const variable_shape_tensor_array tensor_array(
+                2,
+                sparrow::array(std::move(tensor_data)),
+                sparrow::array(std::move(tensor_shapes)),
+                metadata{std::vector<std::string>{"H", "W"}, std::nullopt, std::nullopt},
+                std::vector<bool>{false, true, true}
+            );
+
+            const auto check_slice = [&](const variable_shape_tensor_array& sliced)
+            {
+                REQUIRE_EQ(sliced.size(), 2);
+                CHECK_EQ(&sliced.get_metadata(), &tensor_array.get_metadata());
+                CHECK_FALSE(sliced.has_index());
+                CHECK(sliced[0].has_value());
+                CHECK(std::ranges::equal(sliced.tensor_shape(0), std::vector<std::int32_t>{1, 4}));
+                CHECK_EQ(sliced.tensor_view<float>(0)(0, 3), 9.f);
+                CHECK(std::ranges::equal(sliced.tensor_shape(1), std::vector<std::int32_t>{1, 1}));
+                CHECK_EQ(sliced.tensor_view<float>(1)(0, 0), 10.f);
+                CHECK_FALSE(sliced.validate().has_value());
+            };
+
+            SUBCASE("slice_view shares the buffers")
+            {
+                const auto sliced = tensor_array.slice_view(1, 3);
+                check_slice(sliced);
+                CHECK_EQ(sliced.values<float>().data(), tensor_array.values<float>().data());
+                CHECK_EQ(sliced.layout()->element_offsets, std::vector<std::int64_t>{6, 10});
+            }
+
+            SUBCASE("slice")
+            {
+                check_slice(tensor_array.slice(1, 3));
+            }
+
+            SUBCASE("slice of a slice")
+            {
+                const auto outer = tensor_array.slice_view(0, 3);
+                const auto sliced = outer.slice_view(2, 3);
+                REQUIRE_EQ(sliced.size(), 1);
+                CHECK_EQ(sliced.tensor_view<float>(0)(0, 0), 10.f);
+            }
+        }
+
+        TEST_CASE("variable_shape_tensor_array::uniform_shape")
+        {
+            // Three 2D tensors with shapes [1, 3], [2, 3] and [3, 3]
+            const auto make_tensor_array = [](const metadata& meta)
+            {
+                std::vector<float> values(18);
+                std::iota(values.begin(), values.end(), 0.f);
+                std::vector<std::size_t> offsets = {0, 3, 9, 18};
+                sparrow::list_array tensor_data(
+                    sparrow::array(sparrow::primitive_array<float>(values)),
+                    std::move(offsets)
+                );
+                sparrow::primitive_array<std::int32_t> flat_shapes({1, 3, 2, 3, 3, 3});
+                sparrow::fixed_sized_list_array tensor_shapes(2, sparrow::array(std::move(flat_shapes)));
+                return variable_shape_tensor_array(
+                    2,
+                    sparrow::array(std::move(tensor_data)),
+                    sparrow::array(std::move(tensor_shapes)),
+                    meta
+                );
+            };
+
+            SUBCASE("partially uniform")
+            {
+                const std::vector<std::optional<std::int32_t>> uniform_shape = {std::nullopt, 3};
+                auto tensor_array = make_tensor_array(metadata{std::nullopt, std::nullopt, uniform_shape});
+                CHECK(tensor_array.conforms_to_uniform_shape());
+
+                const auto& tensor_index = tensor_array.build_index();
+                CHECK_FALSE(tensor_index.uniform);
+                CHECK_EQ(tensor_index.shapes, std::vector<std::int32_t>{1, 3, 2, 3, 3, 3});
+                CHECK_EQ(tensor_index.varying_axes, std::vector<std::size_t>{0});
+                CHECK_EQ(tensor_index.constant_strides, std::vector<std::int64_t>{3, 1});
+                const auto view = tensor_array.tensor_view<float>(2);
+                CHECK_EQ(view.stride(0), 3);
+                CHECK_EQ(view(2, 2), 17.f);
+                const std::array<std::int64_t, 2> index = {1, 2};
+                CHECK_EQ(view[index], 14.f);
+            }
+
+            SUBCASE("without uniform_shape")
+            {
+                auto tensor_array = make_tensor_array(metadata{});
+                CHECK(tensor_array.conforms_to_uniform_shape());
+                const auto& tensor_index = tensor_array.build_index();
+                CHECK_EQ(tensor_index.varying_axes, std::vector<std::size_t>{0, 1});
+                CHECK_EQ(tensor_index.constant_strides, std::vector<std::int64_t>{0, 1});
+            }
+
+            SUBCASE("non-conforming shapes")
+            {
+                const auto source = make_tensor_array(metadata{});
+                sparrow::arrow_proxy proxy = source.get_arrow_proxy();
+                proxy.set_metadata(std::make_optional(std::vector<sparrow::metadata_pair>{
+                    {"ARROW:extension:name", "arrow.variable_shape_tensor"},
+                    {"ARROW:extension:metadata", R"({"uniform_shape":[2,null]})"}
+                }));
+                const variable_shape_tensor_array tensor_array(std::move(proxy));
+                CHECK_FALSE(tensor_array.conforms_to_uniform_shape());
+            }
+        }
+
+        TEST_CASE("variable_shape_tensor_array::uniform_shape fully specified")
+        {
+            // Three 2D tensors with shape [2, 2]
+            std::vector<float> values(12);
+            std::iota(values.begin(), values.end(), 0.f);
+            std::vector<std::size_t> offsets = {0, 4, 8, 12};
+            sparrow::list_array tensor_data(
+                sparrow::array(sparrow::primitive_array<float>(values)),
+                std::move(offsets)
+            );
+            sparrow::primitive_array<std::int32_t> flat_shapes({2, 2, 2, 2, 2, 2});
+            sparrow::fixed_sized_list_array tensor_shapes(2, sparrow::array(std::move(flat_shapes)));
+
+            variable_shape_tensor_array tensor_array(
+                2,
+                sparrow::array(std::move(tensor_data)),
+                sparrow::array(std::move(tensor_shapes)),
+                metadata{std::nullopt, std::nullopt, std::vector<std::optional<std::int32_t>>{2, 2}}
+            );
+            CHECK(tensor_array.conforms_to_uniform_shape());
+
+            const auto& tensor_index = tensor_array.build_index();
+            CHECK(tensor_index.uniform);
+            CHECK_EQ(tensor_index.shapes, std::vector<std::int32_t>{2, 2});
+            CHECK_EQ(tensor_index.element_counts, std::vector<std::int64_t>{4, 4, 4});
+            CHECK(tensor_index.varying_axes.empty());
+            CHECK_EQ(tensor_index.constant_strides, std::vector<std::int64_t>{2, 1});
+            CHECK(std::ranges::equal(tensor_array.tensor_shape(2), std::vector<std::int32_t>{2, 2}));
+            CHECK_EQ(tensor_array.tensor_view<float>(2)(1, 0), 10.f);
+        }
+
+        TEST_CASE("variable_shape_tensor_array::validate")
+        {
+            // Wraps the children without the checks of the data and shapes constructors
+            const auto make_unchecked_array =
+                [](std::vector<std::size_t> offsets, std::vector<std::int32_t> shapes)
+            {
+                std::vector<float> values(offsets.back());
+                std::iota(values.begin(), values.end(), 0.f);
+                sparrow::list_array tensor_data(
+                    sparrow::array(sparrow::primitive_array<float>(values)),
+                    std::move(offsets)
+                );
+                sparrow::fixed_sized_list_array tensor_shapes(
+                    2,
+                    sparrow::array(sparrow::primitive_array<std::int32_t>(shapes))
+                );
+                auto storage = detail::make_tensor_struct(
+                    sparrow::array(std::move(tensor_data)),
+                    sparrow::array(std::move(tensor_shapes))
+                );
+                sparrow::arrow_proxy proxy = sparrow::detail::array_access::get_arrow_proxy(storage);
+                return variable_shape_tensor_array(std::move(proxy));
+            };
+
+            SUBCASE("valid")
+            {
+                const auto tensor_array = make_unchecked_array({0, 6, 8}, {2, 3, 1, 2});
+                CHECK_FALSE(tensor_array.validate().has_value());
+            }
+
+            SUBCASE("element count mismatch")
+            {
+                const auto tensor_array = make_unchecked_array({0, 6, 8, 10}, {2, 3, 1, 2, 2, 2});
+                const auto error = tensor_array.validate();
+                REQUIRE(error.has_value());
+                CHECK_EQ(error->row, 2);
+                CHECK_EQ(error->reason, "the number of elements does not match the shape");
+            }
+
+            SUBCASE("non positive extent")
+            {
+                const auto tensor_array = make_unchecked_array({0, 6, 6}, {2, 3, 0, 4});
+                const auto error = tensor_array.validate();
+                REQUIRE(error.has_value());
+                CHECK_EQ(error->row, 1);
+                CHECK_EQ(error->reason, "the shape extents must be positive");
+            }
+
+            SUBCASE("uniform_shape mismatch")
+            {
+                const auto tensor_array = make_unchecked_array({0, 6, 8}, {2, 3, 1, 2});
+                sparrow::arrow_proxy proxy = tensor_array.get_arrow_proxy();
+                proxy.set_metadata(std::make_optional(std::vector<sparrow::metadata_pair>{
+                    {"ARROW:extension:name", "arrow.variable_shape_tensor"},
+                    {"ARROW:extension:metadata", R"({"uniform_shape":[null,3]})"}
+                }));
+                const auto error = variable_shape_tensor_array(std::move(proxy)).validate();
+                REQUIRE(error.has_value());
+                CHECK_EQ(error->row, 1);
+                CHECK_EQ(error->reason, "the shape does not match uniform_shape");
+            }
+
+            SUBCASE("lowest invalid row across blocks")
+            {
+                // Rows are validated in blocks of 16384: the invalid rows fall in the second and
+                // third blocks, and fail different checks
+                constexpr std::size_t row_count = 3 * 16384 + 5;
+                constexpr std::size_t count_mismatch_row = 16384 + 10;
+                constexpr std::size_t zero_extent_row = 2 * 16384 + 7;
+                std::vector<std::size_t> offsets(row_count + 1);
+                std::iota(offsets.begin(), offsets.end(), std::size_t{0});
+                std::vector<std::int32_t> shapes(2 * row_count, 1);
+                shapes[2 * count_mismatch_row + 1] = 2;
+                shapes[2 * zero_extent_row] = 0;
+
+                const auto tensor_array = make_unchecked_array(std::move(offsets), std::move(shapes));
+                const auto error = tensor_array.validate();
+                REQUIRE(error.has_value());
+                CHECK_EQ(error->row, count_mismatch_row);
+                CHECK_EQ(error->reason, "the number of elements does not match the shape");
+            }
+
+            SUBCASE("null tensors are not checked")
+            {
+                std::vector<float> values(6);
+                sparrow::list_array tensor_data(
+                    sparrow::array(sparrow::primitive_array<float>(values)),
+                    std::vector<std::size_t>{0, 6, 6}
+                );
+                sparrow::fixed_sized_list_array tensor_shapes(
+                    2,
+                    sparrow::array(sparrow::primitive_array<std::int32_t>({2, 3, 0, 0}))
+                );
+                const variable_shape_tensor_array tensor_array(
+                    2,
+                    sparrow::array(std::move(tensor_data)),
+                    sparrow::array(std::move(tensor_shapes)),
+                    metadata{},
+                    std::vector<bool>{true, false}
+                );
+                CHECK_FALSE(tensor_array.validate().has_value());
+            }
+        }
+
         TEST_CASE("variable_shape_tensor_array::field_names")
         {
             CHECK_EQ(variable_shape_tensor_array::data_field_name(), "data");
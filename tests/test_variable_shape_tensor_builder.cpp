@@ -0,0 +1,196 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include "sparrow_extensions/variable_shape_tensor_builder.hpp"
+
+namespace sparrow_extensions
+{
+    using tensor_entry_type = std::pair<std::vector<std::int32_t>, std::vector<float>>;
+
+    namespace
+    {
+        // 2D tensor of shape [rows, 2] holding first, first + 1, ...
+        tensor_entry_type make_entry(std::int32_t rows, float first)
+        {
+            std::vector<float> values(static_cast<std::size_t>(rows * 2));
+            for (std::size_t i = 0; i < values.size(); ++i)
+            {
+                values[i] = first + static_cast<float>(i);
+            }
+            return {{rows, 2}, std::move(values)};
+        }
+    }
+
+    TEST_SUITE("variable_shape_tensor_builder")
+    {
+        TEST_CASE("append")
+        {
+            variable_shape_tensor_builder<float> builder(2);
+            builder.reserve(3, 6);
+
+            const auto first = make_entry(1, 0.f);
+            const auto third = make_entry(2, 10.f);
+            builder.append(first.first, first.second);
+            builder.append_null();
+            builder.append(third.first, third.second);
+            CHECK_EQ(builder.size(), 3);
+            CHECK_EQ(builder.element_count(), 6);
+
+            const auto tensor_array = builder.finish("tensors");
+            CHECK_EQ(builder.size(), 0);
+            REQUIRE_EQ(tensor_array.size(), 3);
+            CHECK_EQ(tensor_array.get_arrow_proxy().name(), "tensors");
+            CHECK_EQ(tensor_array.ndim(), 2);
+
+            CHECK(tensor_array[0].has_value());
+            CHECK_FALSE(tensor_array[1].has_value());
+            CHECK(tensor_array[2].has_value());
+
+            const auto view = tensor_array.tensor_view<float>(2);
+            CHECK_EQ(view.extent(0), 2);
+            CHECK_EQ(view.extent(1), 2);
+            CHECK_EQ(view(1, 1), 13.f);
+            CHECK_EQ(tensor_array.tensor_view<float>(0)(0, 1), 1.f);
+        }
+
+        TEST_CASE("append_range")
+        {
+            SUBCASE("random access range")
+            {
+                std::vector<tensor_entry_type> entries;
+                for (std::int32_t i = 0; i < 10000; ++i)
+                {
+                    entries.push_back(make_entry(1 + i % 3, static_cast<float>(i)));
+                }
+
+                const auto tensor_array = make_variable_shape_tensor_array<float>(2, entries);
+                REQUIRE_EQ(tensor_array.size(), entries.size());
+                for (std::size_t i = 0; i < entries.size(); i += 997)
+                {
+                    const auto view = tensor_array.tensor_view<float>(i);
+                    CHECK_EQ(view.extent(0), entries[i].first[0]);
+                    CHECK(std::ranges::equal(view.flat(), entries[i].second));
+                }
+            }
+
+            SUBCASE("nullable entries")
+            {
+                const std::vector<std::optional<tensor_entry_type>> entries = {
+                    make_entry(2, 0.f),
+                    std::nullopt,
+                    make_entry(1, 4.f)
+                };
+
+                const auto tensor_array = make_variable_shape_tensor_array<float>(2, entries);
+                REQUIRE_EQ(tensor_array.size(), 3);
+                CHECK_FALSE(tensor_array[1].has_value());
+                CHECK_EQ(tensor_array.tensor_view<float>(2)(0, 1), 5.f);
+                CHECK(std::ranges::equal(tensor_array.tensor_shape(1), std::vector<std::int32_t>{1, 1}));
+                CHECK_FALSE(tensor_array.validate().has_value());
+            }
+
+            SUBCASE("appended after single tensors")
+            {
+                variable_shape_tensor_builder<float> builder(2);
+                const auto first = make_entry(1, 0.f);
+                builder.append(first.first, first.second);
+                builder.append_range(std::vector<tensor_entry_type>{make_entry(3, 2.f), make_entry(1, 8.f)});
+
+                const auto tensor_array = builder.finish();
+                REQUIRE_EQ(tensor_array.size(), 3);
+                CHECK_EQ(tensor_array.tensor_view<float>(1)(2, 1), 7.f);
+                CHECK_EQ(tensor_array.tensor_view<float>(2)(0, 0), 8.f);
+            }
+
+            SUBCASE("input range")
+            {
+                const std::list<tensor_entry_type> entries = {make_entry(1, 0.f), make_entry(2, 2.f)};
+
+                const auto tensor_array = make_variable_shape_tensor_array<float>(2, entries);
+                REQUIRE_EQ(tensor_array.size(), 2);
+                CHECK_EQ(tensor_array.tensor_view<float>(1)(1, 0), 4.f);
+            }
+        }
+
+        TEST_CASE("uniform_shape")
+        {
+            const variable_shape_tensor_extension::metadata tensor_metadata{
+                std::nullopt,
+                std::nullopt,
+                std::vector<std::optional<std::int32_t>>{std::nullopt, 2}
+            };
+            const std::vector<std::optional<tensor_entry_type>> entries = {
+                make_entry(1, 0.f),
+                std::nullopt,
+                make_entry(2, 2.f)
+            };
+
+            SUBCASE("append_range")
+            {
+                const auto tensor_array =
+                    make_variable_shape_tensor_array<float>(2, entries, tensor_metadata);
+                CHECK(tensor_array.conforms_to_uniform_shape());
+                CHECK_FALSE(tensor_array.validate().has_value());
+                CHECK_EQ(tensor_array.get_metadata().uniform_shape, tensor_metadata.uniform_shape);
+                CHECK(std::ranges::equal(tensor_array.tensor_shape(1), std::vector<std::int32_t>{1, 2}));
+            }
+
+            SUBCASE("append_null")
+            {
+                variable_shape_tensor_builder<float> builder(2, tensor_metadata);
+                builder.append_null();
+                const auto tensor_array = builder.finish();
+                CHECK_FALSE(tensor_array.validate().has_value());
+                CHECK(std::ranges::equal(tensor_array.tensor_shape(0), std::vector<std::int32_t>{1, 2}));
+            }
+        }
+
+        TEST_CASE("big_variable_shape_tensor_builder")
+        {
+            big_variable_shape_tensor_builder<float> builder(2);
+            const auto first = make_entry(2, 0.f);
+            builder.append(first.first, first.second);
+            builder.append_null();
+            builder.append_range(std::vector<tensor_entry_type>{make_entry(1, 4.f), make_entry(3, 6.f)});
+
+            const auto tensor_array = builder.finish();
+            CHECK_EQ(std::string_view(tensor_array.get_arrow_proxy().schema().children[0]->format), "+L");
+            REQUIRE_EQ(tensor_array.size(), 4);
+            CHECK_FALSE(tensor_array.validate().has_value());
+            CHECK_FALSE(tensor_array[1].has_value());
+            CHECK_EQ(tensor_array.tensor_view<float>(0)(1, 1), 3.f);
+            CHECK_EQ(tensor_array.tensor_view<float>(3)(2, 0), 10.f);
+            CHECK_EQ(tensor_array.tensor_shape(2)[0], 1);
+
+            CHECK_EQ(tensor_array.layout()->element_offsets, std::vector<std::int64_t>{0, 4, 4, 6});
+
+            const auto large = make_variable_shape_tensor_array<float, true>(
+                2,
+                std::vector<tensor_entry_type>{make_entry(1, 0.f)}
+            );
+            CHECK_EQ(std::string_view(large.get_arrow_proxy().schema().children[0]->format), "+L");
+        }
+    }
+}
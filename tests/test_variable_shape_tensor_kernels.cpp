@@ -0,0 +1,467 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include "sparrow_extensions/variable_shape_tensor_builder.hpp"
+#include "sparrow_extensions/variable_shape_tensor_kernels.hpp"
+
+namespace sparrow_extensions
+{
+    namespace
+    {
+        using tensor_entry_type = std::pair<std::vector<std::int32_t>, std::vector<float>>;
+        using metadata = variable_shape_tensor_extension::metadata;
+
+        // 2D tensor holding first, first + 1, ... in row-major order
+        tensor_entry_type make_entry(std::int32_t rows, std::int32_t cols, float first)
+        {
+            std::vector<float> values(static_cast<std::size_t>(rows * cols));
+            for (std::size_t i = 0; i < values.size(); ++i)
+            {
+                values[i] = first + static_cast<float>(i);
+            }
+            return {{rows, cols}, std::move(values)};
+        }
+
+        // Shapes [2, 3], [1, 2], null, [2, 3], [3, 1]
+        variable_shape_tensor_array make_tensor_array(const metadata& tensor_metadata = {})
+        {
+            const std::vector<std::optional<tensor_entry_type>> entries = {
+                make_entry(2, 3, 0.f),
+                make_entry(1, 2, 10.f),
+                std::nullopt,
+                make_entry(2, 3, 20.f),
+                make_entry(3, 1, 30.f)
+            };
+            return make_variable_shape_tensor_array<float>(2, entries, tensor_metadata);
+        }
+
+        std::vector<float> flat_values(const fixed_shape_tensor_array& tensors)
+        {
+            const auto& values = tensors.storage().raw_flat_array()->get_arrow_proxy();
+            const auto* data = static_cast<const float*>(values.array().buffers[1]) + values.offset();
+            return {data, data + values.length()};
+        }
+    }
+
+    TEST_SUITE("variable_shape_tensor_kernels")
+    {
+        TEST_CASE("bucket_by_shape")
+        {
+            SUBCASE("exact shapes")
+            {
+                const auto tensor_array = make_tensor_array(metadata{std::vector<std::string>{"H", "W"}});
+                const auto result = bucket_by_shape(tensor_array);
+
+                CHECK_EQ(result.unbucketed_rows, std::vector<std::size_t>{2});
+                REQUIRE_EQ(result.buckets.size(), 3);
+
+                const auto& first = result.buckets[0];
+                CHECK_EQ(first.shape, std::vector<std::int64_t>{2, 3});
+                CHECK_EQ(first.row_indices, std::vector<std::size_t>{0, 3});
+                CHECK_EQ(first.tensors.size(), 2);
+                CHECK_EQ(first.tensors.shape(), first.shape);
+                CHECK_EQ(first.tensors.get_metadata().dim_names, std::vector<std::string>{"H", "W"});
+                CHECK_EQ(
+                    flat_values(first.tensors),
+                    std::vector<float>{0.f, 1.f, 2.f, 3.f, 4.f, 5.f, 20.f, 21.f, 22.f, 23.f, 24.f, 25.f}
+                );
+
+                CHECK_EQ(result.buckets[1].shape, std::vector<std::int64_t>{1, 2});
+                CHECK_EQ(result.buckets[1].row_indices, std::vector<std::size_t>{1});
+                CHECK_EQ(result.buckets[2].shape, std::vector<std::int64_t>{3, 1});
+                CHECK_EQ(result.buckets[2].row_indices, std::vector<std::size_t>{4});
+            }
+
+            SUBCASE("padded buckets")
+            {
+                const auto tensor_array = make_tensor_array();
+                shape_bucketing_options options;
+                options.granularity = {2, 4};
+                options.pad_value = -1;
+                const auto result = bucket_by_shape(tensor_array, options);
+
+                // [2, 3] and [1, 2] share the [2, 4] bucket, [3, 1] goes to [4, 4]
+                REQUIRE_EQ(result.buckets.size(), 2);
+                const auto& first = result.buckets[0];
+                CHECK_EQ(first.shape, std::vector<std::int64_t>{2, 4});
+                CHECK_EQ(first.row_indices, std::vector<std::size_t>{0, 1, 3});
+                const auto values = flat_values(first.tensors);
+                REQUIRE_EQ(values.size(), 24);
+                const std::vector<float> expected = {
+                    0.f, 1.f, 2.f, -1.f, 3.f, 4.f, 5.f, -1.f,       // [2, 3] padded to [2, 4]
+                    10.f, 11.f, -1.f, -1.f, -1.f, -1.f, -1.f, -1.f  // [1, 2] padded to [2, 4]
+                };
+                CHECK_EQ(std::vector<float>(values.begin(), values.begin() + 16), expected);
+
+                CHECK_EQ(result.buckets[1].shape, std::vector<std::int64_t>{4, 4});
+                CHECK_EQ(result.buckets[1].row_indices, std::vector<std::size_t>{4});
+            }
+
+            SUBCASE("empty array")
+            {
+                const auto tensor_array = make_variable_shape_tensor_array<float>(
+                    2,
+                    std::vector<tensor_entry_type>{}
+                );
+                const auto result = bucket_by_shape(tensor_array);
+                CHECK(result.buckets.empty());
+                CHECK(result.unbucketed_rows.empty());
+            }
+
+            SUBCASE("scalars")
+            {
+                // Tensors without dimension have no fixed shape counterpart
+                const std::vector<std::optional<tensor_entry_type>> entries = {
+                    tensor_entry_type{{}, {1.f}},
+                    std::nullopt,
+                    tensor_entry_type{{}, {2.f}}
+                };
+                const auto tensor_array = make_variable_shape_tensor_array<float>(0, entries);
+                const auto result = bucket_by_shape(tensor_array);
+                CHECK(result.buckets.empty());
+                CHECK_EQ(result.unbucketed_rows, std::vector<std::size_t>{0, 1, 2});
+            }
+        }
+
+        TEST_CASE("pad_to_dense")
+        {
+            SUBCASE("pad to the largest extents")
+            {
+                const auto tensor_array = make_tensor_array();
+                padding_options options;
+                options.pad_value = -1;
+                const auto result = pad_to_dense(tensor_array, options);
+
+                CHECK_EQ(result.tensors.shape(), std::vector<std::int64_t>{3, 3});
+                REQUIRE_EQ(result.tensors.size(), 5);
+                CHECK(result.tensors[0].has_value());
+                CHECK_FALSE(result.tensors[2].has_value());
+
+                const auto values = flat_values(result.tensors);
+                REQUIRE_EQ(values.size(), 45);
+                const std::vector<float> first = {0.f, 1.f, 2.f, 3.f, 4.f, 5.f, -1.f, -1.f, -1.f};
+                CHECK_EQ(std::vector<float>(values.begin(), values.begin() + 9), first);
+                const std::vector<float> last = {30.f, -1.f, -1.f, 31.f, -1.f, -1.f, 32.f, -1.f, -1.f};
+                CHECK_EQ(std::vector<float>(values.begin() + 36, values.end()), last);
+
+                REQUIRE_EQ(result.mask.size(), 45);
+                CHECK_EQ(static_cast<bool>(result.mask[0].value()), true);
+                CHECK_EQ(static_cast<bool>(result.mask[6].value()), false);
+                CHECK_EQ(static_cast<bool>(result.mask[18].value()), false);  // null tensor
+                CHECK_EQ(static_cast<bool>(result.mask[39].value()), true);
+                CHECK_EQ(static_cast<bool>(result.mask[40].value()), false);
+            }
+
+            SUBCASE("truncate to given extents")
+            {
+                const auto tensor_array = make_tensor_array();
+                padding_options options;
+                options.shape = {2, 2};
+                options.truncate = true;
+                const auto result = pad_to_dense(tensor_array, options);
+
+                CHECK_EQ(result.tensors.shape(), std::vector<std::int64_t>{2, 2});
+                const auto values = flat_values(result.tensors);
+                const std::vector<float> first = {0.f, 1.f, 3.f, 4.f};
+                CHECK_EQ(std::vector<float>(values.begin(), values.begin() + 4), first);
+                const std::vector<float> last = {30.f, 0.f, 31.f, 0.f};
+                CHECK_EQ(std::vector<float>(values.begin() + 16, values.end()), last);
+            }
+
+            SUBCASE("larger tensors are rejected without truncation")
+            {
+                const auto tensor_array = make_tensor_array();
+                padding_options options;
+                options.shape = {2, 2};
+                CHECK_THROWS_AS(pad_to_dense(tensor_array, options), std::runtime_error);
+            }
+        }
+
+        TEST_CASE("reduce_tensors")
+        {
+            const auto tensor_array = make_tensor_array(metadata{std::vector<std::string>{"H", "W"}});
+
+            SUBCASE("whole tensors")
+            {
+                const auto sums = reduce_tensors(tensor_array, tensor_reduction::sum);
+                REQUIRE_EQ(sums.size(), 5);
+                CHECK_EQ(sums[0].value(), 15.);
+                CHECK_EQ(sums[1].value(), 21.);
+                CHECK_FALSE(sums[2].has_value());
+                CHECK_EQ(sums[3].value(), 135.);
+                CHECK_EQ(sums[4].value(), 93.);
+
+                const auto counts = reduce_tensors(tensor_array, tensor_reduction::count);
+                CHECK_EQ(counts[0].value(), 6.);
+                CHECK_EQ(counts[4].value(), 3.);
+
+                const auto maxima = reduce_tensors(tensor_array, tensor_reduction::max);
+                CHECK_EQ(maxima[1].value(), 11.);
+                const auto minima = reduce_tensors(tensor_array, tensor_reduction::min);
+                CHECK_EQ(minima[3].value(), 20.);
+                const auto means = reduce_tensors(tensor_array, tensor_reduction::mean);
+                CHECK_EQ(means[1].value(), doctest::Approx(10.5));
+                const auto norms = reduce_tensors(tensor_array, tensor_reduction::norm);
+                CHECK_EQ(norms[1].value(), doctest::Approx(std::sqrt(10. * 10. + 11. * 11.)));
+            }
+
+            SUBCASE("along a named axis")
+            {
+                const auto result = reduce_tensors(tensor_array, tensor_reduction::sum, "H");
+                REQUIRE_EQ(result.size(), 5);
+                const auto& dim_names = result.get_metadata().dim_names;
+                REQUIRE(dim_names.has_value());
+                CHECK_EQ(*dim_names, std::vector<std::string>{"W"});
+                CHECK_FALSE(result[2].has_value());
+
+                const auto first = result.tensor_view<double>(0);
+                REQUIRE_EQ(first.rank(), 1);
+                CHECK(std::ranges::equal(first.flat(), std::vector<double>{3., 5., 7.}));
+                const auto fourth = result.tensor_view<double>(3);
+                CHECK(std::ranges::equal(fourth.flat(), std::vector<double>{43., 45., 47.}));
+                const auto fifth = result.tensor_view<double>(4);
+                CHECK(std::ranges::equal(fifth.flat(), std::vector<double>{93.}));
+            }
+
+            SUBCASE("along an axis index")
+            {
+                const auto result = reduce_tensors(tensor_array, tensor_reduction::mean, std::size_t{1});
+                const auto first = result.tensor_view<double>(0);
+                CHECK(std::ranges::equal(first.flat(), std::vector<double>{1., 4.}));
+                const auto fifth = result.tensor_view<double>(4);
+                CHECK(std::ranges::equal(fifth.flat(), std::vector<double>{30., 31., 32.}));
+            }
+
+            SUBCASE("unknown axis name")
+            {
+                CHECK_THROWS_AS(reduce_tensors(tensor_array, tensor_reduction::sum, "C"), std::runtime_error);
+            }
+        }
+
+        TEST_CASE("to_variable_shape_tensor")
+        {
+            std::vector<float> values(18);
+            std::iota(values.begin(), values.end(), 0.f);
+            const fixed_shape_tensor_extension::metadata fixed_metadata{
+                {2, 3},
+                std::vector<std::string>{"H", "W"},
+                std::nullopt
+            };
+            const auto make_fixed_tensors = [&]()
+            {
+                return fixed_shape_tensor_array(
+                    6,
+                    sparrow::array(sparrow::primitive_array<float>(values)),
+                    fixed_metadata,
+                    std::vector<bool>{true, false, true}
+                );
+            };
+            const auto check_result = [](const variable_shape_tensor_array& result)
+            {
+                REQUIRE_EQ(result.size(), 3);
+                CHECK_FALSE(result.validate().has_value());
+                CHECK_EQ(result.get_metadata().dim_names, std::vector<std::string>{"H", "W"});
+                CHECK_EQ(result.get_metadata().uniform_shape, std::vector<std::optional<std::int32_t>>{2, 3});
+                CHECK_FALSE(result[1].has_value());
+                CHECK(std::ranges::equal(result.tensor_shape(2), std::vector<std::int32_t>{2, 3}));
+                CHECK_EQ(result.tensor_view<float>(0)(0, 0), 0.f);
+                CHECK_EQ(result.tensor_view<float>(2)(1, 2), 17.f);
+            };
+
+            SUBCASE("copy")
+            {
+                const auto fixed_tensors = make_fixed_tensors();
+                check_result(to_variable_shape_tensor(fixed_tensors));
+                CHECK_EQ(fixed_tensors.size(), 3);
+            }
+
+            SUBCASE("move reuses the values")
+            {
+                auto fixed_tensors = make_fixed_tensors();
+                const void* data = fixed_tensors.get_arrow_proxy().array().children[0]->buffers[1];
+                const auto result = to_variable_shape_tensor(std::move(fixed_tensors));
+                check_result(result);
+                CHECK_EQ(static_cast<const void*>(result.values<float>().data()), data);
+            }
+
+            SUBCASE("slice")
+            {
+                const auto fixed_tensors = make_fixed_tensors();
+                const auto result = to_variable_shape_tensor(fixed_tensors.slice_view(1, 3));
+                REQUIRE_EQ(result.size(), 2);
+                CHECK_FALSE(result[0].has_value());
+                CHECK_EQ(result.tensor_view<float>(1)(0, 0), 12.f);
+            }
+        }
+
+        TEST_CASE("to_fixed_shape_tensor")
+        {
+            SUBCASE("copy")
+            {
+                const std::vector<std::optional<tensor_entry_type>> entries = {
+                    make_entry(2, 3, 0.f),
+                    std::nullopt,
+                    make_entry(2, 3, 20.f)
+                };
+                const auto tensor_array = make_variable_shape_tensor_array<float>(
+                    2,
+                    entries,
+                    metadata{std::vector<std::string>{"H", "W"}}
+                );
+                const auto result = to_fixed_shape_tensor(tensor_array);
+
+                REQUIRE_EQ(result.size(), 3);
+                CHECK_EQ(result.shape(), std::vector<std::int64_t>{2, 3});
+                CHECK_EQ(result.get_metadata().dim_names, std::vector<std::string>{"H", "W"});
+                CHECK(result[0].has_value());
+                CHECK_FALSE(result[1].has_value());
+                CHECK_EQ(
+                    flat_values(result),
+                    std::vector<float>{
+                        0.f, 1.f, 2.f, 3.f, 4.f, 5.f,        // first tensor
+                        0.f, 0.f, 0.f, 0.f, 0.f, 0.f,        // null tensor
+                        20.f, 21.f, 22.f, 23.f, 24.f, 25.f  // third tensor
+                    }
+                );
+            }
+
+            SUBCASE("move of contiguous tensors reuses the values")
+            {
+                const std::vector<tensor_entry_type> entries = {make_entry(2, 3, 0.f), make_entry(2, 3, 6.f)};
+                auto tensor_array = make_variable_shape_tensor_array<float>(2, entries);
+                const void* data = tensor_array.values<float>().data();
+                const auto result = to_fixed_shape_tensor(std::move(tensor_array));
+
+                REQUIRE_EQ(result.size(), 2);
+                CHECK_EQ(result.storage().raw_flat_array()->get_arrow_proxy().array().buffers[1], data);
+                std::vector<float> expected(12);
+                std::iota(expected.begin(), expected.end(), 0.f);
+                CHECK_EQ(flat_values(result), expected);
+            }
+
+            SUBCASE("round trip")
+            {
+                const std::vector<tensor_entry_type> entries = {make_entry(1, 2, 0.f), make_entry(1, 2, 2.f)};
+                const auto tensor_array = make_variable_shape_tensor_array<float>(2, entries);
+                const auto result = to_variable_shape_tensor(to_fixed_shape_tensor(tensor_array));
+                REQUIRE_EQ(result.size(), 2);
+                CHECK_EQ(result.tensor_view<float>(1)(0, 1), 3.f);
+            }
+
+            SUBCASE("different shapes")
+            {
+                CHECK_THROWS_AS(to_fixed_shape_tensor(make_tensor_array()), std::runtime_error);
+            }
+        }
+
+        TEST_CASE("reorder_tensors")
+        {
+            const std::vector<std::size_t> indices = {4, 2, 0, 0};
+
+            SUBCASE("move reuses the values")
+            {
+                auto tensor_array = make_tensor_array(metadata{std::vector<std::string>{"H", "W"}});
+                const void* data = tensor_array.values<float>().data();
+                const auto result = reorder_tensors(std::move(tensor_array), indices);
+
+                const auto& schema = result.get_arrow_proxy().schema();
+                CHECK_EQ(std::string_view(schema.children[0]->format), "+vl");
+                CHECK_FALSE(result.validate().has_value());
+                CHECK_EQ(result.values<float>().data(), data);
+                CHECK_EQ(result.get_metadata().dim_names, std::vector<std::string>{"H", "W"});
+                REQUIRE_EQ(result.size(), 4);
+                CHECK_FALSE(result[1].has_value());
+                CHECK_EQ(result.tensor_shape(0)[0], 3);
+                CHECK_EQ(result.tensor_view<float>(0)(2, 0), 32.f);
+                CHECK_EQ(result.tensor_view<float>(2)(1, 2), 5.f);
+                CHECK_EQ(result.tensor_view<float>(3)(0, 1), 1.f);
+            }
+
+            SUBCASE("copy")
+            {
+                const auto tensor_array = make_tensor_array();
+                const auto result = reorder_tensors(tensor_array, std::vector<std::size_t>{3, 1});
+                REQUIRE_EQ(result.size(), 2);
+                CHECK_EQ(result.tensor_view<float>(0)(0, 0), 20.f);
+                CHECK_EQ(result.tensor_view<float>(1)(0, 1), 11.f);
+                CHECK_EQ(tensor_array.tensor_view<float>(3)(0, 0), 20.f);
+            }
+
+            SUBCASE("of a reordered array")
+            {
+                const auto reordered = reorder_tensors(make_tensor_array(), indices);
+                const std::vector<std::size_t> sliced_indices = {2, 0};
+                const auto result = reorder_tensors(reordered.slice_view(1, 4), sliced_indices);
+                REQUIRE_EQ(result.size(), 2);
+                CHECK_FALSE(result.validate().has_value());
+                CHECK_EQ(result.tensor_view<float>(0)(1, 1), 4.f);
+                CHECK_FALSE(result[1].has_value());
+            }
+        }
+
+        TEST_CASE("take_tensors")
+        {
+            const auto tensor_array = make_tensor_array(metadata{std::vector<std::string>{"H", "W"}});
+            const auto result = take_tensors(tensor_array, std::vector<std::size_t>{4, 2, 0, 4});
+
+            const auto& schema = result.get_arrow_proxy().schema();
+            CHECK_EQ(std::string_view(schema.children[0]->format), "+l");
+            CHECK_FALSE(result.validate().has_value());
+            CHECK_EQ(result.get_metadata().dim_names, std::vector<std::string>{"H", "W"});
+            REQUIRE_EQ(result.size(), 4);
+            CHECK_EQ(result.values<float>().size(), 12);
+            CHECK_EQ(result.tensor_view<float>(0)(2, 0), 32.f);
+            CHECK_FALSE(result[1].has_value());
+            CHECK_EQ(result.tensor_view<float>(2)(1, 2), 5.f);
+            CHECK_EQ(result.tensor_view<float>(3)(0, 0), 30.f);
+
+            CHECK_EQ(take_tensors(tensor_array, std::vector<std::size_t>{}).size(), 0);
+        }
+
+        TEST_CASE("filter_tensors")
+        {
+            const auto tensor_array = make_tensor_array();
+            const bool8_array mask(std::vector<bool>{true, false, true, true, false});
+            const auto result = filter_tensors(tensor_array, mask);
+
+            CHECK_FALSE(result.validate().has_value());
+            REQUIRE_EQ(result.size(), 3);
+            CHECK_EQ(result.tensor_view<float>(0)(1, 2), 5.f);
+            CHECK_FALSE(result[1].has_value());
+            CHECK_EQ(result.tensor_view<float>(2)(0, 0), 20.f);
+        }
+
+        TEST_CASE("argsort_by_element_count")
+        {
+            // Element counts 6, 2, null, 6, 3
+            const auto tensor_array = make_tensor_array();
+            CHECK_EQ(argsort_by_element_count(tensor_array), std::vector<std::size_t>{2, 1, 4, 0, 3});
+            CHECK_EQ(argsort_by_element_count(tensor_array, true), std::vector<std::size_t>{0, 3, 4, 1, 2});
+        }
+    }
+}